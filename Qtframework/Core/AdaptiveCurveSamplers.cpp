@@ -0,0 +1,181 @@
+#include "AdaptiveCurveSamplers.h"
+
+#include <algorithm>
+
+using namespace cagd;
+using namespace std;
+
+// special/default constructor
+AdaptiveCurveSampler::AdaptiveCurveSampler(GLdouble tolerance, GLuint initial_segment_count, GLuint maximum_depth):
+        _tolerance(tolerance > 0.0 ? tolerance : 1.0e-3),
+        _initial_segment_count(initial_segment_count ? initial_segment_count : DEFAULT_INITIAL_SEGMENT_COUNT),
+        _maximum_depth(maximum_depth)
+{
+}
+
+// set/get properties
+GLboolean AdaptiveCurveSampler::SetTolerance(GLdouble tolerance)
+{
+    if (tolerance <= 0.0)
+        return GL_FALSE;
+
+    _tolerance = tolerance;
+
+    return GL_TRUE;
+}
+
+GLboolean AdaptiveCurveSampler::SetInitialSegmentCount(GLuint initial_segment_count)
+{
+    if (!initial_segment_count)
+        return GL_FALSE;
+
+    _initial_segment_count = initial_segment_count;
+
+    return GL_TRUE;
+}
+
+GLvoid AdaptiveCurveSampler::SetMaximumDepth(GLuint maximum_depth)
+{
+    _maximum_depth = maximum_depth;
+}
+
+GLdouble AdaptiveCurveSampler::GetTolerance() const
+{
+    return _tolerance;
+}
+
+GLuint AdaptiveCurveSampler::GetInitialSegmentCount() const
+{
+    return _initial_segment_count;
+}
+
+GLuint AdaptiveCurveSampler::GetMaximumDepth() const
+{
+    return _maximum_depth;
+}
+
+// |c' x c''| / |c'|, i.e., the length of the component of the acceleration that is orthogonal to the tangent
+GLdouble AdaptiveCurveSampler::_NormalAcceleration(const DCoordinate3 *d, GLuint evaluated_order) const
+{
+    if (evaluated_order < 2)
+        return 0.0;
+
+    GLdouble speed = d[1].length();
+
+    if (speed == 0.0)
+        return d[2].length();
+
+    return (d[1] ^ d[2]).length() / speed;
+}
+
+// appends the inner samples of the segment [a, b] in increasing order
+GLboolean AdaptiveCurveSampler::_Refine(
+        const Evaluator& evaluator, GLuint evaluated_order,
+        GLdouble a, GLuint a_offset, GLdouble b, GLuint b_offset, GLuint depth,
+        vector<DCoordinate3>& derivatives, vector<Sample>& samples) const
+{
+    if (depth >= _maximum_depth)
+        return GL_TRUE;
+
+    GLdouble u          = 0.5 * (a + b);
+    GLuint   mid_offset = (GLuint)derivatives.size();
+
+    derivatives.resize(mid_offset + evaluated_order + 1);
+
+    if (!evaluator(evaluated_order, u, &derivatives[mid_offset]))
+        return GL_FALSE;
+
+    // distance of the midpoint from the chord
+    const DCoordinate3 &p_a   = derivatives[a_offset];
+    const DCoordinate3 &p_b   = derivatives[b_offset];
+    const DCoordinate3 &p_mid = derivatives[mid_offset];
+
+    DCoordinate3 chord           = p_b - p_a;
+    GLdouble     squared_length  = chord * chord;
+    DCoordinate3 closest         = p_a;
+
+    if (squared_length > 0.0)
+        closest += chord * max(0.0, min(1.0, ((p_mid - p_a) * chord) / squared_length));
+
+    GLdouble deviation = (p_mid - closest).length();
+
+    // sag of the osculating parabola
+    GLdouble normal_acceleration = max(_NormalAcceleration(&derivatives[a_offset], evaluated_order),
+                                   max(_NormalAcceleration(&derivatives[b_offset], evaluated_order),
+                                       _NormalAcceleration(&derivatives[mid_offset], evaluated_order)));
+
+    deviation = max(deviation, (b - a) * (b - a) * normal_acceleration / 8.0);
+
+    if (deviation <= _tolerance)
+    {
+        // the midpoint has been the last evaluated one, thus its derivatives can be dropped
+        derivatives.resize(mid_offset);
+        return GL_TRUE;
+    }
+
+    if (!_Refine(evaluator, evaluated_order, a, a_offset, u, mid_offset, depth + 1, derivatives, samples))
+        return GL_FALSE;
+
+    Sample mid = {u, mid_offset};
+    samples.push_back(mid);
+
+    return _Refine(evaluator, evaluated_order, u, mid_offset, b, b_offset, depth + 1, derivatives, samples);
+}
+
+GenericCurve3* AdaptiveCurveSampler::GenerateImage(
+        const Evaluator& evaluator, GLuint available_order,
+        GLuint max_order_of_derivatives, GLdouble u_min, GLdouble u_max, GLenum usage_flag) const
+{
+    if (!evaluator || max_order_of_derivatives > available_order || u_min >= u_max)
+        return nullptr;
+
+    // the second derivatives are needed by the sag estimate, if the curve provides them
+    GLuint evaluated_order = max(max_order_of_derivatives, min(2u, available_order));
+
+    vector<DCoordinate3> derivatives(evaluated_order + 1);
+    vector<Sample>       samples;
+
+    if (!evaluator(evaluated_order, u_min, derivatives.data()))
+        return nullptr;
+
+    Sample first = {u_min, 0};
+    samples.push_back(first);
+
+    GLdouble u_step = (u_max - u_min) / _initial_segment_count;
+
+    for (GLuint i = 1; i <= _initial_segment_count; ++i)
+    {
+        GLdouble a        = samples.back().u;
+        GLuint   a_offset = samples.back().offset;
+        GLdouble b        = (i < _initial_segment_count) ? u_min + i * u_step : u_max;
+        GLuint   b_offset = (GLuint)derivatives.size();
+
+        derivatives.resize(b_offset + evaluated_order + 1);
+
+        if (!evaluator(evaluated_order, b, &derivatives[b_offset]))
+            return nullptr;
+
+        if (!_Refine(evaluator, evaluated_order, a, a_offset, b, b_offset, 0, derivatives, samples))
+            return nullptr;
+
+        Sample last = {b, b_offset};
+        samples.push_back(last);
+    }
+
+    GLuint point_count = (GLuint)samples.size();
+
+    GenericCurve3   *result = new GenericCurve3(max_order_of_derivatives, point_count, usage_flag);
+    vector<GLdouble> parameters(point_count);
+
+    for (GLuint k = 0; k < point_count; ++k)
+    {
+        for (GLuint order = 0; order <= max_order_of_derivatives; ++order)
+            (*result)(order, k) = derivatives[samples[k].offset + order];
+
+        parameters[k] = samples[k].u;
+    }
+
+    result->SetParameters(parameters);
+
+    return result;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <functional>
+#include <vector>
+#include "DCoordinates3.h"
+#include "GenericCurves3.h"
+
+namespace cagd
+{
+    //---------------------------
+    // class AdaptiveCurveSampler
+    //---------------------------
+    // curvature-adaptive counterpart of the uniform sampling of the GenerateImage methods: the definition domain
+    // is split into initial_segment_count uniform segments, that are bisected recursively until the estimated
+    // chordal deviation of each one falls below the tolerance, hence flat stretches are represented by few long
+    // chords, while tight bends get dense samples; the resulting image has a variable point count
+    //
+    // The deviation of a segment [a, b] is estimated by the larger one of
+    //   - the distance of the curve point at (a + b) / 2 from the chord, and
+    //   - the sag (b - a)^2 / 8 * |c' x c''| / |c'| of the osculating parabola, where the normal acceleration is
+    //     maximized over the end points and the midpoint;
+    // the second estimate detects the inflections and symmetric bends, whose midpoints happen to lie on the chord.
+    class AdaptiveCurveSampler
+    {
+    public:
+        // writes the derivatives of order 0, ..., max_order_of_derivatives at the parameter value u into
+        // derivatives[0], ..., derivatives[max_order_of_derivatives]
+        typedef std::function<GLboolean(GLuint max_order_of_derivatives, GLdouble u, DCoordinate3 *derivatives)> Evaluator;
+
+        static const GLuint DEFAULT_INITIAL_SEGMENT_COUNT = 4;
+        static const GLuint DEFAULT_MAXIMUM_DEPTH         = 12;
+
+    protected:
+        GLdouble _tolerance;
+        GLuint   _initial_segment_count;
+        GLuint   _maximum_depth;
+
+        // the accepted samples in increasing order of their parameter values, each of them stores
+        // _evaluated_order + 1 derivatives
+        struct Sample
+        {
+            GLdouble u;
+            GLuint   offset;
+        };
+
+        GLboolean _Refine(const Evaluator& evaluator, GLuint evaluated_order,
+                          GLdouble a, GLuint a_offset, GLdouble b, GLuint b_offset, GLuint depth,
+                          std::vector<DCoordinate3>& derivatives, std::vector<Sample>& samples) const;
+
+        GLdouble _NormalAcceleration(const DCoordinate3 *d, GLuint evaluated_order) const;
+
+    public:
+        // special/default constructor
+        AdaptiveCurveSampler(GLdouble tolerance = 1.0e-3,
+                             GLuint initial_segment_count = DEFAULT_INITIAL_SEGMENT_COUNT,
+                             GLuint maximum_depth = DEFAULT_MAXIMUM_DEPTH);
+
+        // set/get properties, the setters fail in case of a non-positive tolerance or segment count
+        GLboolean SetTolerance(GLdouble tolerance);
+        GLboolean SetInitialSegmentCount(GLuint initial_segment_count);
+        GLvoid    SetMaximumDepth(GLuint maximum_depth);
+
+        GLdouble GetTolerance() const;
+        GLuint   GetInitialSegmentCount() const;
+        GLuint   GetMaximumDepth() const;
+
+        // Samples the curve on [u_min, u_max]. The evaluator has to provide the derivatives up to the order
+        // max(max_order_of_derivatives, min(2, available_order)), where available_order is the highest order
+        // it supports; the returned image stores the derivatives up to max_order_of_derivatives. Returns a null
+        // pointer if an evaluation fails. The image has at most
+        // initial_segment_count * 2^maximum_depth + 1 points.
+        GenericCurve3* GenerateImage(const Evaluator& evaluator, GLuint available_order,
+                                     GLuint max_order_of_derivatives, GLdouble u_min, GLdouble u_max,
+                                     GLenum usage_flag = GL_STATIC_DRAW) const;
+    };
+}
@@ -0,0 +1,261 @@
+#include "ArcLengthTables.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace cagd;
+using namespace std;
+
+namespace
+{
+    // nodes and weights of the 5-point Gauss-Legendre rule on [-1, 1]
+    const GLdouble GAUSS_LEGENDRE_NODES[ArcLengthTable::GAUSS_LEGENDRE_NODE_COUNT] =
+    {
+        -0.9061798459386639928, -0.5384693101056830910, 0.0, 0.5384693101056830910, 0.9061798459386639928
+    };
+
+    const GLdouble GAUSS_LEGENDRE_WEIGHTS[ArcLengthTable::GAUSS_LEGENDRE_NODE_COUNT] =
+    {
+         0.2369268850561890875,  0.4786286704993664680, 0.5688888888888888889, 0.4786286704993664680, 0.2369268850561890875
+    };
+}
+
+// default constructor
+ArcLengthTable::ArcLengthTable()
+{
+}
+
+GLboolean ArcLengthTable::_Speed(GLdouble u, GLdouble& speed) const
+{
+    DCoordinate3 d[2];
+
+    if (!_evaluator(1, u, d))
+        return GL_FALSE;
+
+    speed = d[1].length();
+
+    return GL_TRUE;
+}
+
+GLboolean ArcLengthTable::_Length(GLdouble a, GLdouble b, GLdouble& length) const
+{
+    GLdouble center     = 0.5 * (a + b);
+    GLdouble half_width = 0.5 * (b - a);
+
+    length = 0.0;
+
+    for (GLuint k = 0; k < GAUSS_LEGENDRE_NODE_COUNT; ++k)
+    {
+        GLdouble speed;
+
+        if (!_Speed(center + half_width * GAUSS_LEGENDRE_NODES[k], speed))
+            return GL_FALSE;
+
+        length += GAUSS_LEGENDRE_WEIGHTS[k] * speed;
+    }
+
+    length *= half_width;
+
+    return GL_TRUE;
+}
+
+GLuint ArcLengthTable::_Segment(const vector<GLdouble>& values, GLdouble value) const
+{
+    GLuint index = (GLuint)(upper_bound(values.begin(), values.end(), value) - values.begin());
+
+    // values[index - 1] <= value < values[index], the last segment also contains the last value
+    return min(max(index, 1u), (GLuint)values.size() - 1) - 1;
+}
+
+GLboolean ArcLengthTable::Build(const Evaluator& evaluator, GLdouble u_min, GLdouble u_max, GLuint segment_count)
+{
+    Clear();
+
+    if (!evaluator || !segment_count || u_min >= u_max)
+        return GL_FALSE;
+
+    _evaluator = evaluator;
+
+    _u.resize(segment_count + 1);
+    _s.resize(segment_count + 1);
+    _speed.resize(segment_count + 1);
+
+    GLdouble u_step = (u_max - u_min) / segment_count;
+
+    for (GLuint i = 0; i < segment_count; ++i)
+        _u[i] = u_min + i * u_step;
+    _u[segment_count] = u_max;
+
+    _s[0] = 0.0;
+
+    for (GLuint i = 0; i <= segment_count; ++i)
+    {
+        if (!_Speed(_u[i], _speed[i]))
+        {
+            Clear();
+            return GL_FALSE;
+        }
+
+        if (i < segment_count)
+        {
+            GLdouble length;
+
+            if (!_Length(_u[i], _u[i + 1], length))
+            {
+                Clear();
+                return GL_FALSE;
+            }
+
+            _s[i + 1] = _s[i] + length;
+        }
+    }
+
+    return GL_TRUE;
+}
+
+GLboolean ArcLengthTable::BuildChordal(const DCoordinate3 *points, GLuint count)
+{
+    Clear();
+
+    if (!points || count < 2)
+        return GL_FALSE;
+
+    _u.resize(count);
+    _s.resize(count);
+
+    _u[0] = 0.0;
+    _s[0] = 0.0;
+
+    for (GLuint i = 1; i < count; ++i)
+    {
+        _u[i] = i;
+        _s[i] = _s[i - 1] + (points[i] - points[i - 1]).length();
+    }
+
+    return GL_TRUE;
+}
+
+GLvoid ArcLengthTable::Clear()
+{
+    _evaluator = Evaluator();
+    _u.clear();
+    _s.clear();
+    _speed.clear();
+}
+
+// get properties
+GLboolean ArcLengthTable::IsEmpty() const
+{
+    return _u.size() < 2;
+}
+
+GLuint ArcLengthTable::GetSegmentCount() const
+{
+    return IsEmpty() ? 0 : (GLuint)_u.size() - 1;
+}
+
+GLdouble ArcLengthTable::GetLength() const
+{
+    return IsEmpty() ? 0.0 : _s.back();
+}
+
+GLvoid ArcLengthTable::GetDefinitionDomain(GLdouble& u_min, GLdouble& u_max) const
+{
+    u_min = IsEmpty() ? 0.0 : _u.front();
+    u_max = IsEmpty() ? 0.0 : _u.back();
+}
+
+GLdouble ArcLengthTable::ArcLengthAt(GLdouble u) const
+{
+    if (IsEmpty())
+        return 0.0;
+
+    u = min(max(u, _u.front()), _u.back());
+
+    GLuint i = _Segment(_u, u);
+
+    if (_speed.empty())
+        return _s[i] + (u - _u[i]) / (_u[i + 1] - _u[i]) * (_s[i + 1] - _s[i]);
+
+    GLdouble length;
+
+    if (!_Length(_u[i], u, length))
+        return _s[i];
+
+    return _s[i] + length;
+}
+
+GLdouble ArcLengthTable::ParameterAt(GLdouble s, GLuint newton_iterations, GLdouble tolerance) const
+{
+    if (IsEmpty())
+        return 0.0;
+
+    GLdouble total_length = GetLength();
+
+    s = min(max(s, 0.0), total_length);
+
+    GLuint   i  = _Segment(_s, s);
+    GLdouble u0 = _u[i], u1 = _u[i + 1];
+    GLdouble s0 = _s[i], s1 = _s[i + 1];
+
+    if (s1 <= s0)
+        return u0;
+
+    GLdouble t = (s - s0) / (s1 - s0);
+
+    // the chords of sampled images are parametrized linearly
+    if (_speed.empty())
+        return u0 + t * (u1 - u0);
+
+    // cubic Hermite interpolation of u(s) on the segment, the slopes du/ds = 1 / |c'| are scaled by the length
+    // of the segment; a stationary end point falls back to the slope of the chord
+    GLdouble slope0 = (_speed[i]     > 0.0) ? (s1 - s0) / _speed[i]     : (u1 - u0);
+    GLdouble slope1 = (_speed[i + 1] > 0.0) ? (s1 - s0) / _speed[i + 1] : (u1 - u0);
+
+    GLdouble t2 = t * t, t3 = t2 * t;
+
+    GLdouble u = (2.0 * t3 - 3.0 * t2 + 1.0) * u0 + (t3 - 2.0 * t2 + t) * slope0
+               + (-2.0 * t3 + 3.0 * t2) * u1 + (t3 - t2) * slope1;
+
+    u = min(max(u, u0), u1);
+
+    // Newton iterations for s0 + int_{u0}^{u} |c'| dt - s = 0
+    for (GLuint iteration = 0; iteration < newton_iterations; ++iteration)
+    {
+        GLdouble length, speed;
+
+        if (!_Length(u0, u, length))
+            break;
+
+        GLdouble residual = s0 + length - s;
+
+        if (fabs(residual) <= tolerance * total_length)
+            break;
+
+        if (!_Speed(u, speed) || speed <= 0.0)
+            break;
+
+        u = min(max(u - residual / speed, u0), u1);
+    }
+
+    return u;
+}
+
+GLboolean ArcLengthTable::UniformSpeedParameters(GLuint count, vector<GLdouble>& u, GLuint newton_iterations) const
+{
+    if (IsEmpty() || count < 2)
+        return GL_FALSE;
+
+    u.resize(count);
+
+    GLdouble s_step = GetLength() / (count - 1);
+
+    u[0] = _u.front();
+
+    for (GLuint k = 1; k < count - 1; ++k)
+        u[k] = ParameterAt(k * s_step, newton_iterations);
+
+    u[count - 1] = _u.back();
+
+    return GL_TRUE;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <functional>
+#include <vector>
+#include "DCoordinates3.h"
+
+namespace cagd
+{
+    //---------------------
+    // class ArcLengthTable
+    //---------------------
+    // piecewise representation of the arc length s(u) = int_{u_min}^{u} |c'(t)| dt of a curve and of its inverse
+    // u(s), e.g., for uniform-speed sampling, dashed lines or feed-rate planning
+    //
+    // The definition domain is split into segment_count uniform segments, whose lengths are integrated by a
+    // GAUSS_LEGENDRE_NODE_COUNT-point Gauss-Legendre rule over the first derivative. The inverse is located by a
+    // binary search of the cumulative lengths, i.e., in O(log segment_count) time, and interpolated by the cubic
+    // Hermite polynomial that matches u and du/ds = 1 / |c'| at the end points of the segment; optional Newton
+    // iterations polish the result up to the accuracy of the quadrature.
+    //
+    // Tables of sampled images (see BuildChordal) use the point indices as parameters and the lengths of the
+    // chords, since the rendered polyline is piecewise linear.
+    class ArcLengthTable
+    {
+    public:
+        // writes the derivatives of order 0, ..., max_order_of_derivatives at the parameter value u into
+        // derivatives[0], ..., derivatives[max_order_of_derivatives], see also AdaptiveCurveSampler::Evaluator
+        typedef std::function<GLboolean(GLuint max_order_of_derivatives, GLdouble u, DCoordinate3 *derivatives)> Evaluator;
+
+        static const GLuint GAUSS_LEGENDRE_NODE_COUNT = 5;
+        static const GLuint DEFAULT_SEGMENT_COUNT     = 64;
+
+    protected:
+        Evaluator             _evaluator;       // empty in case of chordal tables
+        std::vector<GLdouble> _u;               // segment_count + 1 increasing parameter values
+        std::vector<GLdouble> _s;               // _s[i] is the arc length of [_u[0], _u[i]]
+        std::vector<GLdouble> _speed;           // |c'(_u[i])|, empty in case of chordal tables
+
+        GLboolean _Speed(GLdouble u, GLdouble& speed) const;
+
+        // Gauss-Legendre quadrature of the speed over [a, b]
+        GLboolean _Length(GLdouble a, GLdouble b, GLdouble& length) const;
+
+        // index of the segment that contains the given value of the increasing sequence values
+        GLuint _Segment(const std::vector<GLdouble>& values, GLdouble value) const;
+
+    public:
+        // default constructor, creates an empty table
+        ArcLengthTable();
+
+        // tabulates the arc length of the curve, that is evaluated by the given function up to the first order
+        // on [u_min, u_max]; the evaluator is stored for the Newton iterations of ParameterAt, hence the curve
+        // has to outlive the table and the table has to be rebuilt after the curve has been modified
+        GLboolean Build(const Evaluator& evaluator, GLdouble u_min, GLdouble u_max,
+                        GLuint segment_count = DEFAULT_SEGMENT_COUNT);
+
+        // tabulates the lengths of the chords of the polyline points[0], ..., points[count - 1], the parameter of
+        // points[i] is i
+        GLboolean BuildChordal(const DCoordinate3 *points, GLuint count);
+
+        // removes the stored segments
+        GLvoid Clear();
+
+        // get properties
+        GLboolean IsEmpty() const;
+        GLuint    GetSegmentCount() const;
+        GLdouble  GetLength() const;
+        GLvoid    GetDefinitionDomain(GLdouble& u_min, GLdouble& u_max) const;
+
+        // arc length of [u_min, u], where u is clamped to the definition domain
+        GLdouble ArcLengthAt(GLdouble u) const;
+
+        // parameter value that belongs to the arc length s, where s is clamped to [0, GetLength()]; the Newton
+        // iterations stop as soon as the arc length of the result differs from s by at most tolerance * GetLength()
+        GLdouble ParameterAt(GLdouble s, GLuint newton_iterations = 0, GLdouble tolerance = 1.0e-12) const;
+
+        // count >= 2 parameter values, that split the curve into count - 1 arcs of equal lengths
+        GLboolean UniformSpeedParameters(GLuint count, std::vector<GLdouble>& u, GLuint newton_iterations = 0) const;
+    };
+}
@@ -0,0 +1,109 @@
+#include "Arenas.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+using namespace cagd;
+using namespace std;
+
+// special constructor
+Arena::Arena(size_t default_block_size):
+        _current_block(0), _offset(0), _default_block_size(default_block_size)
+{
+}
+
+// returns size bytes aligned to alignment
+void* Arena::Allocate(size_t size, size_t alignment)
+{
+    // first fit in the current or in one of the subsequent, already reserved blocks
+    for (; _current_block < _blocks.size(); ++_current_block, _offset = 0)
+    {
+        Block &block = _blocks[_current_block];
+
+        uintptr_t address = reinterpret_cast<uintptr_t>(block.data) + _offset;
+        size_t    padding = (alignment - address % alignment) % alignment;
+
+        if (_offset + padding + size <= block.size)
+        {
+            _offset += padding + size;
+            return block.data + _offset - size;
+        }
+    }
+
+    // a new block that is large enough even for the worst case alignment
+    size_t block_size = max(_default_block_size, size + alignment);
+    if (!_blocks.empty())
+        block_size = max(block_size, 2 * _blocks.back().size);
+
+    Block block;
+    block.data = static_cast<char*>(::operator new(block_size));
+    block.size = block_size;
+    _blocks.push_back(block);
+
+    _current_block = _blocks.size() - 1;
+    _offset = 0;
+
+    return Allocate(size, alignment);
+}
+
+// releases everything allocated after the marker was taken
+Arena::Marker Arena::GetMarker() const
+{
+    Marker marker;
+    marker.block  = _current_block;
+    marker.offset = _offset;
+    return marker;
+}
+
+GLvoid Arena::Rewind(const Marker& marker)
+{
+    _current_block = marker.block;
+    _offset        = marker.offset;
+}
+
+// releases everything, the blocks are kept for reuse
+GLvoid Arena::Reset()
+{
+    _current_block = 0;
+    _offset        = 0;
+}
+
+// get properties
+size_t Arena::GetBlockCount() const
+{
+    return _blocks.size();
+}
+
+size_t Arena::GetReservedByteCount() const
+{
+    size_t result = 0;
+    for (vector<Block>::const_iterator it = _blocks.begin(); it != _blocks.end(); ++it)
+        result += it->size;
+    return result;
+}
+
+// the arena of the calling thread
+Arena& Arena::ThreadLocal()
+{
+    static thread_local Arena arena;
+    return arena;
+}
+
+// destructor
+Arena::~Arena()
+{
+    for (vector<Block>::iterator it = _blocks.begin(); it != _blocks.end(); ++it)
+        ::operator delete(it->data);
+}
+
+// rewinds the arena of the calling thread when the scope ends
+ArenaScope::ArenaScope():
+        _arena(Arena::ThreadLocal()), _marker(Arena::ThreadLocal().GetMarker())
+{
+}
+
+ArenaScope::~ArenaScope()
+{
+    _arena.Rewind(_marker);
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <vector>
+#include "Matrices.h"
+
+namespace cagd
+{
+    //------------
+    // class Arena
+    //------------
+    // bump allocator for short-lived evaluation temporaries: memory is handed out linearly from a
+    // list of blocks and is only given back all at once by Rewind() or Reset(); the blocks themselves
+    // are kept, so once an arena has grown to the size required by a job, repeating the job does not
+    // touch the heap at all
+    class Arena
+    {
+    public:
+        // position of the next free byte, used for nested rewinding
+        struct Marker
+        {
+            std::size_t block;
+            std::size_t offset;
+        };
+
+    protected:
+        struct Block
+        {
+            char*       data;
+            std::size_t size;
+        };
+
+        std::vector<Block>  _blocks;
+        std::size_t         _current_block;
+        std::size_t         _offset;
+        std::size_t         _default_block_size;
+
+    public:
+        // special constructor (can also be used as a default constructor)
+        Arena(std::size_t default_block_size = 64 * 1024);
+
+        // an arena cannot be shared
+        Arena(const Arena&) = delete;
+        Arena& operator =(const Arena&) = delete;
+
+        // returns size bytes aligned to alignment (a power of 2)
+        void* Allocate(std::size_t size, std::size_t alignment);
+
+        // releases everything allocated after the marker was taken
+        Marker GetMarker() const;
+        GLvoid Rewind(const Marker& marker);
+
+        // releases everything, the blocks are kept for reuse
+        GLvoid Reset();
+
+        // get properties
+        std::size_t GetBlockCount() const;
+        std::size_t GetReservedByteCount() const;
+
+        // the arena of the calling thread
+        static Arena& ThreadLocal();
+
+        // destructor
+        ~Arena();
+    };
+
+    //-----------------
+    // class ArenaScope
+    //-----------------
+    // rewinds the arena of the calling thread when the scope ends; it has to be declared before the
+    // temporaries that draw from the arena, so that they are destroyed before their memory is reused
+    class ArenaScope
+    {
+    protected:
+        Arena&          _arena;
+        Arena::Marker   _marker;
+
+    public:
+        ArenaScope();
+
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator =(const ArenaScope&) = delete;
+
+        ~ArenaScope();
+    };
+
+    //---------------------------------
+    // template class ArenaAllocator<T>
+    //---------------------------------
+    // stateless standard allocator drawing from the arena of the calling thread; deallocation is a
+    // no-op, the memory is reclaimed by the enclosing ArenaScope
+    template <typename T>
+    class ArenaAllocator
+    {
+    public:
+        typedef T value_type;
+
+        ArenaAllocator() noexcept
+        {
+        }
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t count)
+        {
+            return static_cast<T*>(Arena::ThreadLocal().Allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, std::size_t) noexcept
+        {
+        }
+    };
+
+    template <typename T, typename U>
+    inline bool operator ==(const ArenaAllocator<T>&, const ArenaAllocator<U>&)
+    {
+        return true;
+    }
+
+    template <typename T, typename U>
+    inline bool operator !=(const ArenaAllocator<T>&, const ArenaAllocator<U>&)
+    {
+        return false;
+    }
+
+    // matrices whose elements live in the arena of the calling thread
+    template <typename T>
+    using ArenaMatrix = Matrix<T, ArenaAllocator<T>>;
+
+    template <typename T>
+    using ArenaRowMatrix = RowMatrix<T, ArenaAllocator<T>>;
+
+    template <typename T>
+    using ArenaColumnMatrix = ColumnMatrix<T, ArenaAllocator<T>>;
+}
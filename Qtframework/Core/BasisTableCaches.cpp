@@ -0,0 +1,61 @@
+#include "BasisTableCaches.h"
+
+using namespace cagd;
+using namespace std;
+
+// special constructor
+BasisTableCacheKey::BasisTableCacheKey(
+        const type_index& type,
+        const vector<GLdouble>& shape_parameters,
+        GLdouble u_min, GLdouble u_max,
+        GLuint div_point_count, GLuint maximum_order_of_derivatives):
+        _type(type),
+        _shape_parameters(shape_parameters),
+        _u_min(u_min), _u_max(u_max),
+        _div_point_count(div_point_count),
+        _maximum_order_of_derivatives(maximum_order_of_derivatives)
+{
+}
+
+// strict weak ordering, the cheap fields are compared first
+GLboolean BasisTableCacheKey::operator <(const BasisTableCacheKey& rhs) const
+{
+    if (_type != rhs._type)
+        return _type < rhs._type;
+
+    if (_div_point_count != rhs._div_point_count)
+        return _div_point_count < rhs._div_point_count;
+
+    if (_maximum_order_of_derivatives != rhs._maximum_order_of_derivatives)
+        return _maximum_order_of_derivatives < rhs._maximum_order_of_derivatives;
+
+    if (_u_min != rhs._u_min)
+        return _u_min < rhs._u_min;
+
+    if (_u_max != rhs._u_max)
+        return _u_max < rhs._u_max;
+
+    return _shape_parameters < rhs._shape_parameters;
+}
+
+// the size of a table in bytes
+size_t BasisTableBytes::operator ()(const shared_ptr<const Matrix<GLdouble>>& table) const
+{
+    return (size_t)table->GetRowCount() * table->GetColumnCount() * sizeof(GLdouble);
+}
+
+const GLuint BasisTableCache::DEFAULT_CAPACITY;
+const GLuint BasisTableCache::MAXIMUM_TABLE_SIZE;
+
+// special/default constructor
+BasisTableCache::BasisTableCache(GLuint capacity):
+        LruCache<BasisTableCacheKey, shared_ptr<const Matrix<GLdouble>>, BasisTableBytes>(capacity)
+{
+}
+
+// the cache shared by all curves of the process
+BasisTableCache& BasisTableCache::Instance()
+{
+    static BasisTableCache cache;
+    return cache;
+}
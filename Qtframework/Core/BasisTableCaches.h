@@ -0,0 +1,77 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <memory>
+#include <typeindex>
+#include <vector>
+#include "LruCaches.h"
+#include "Matrices.h"
+
+namespace cagd
+{
+    //-------------------------
+    // class BasisTableCacheKey
+    //-------------------------
+    // identifies a table by the dynamic type of the curve, its shape parameters (e.g. the order n or the
+    // parameter alpha), its definition domain, the number of samples and the maximum order of derivatives
+    class BasisTableCacheKey
+    {
+    protected:
+        std::type_index       _type;
+        std::vector<GLdouble> _shape_parameters;
+        GLdouble              _u_min, _u_max;
+        GLuint                _div_point_count;
+        GLuint                _maximum_order_of_derivatives;
+
+    public:
+        BasisTableCacheKey(const std::type_index& type,
+                           const std::vector<GLdouble>& shape_parameters,
+                           GLdouble u_min, GLdouble u_max,
+                           GLuint div_point_count, GLuint maximum_order_of_derivatives);
+
+        GLboolean operator <(const BasisTableCacheKey& rhs) const;
+    };
+
+    //----------------------
+    // class BasisTableBytes
+    //----------------------
+    // the cost of a stored table is its size in bytes
+    class BasisTableBytes
+    {
+    public:
+        std::size_t operator ()(const std::shared_ptr<const Matrix<GLdouble>>& table) const;
+    };
+
+    //----------------------
+    // class BasisTableCache
+    //----------------------
+    // process-wide least recently used cache of sampled blending functions: for a fixed uniform sample grid the
+    // image of a linear combination is the product of the table of its blending function derivatives and of its
+    // control points, hence regenerating the image after the control points have been edited costs a single
+    // matrix product instead of the evaluation of the blending functions
+    //
+    // Row r * div_point_count + k of a table stores the derivatives of order r of all blending functions at the
+    // k-th sample, i.e., a table has (maximum_order_of_derivatives + 1) * div_point_count rows and data_count
+    // columns. The stored tables are never modified, thus they can be shared by several threads.
+    //
+    // The capacity of the cache is measured in bytes. Tables larger than MAXIMUM_TABLE_SIZE bytes are not built
+    // at all, since a few of them would evict all other tables, and the images of such dense grids or of such
+    // many control points are generated by the batch evaluation of the blending functions instead.
+    class BasisTableCache:
+            public LruCache<BasisTableCacheKey, std::shared_ptr<const Matrix<GLdouble>>, BasisTableBytes>
+    {
+    public:
+        typedef BasisTableCacheKey Key;
+
+        // total size of the tables kept by default, and the size of the largest table worth building, in bytes
+        static const GLuint DEFAULT_CAPACITY   = 64u << 20;
+        static const GLuint MAXIMUM_TABLE_SIZE = 8u << 20;
+
+        // special/default constructor
+        BasisTableCache(GLuint capacity = DEFAULT_CAPACITY);
+
+        // the cache shared by all curves of the process
+        static BasisTableCache& Instance();
+    };
+}
@@ -0,0 +1,448 @@
+#include "DCoordinate3Arrays.h"
+#include <algorithm>
+#include <cmath>
+
+// all kernels below require AVX only (4-wide double and 8-wide float arithmetic, square roots, minima, maxima and
+// conversions); FMA instructions are used by Axpy if they are also targeted
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define CAGD_COORDINATE_ARRAYS_AVX
+#endif
+
+using namespace cagd;
+using namespace std;
+
+#ifdef CAGD_COORDINATE_ARRAYS_AVX
+namespace
+{
+    // the kernels are written once in terms of the register type of their scalar type, the specializations
+    // below map the operations onto the corresponding 4-wide double, resp. 8-wide float instructions
+    template <typename T>
+    struct AVXRegister;
+
+    template <>
+    struct AVXRegister<GLdouble>
+    {
+        typedef __m256d Type;
+
+        enum {WIDTH = 4};
+
+        static Type Load(const GLdouble *p)                 { return _mm256_loadu_pd(p); }
+        static GLvoid Store(GLdouble *p, Type a)            { _mm256_storeu_pd(p, a); }
+        static Type Broadcast(GLdouble a)                   { return _mm256_set1_pd(a); }
+        static Type Add(Type a, Type b)                     { return _mm256_add_pd(a, b); }
+        static Type Subtract(Type a, Type b)                { return _mm256_sub_pd(a, b); }
+        static Type Multiply(Type a, Type b)                { return _mm256_mul_pd(a, b); }
+        static Type Divide(Type a, Type b)                  { return _mm256_div_pd(a, b); }
+        static Type SquareRoot(Type a)                      { return _mm256_sqrt_pd(a); }
+        static Type Minimum(Type a, Type b)                 { return _mm256_min_pd(a, b); }
+        static Type Maximum(Type a, Type b)                 { return _mm256_max_pd(a, b); }
+
+        // a * b + c
+        static Type MultiplyAdd(Type a, Type b, Type c)
+        {
+        #if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+            return _mm256_fmadd_pd(a, b, c);
+        #else
+            return _mm256_add_pd(c, _mm256_mul_pd(a, b));
+        #endif
+        }
+
+        // the lanes of a, where mask is zero, otherwise the lanes of b
+        static Type SelectIfZero(Type mask, Type a, Type b)
+        {
+            return _mm256_blendv_pd(b, a, _mm256_cmp_pd(mask, _mm256_setzero_pd(), _CMP_EQ_OQ));
+        }
+    };
+
+    template <>
+    struct AVXRegister<GLfloat>
+    {
+        typedef __m256 Type;
+
+        enum {WIDTH = 8};
+
+        static Type Load(const GLfloat *p)                  { return _mm256_loadu_ps(p); }
+        static GLvoid Store(GLfloat *p, Type a)             { _mm256_storeu_ps(p, a); }
+        static Type Broadcast(GLfloat a)                    { return _mm256_set1_ps(a); }
+        static Type Add(Type a, Type b)                     { return _mm256_add_ps(a, b); }
+        static Type Subtract(Type a, Type b)                { return _mm256_sub_ps(a, b); }
+        static Type Multiply(Type a, Type b)                { return _mm256_mul_ps(a, b); }
+        static Type Divide(Type a, Type b)                  { return _mm256_div_ps(a, b); }
+        static Type SquareRoot(Type a)                      { return _mm256_sqrt_ps(a); }
+        static Type Minimum(Type a, Type b)                 { return _mm256_min_ps(a, b); }
+        static Type Maximum(Type a, Type b)                 { return _mm256_max_ps(a, b); }
+
+        static Type MultiplyAdd(Type a, Type b, Type c)
+        {
+        #if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+            return _mm256_fmadd_ps(a, b, c);
+        #else
+            return _mm256_add_ps(c, _mm256_mul_ps(a, b));
+        #endif
+        }
+
+        static Type SelectIfZero(Type mask, Type a, Type b)
+        {
+            return _mm256_blendv_ps(b, a, _mm256_cmp_ps(mask, _mm256_setzero_ps(), _CMP_EQ_OQ));
+        }
+    };
+
+    // the next 4 elements of the x, y and z components, converted to single precision
+    inline GLvoid LoadFloats(const GLdouble *x, const GLdouble *y, const GLdouble *z, __m128& x4, __m128& y4, __m128& z4)
+    {
+        x4 = _mm256_cvtpd_ps(_mm256_loadu_pd(x));
+        y4 = _mm256_cvtpd_ps(_mm256_loadu_pd(y));
+        z4 = _mm256_cvtpd_ps(_mm256_loadu_pd(z));
+    }
+
+    inline GLvoid LoadFloats(const GLfloat *x, const GLfloat *y, const GLfloat *z, __m128& x4, __m128& y4, __m128& z4)
+    {
+        x4 = _mm_loadu_ps(x);
+        y4 = _mm_loadu_ps(y);
+        z4 = _mm_loadu_ps(z);
+    }
+}
+#endif
+
+// special/default constructor
+template <typename T>
+Coordinate3Array<T>::Coordinate3Array(GLuint size):
+        _size(0)
+{
+    Resize(size);
+}
+
+// special constructor
+template <typename T>
+Coordinate3Array<T>::Coordinate3Array(const vector<DCoordinate3>& coordinates):
+        _size(0)
+{
+    Load(coordinates);
+}
+
+template <typename T>
+GLvoid Coordinate3Array<T>::Resize(GLuint size)
+{
+    _size = size;
+    for (GLuint c = 0; c < 3; ++c)
+        _component[c].resize(size, (T)0);
+}
+
+template <typename T>
+GLvoid Coordinate3Array<T>::LoadNullVectors()
+{
+    for (GLuint c = 0; c < 3; ++c)
+        fill(_component[c].begin(), _component[c].end(), (T)0);
+}
+
+template <typename T>
+GLvoid Coordinate3Array<T>::Load(const DCoordinate3 *coordinates, GLuint count)
+{
+    _size = count;
+    for (GLuint c = 0; c < 3; ++c)
+        _component[c].resize(count);
+
+    const GLdouble *source = reinterpret_cast<const GLdouble*>(coordinates);
+    T              *x = _component[0].data(), *y = _component[1].data(), *z = _component[2].data();
+
+    for (GLuint i = 0; i < count; ++i, source += 3)
+    {
+        x[i] = (T)source[0];
+        y[i] = (T)source[1];
+        z[i] = (T)source[2];
+    }
+}
+
+template <typename T>
+GLvoid Coordinate3Array<T>::Load(const vector<DCoordinate3>& coordinates)
+{
+    Load(coordinates.data(), (GLuint)coordinates.size());
+}
+
+template <typename T>
+GLvoid Coordinate3Array<T>::Store(DCoordinate3 *coordinates) const
+{
+    GLdouble *target = reinterpret_cast<GLdouble*>(coordinates);
+    const T  *x = _component[0].data(), *y = _component[1].data(), *z = _component[2].data();
+
+    for (GLuint i = 0; i < _size; ++i, target += 3)
+    {
+        target[0] = x[i];
+        target[1] = y[i];
+        target[2] = z[i];
+    }
+}
+
+template <typename T>
+GLvoid Coordinate3Array<T>::Store(vector<DCoordinate3>& coordinates) const
+{
+    coordinates.resize(_size);
+    Store(coordinates.data());
+}
+
+template <typename T>
+GLboolean Coordinate3Array<T>::Axpy(T a, const Coordinate3Array& x)
+{
+    if (x._size != _size)
+        return GL_FALSE;
+
+    for (GLuint c = 0; c < 3; ++c)
+    {
+        T       *y_c = _component[c].data();
+        const T *x_c = x._component[c].data();
+        GLuint   i   = 0;
+
+#ifdef CAGD_COORDINATE_ARRAYS_AVX
+        typedef AVXRegister<T> R;
+
+        typename R::Type a_r = R::Broadcast(a);
+        for (; i + R::WIDTH <= _size; i += R::WIDTH)
+            R::Store(y_c + i, R::MultiplyAdd(a_r, R::Load(x_c + i), R::Load(y_c + i)));
+#endif
+
+        for (; i < _size; ++i)
+            y_c[i] += a * x_c[i];
+    }
+
+    return GL_TRUE;
+}
+
+template <typename T>
+GLboolean Coordinate3Array<T>::CrossProduct(const Coordinate3Array& lhs, const Coordinate3Array& rhs)
+{
+    if (lhs._size != rhs._size)
+        return GL_FALSE;
+
+    if (_size != lhs._size)
+        Resize(lhs._size);
+
+    const T *ax = lhs._component[0].data(), *ay = lhs._component[1].data(), *az = lhs._component[2].data();
+    const T *bx = rhs._component[0].data(), *by = rhs._component[1].data(), *bz = rhs._component[2].data();
+    T       *cx = _component[0].data(),     *cy = _component[1].data(),     *cz = _component[2].data();
+
+    GLuint i = 0;
+
+#ifdef CAGD_COORDINATE_ARRAYS_AVX
+    typedef AVXRegister<T> R;
+
+    for (; i + R::WIDTH <= _size; i += R::WIDTH)
+    {
+        typename R::Type ax_r = R::Load(ax + i), ay_r = R::Load(ay + i), az_r = R::Load(az + i);
+        typename R::Type bx_r = R::Load(bx + i), by_r = R::Load(by + i), bz_r = R::Load(bz + i);
+
+        R::Store(cx + i, R::Subtract(R::Multiply(ay_r, bz_r), R::Multiply(az_r, by_r)));
+        R::Store(cy + i, R::Subtract(R::Multiply(az_r, bx_r), R::Multiply(ax_r, bz_r)));
+        R::Store(cz + i, R::Subtract(R::Multiply(ax_r, by_r), R::Multiply(ay_r, bx_r)));
+    }
+#endif
+
+    for (; i < _size; ++i)
+    {
+        T x = ay[i] * bz[i] - az[i] * by[i];
+        T y = az[i] * bx[i] - ax[i] * bz[i];
+        T z = ax[i] * by[i] - ay[i] * bx[i];
+
+        cx[i] = x;
+        cy[i] = y;
+        cz[i] = z;
+    }
+
+    return GL_TRUE;
+}
+
+template <typename T>
+GLvoid Coordinate3Array<T>::Normalize()
+{
+    T *x = _component[0].data(), *y = _component[1].data(), *z = _component[2].data();
+
+    GLuint i = 0;
+
+#ifdef CAGD_COORDINATE_ARRAYS_AVX
+    typedef AVXRegister<T> R;
+
+    typename R::Type one = R::Broadcast((T)1);
+
+    for (; i + R::WIDTH <= _size; i += R::WIDTH)
+    {
+        typename R::Type x_r = R::Load(x + i), y_r = R::Load(y + i), z_r = R::Load(z + i);
+        typename R::Type length = R::SquareRoot(R::Add(R::Add(R::Multiply(x_r, x_r), R::Multiply(y_r, y_r)),
+                                                       R::Multiply(z_r, z_r)));
+
+        // null vectors are scaled by 1, the others by the reciprocals of their lengths
+        typename R::Type scale = R::SelectIfZero(length, one, R::Divide(one, length));
+
+        R::Store(x + i, R::Multiply(x_r, scale));
+        R::Store(y + i, R::Multiply(y_r, scale));
+        R::Store(z + i, R::Multiply(z_r, scale));
+    }
+#endif
+
+    for (; i < _size; ++i)
+    {
+        T length = sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+
+        if (length != (T)0)
+        {
+            T scale = (T)1 / length;
+
+            x[i] *= scale;
+            y[i] *= scale;
+            z[i] *= scale;
+        }
+    }
+}
+
+template <typename T>
+GLboolean Coordinate3Array<T>::CalculateBounds(DCoordinate3& minimum, DCoordinate3& maximum) const
+{
+    if (!_size)
+        return GL_FALSE;
+
+    for (GLuint c = 0; c < 3; ++c)
+    {
+        const T *v = _component[c].data();
+        T        lower = v[0], upper = v[0];
+        GLuint   i = 0;
+
+#ifdef CAGD_COORDINATE_ARRAYS_AVX
+        typedef AVXRegister<T> R;
+
+        if (_size >= (GLuint)R::WIDTH)
+        {
+            typename R::Type lower_r = R::Load(v), upper_r = lower_r;
+
+            for (i = R::WIDTH; i + R::WIDTH <= _size; i += R::WIDTH)
+            {
+                typename R::Type v_r = R::Load(v + i);
+                lower_r = R::Minimum(lower_r, v_r);
+                upper_r = R::Maximum(upper_r, v_r);
+            }
+
+            T lanes[R::WIDTH];
+
+            R::Store(lanes, lower_r);
+            lower = *min_element(lanes, lanes + R::WIDTH);
+
+            R::Store(lanes, upper_r);
+            upper = *max_element(lanes, lanes + R::WIDTH);
+        }
+#endif
+
+        for (; i < _size; ++i)
+        {
+            lower = min(lower, v[i]);
+            upper = max(upper, v[i]);
+        }
+
+        minimum[c] = lower;
+        maximum[c] = upper;
+    }
+
+    return GL_TRUE;
+}
+
+template <typename T>
+GLvoid Coordinate3Array<T>::PackToFloats(GLfloat *coordinates, GLuint stride) const
+{
+    const T *x = _component[0].data(), *y = _component[1].data(), *z = _component[2].data();
+
+    GLuint i = 0;
+
+#ifdef CAGD_COORDINATE_ARRAYS_AVX
+    if (stride == 3)
+    {
+        for (; i + 4 <= _size; i += 4)
+        {
+            __m128 x4, y4, z4;
+            LoadFloats(x + i, y + i, z + i, x4, y4, z4);
+
+            // x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+            __m128 xy01 = _mm_unpacklo_ps(x4, y4);                              // x0 y0 x1 y1
+            __m128 xy23 = _mm_unpackhi_ps(x4, y4);                              // x2 y2 x3 y3
+            __m128 zx01 = _mm_shuffle_ps(z4, x4, _MM_SHUFFLE(1, 1, 0, 0));      // z0 z0 x1 x1
+            __m128 yz11 = _mm_shuffle_ps(y4, z4, _MM_SHUFFLE(1, 1, 1, 1));      // y1 y1 z1 z1
+            __m128 zxy3 = _mm_shuffle_ps(z4, xy23, _MM_SHUFFLE(3, 2, 3, 2));    // z2 z3 x3 y3
+
+            GLfloat *target = coordinates + 3 * i;
+
+            _mm_storeu_ps(target,     _mm_shuffle_ps(xy01, zx01, _MM_SHUFFLE(2, 0, 1, 0)));
+            _mm_storeu_ps(target + 4, _mm_shuffle_ps(yz11, xy23, _MM_SHUFFLE(1, 0, 2, 0)));
+            _mm_storeu_ps(target + 8, _mm_shuffle_ps(zxy3, zxy3, _MM_SHUFFLE(1, 3, 2, 0)));
+        }
+    }
+#endif
+
+    for (; i < _size; ++i)
+    {
+        GLfloat *target = coordinates + stride * i;
+
+        target[0] = (GLfloat)x[i];
+        target[1] = (GLfloat)y[i];
+        target[2] = (GLfloat)z[i];
+    }
+}
+
+template <typename T>
+GLvoid Coordinate3Array<T>::PackToFloats(const DCoordinate3 *coordinates, GLuint count, GLfloat *result)
+{
+    const GLdouble *source = reinterpret_cast<const GLdouble*>(coordinates);
+    GLuint          n = 3 * count, i = 0;
+
+#ifdef CAGD_COORDINATE_ARRAYS_AVX
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128 lower = _mm256_cvtpd_ps(_mm256_loadu_pd(source + i));
+        __m128 upper = _mm256_cvtpd_ps(_mm256_loadu_pd(source + i + 4));
+
+        _mm_storeu_ps(result + i, lower);
+        _mm_storeu_ps(result + i + 4, upper);
+    }
+#endif
+
+    for (; i < n; ++i)
+        result[i] = (GLfloat)source[i];
+}
+
+template <typename T>
+GLvoid Coordinate3Array<T>::PackSegmentsToFloats(
+        const DCoordinate3 *points, const DCoordinate3 *directions, GLdouble scale, GLuint count, GLfloat *result)
+{
+    const GLdouble *p = reinterpret_cast<const GLdouble*>(points);
+    const GLdouble *d = reinterpret_cast<const GLdouble*>(directions);
+
+    GLuint i = 0;
+
+#ifdef CAGD_COORDINATE_ARRAYS_AVX
+    typedef AVXRegister<GLdouble> R;
+
+    const __m256i xyz_mask = _mm256_set_epi64x(0, -1, -1, -1);
+    const __m256d scale_r  = R::Broadcast(scale);
+
+    // every store writes a fourth float that is overwritten by the next one, hence the last segment is
+    // converted by the scalar loop
+    for (; i + 1 < count; ++i)
+    {
+        __m256d point = _mm256_maskload_pd(p + 3 * i, xyz_mask);
+        __m256d end   = R::MultiplyAdd(scale_r, _mm256_maskload_pd(d + 3 * i, xyz_mask), point);
+
+        _mm_storeu_ps(result + 6 * i,     _mm256_cvtpd_ps(point));
+        _mm_storeu_ps(result + 6 * i + 3, _mm256_cvtpd_ps(end));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        for (GLuint j = 0; j < 3; ++j)
+        {
+            result[6 * i + j]     = (GLfloat)p[3 * i + j];
+            result[6 * i + j + 3] = (GLfloat)(p[3 * i + j] + scale * d[3 * i + j]);
+        }
+    }
+}
+
+namespace cagd
+{
+    template class Coordinate3Array<GLdouble>;
+    template class Coordinate3Array<GLfloat>;
+}
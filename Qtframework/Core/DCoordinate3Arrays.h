@@ -0,0 +1,122 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <vector>
+#include "DCoordinates3.h"
+
+namespace cagd
+{
+    //-----------------------
+    // class Coordinate3Array
+    //-----------------------
+    // structure-of-arrays counterpart of std::vector<DCoordinate3>: the x, y and z components are stored by
+    // separate contiguous arrays of the scalar type T, hence the bulk operations below process 4 (GLdouble)
+    // or 8 (GLfloat) coordinates at once by AVX instructions (if the build targets them), instead of one
+    // DCoordinate3 operator call per element; the single precision instantiation is meant for display-only
+    // geometry, which is truncated to floats at upload anyway
+    template <typename T = GLdouble>
+    class Coordinate3Array
+    {
+    private:
+        GLuint         _size;
+        std::vector<T> _component[3];
+
+    public:
+        // special/default constructor, creates size null vectors
+        Coordinate3Array(GLuint size = 0);
+
+        // special constructor, converts an array of structures
+        Coordinate3Array(const std::vector<DCoordinate3>& coordinates);
+
+        // resizing keeps the leading elements, the new ones are null vectors
+        GLvoid Resize(GLuint size);
+        GLuint GetSize() const;
+
+        // sets every element to the null vector
+        GLvoid LoadNullVectors();
+
+        // get element by value, converted to double precision
+        DCoordinate3 operator [](GLuint index) const;
+
+        // set element, converted to the scalar type T
+        GLvoid Set(GLuint index, const DCoordinate3& coordinate);
+
+        // the contiguous array of the x (0), y (1) or z (2) components
+        T*       GetData(GLuint component);
+        const T* GetData(GLuint component) const;
+
+        // conversion from/to arrays of structures, Load resizes *this to count elements, while Store writes
+        // GetSize() elements
+        GLvoid Load(const DCoordinate3 *coordinates, GLuint count);
+        GLvoid Load(const std::vector<DCoordinate3>& coordinates);
+        GLvoid Store(DCoordinate3 *coordinates) const;
+        GLvoid Store(std::vector<DCoordinate3>& coordinates) const;
+
+        // *this += a * x, fails if the sizes differ
+        GLboolean Axpy(T a, const Coordinate3Array& x);
+
+        // element-wise cross products *this = lhs ^ rhs, fails if the sizes differ; *this may coincide with
+        // either operand
+        GLboolean CrossProduct(const Coordinate3Array& lhs, const Coordinate3Array& rhs);
+
+        // normalizes every element by multiplying it with the reciprocal of its length (hence the results may
+        // differ from DCoordinate3::normalize in the last bit), null vectors are left unchanged
+        GLvoid Normalize();
+
+        // component-wise minimum and maximum of the elements, i.e., the corners of the axis-aligned bounding
+        // box; fails if the array is empty
+        GLboolean CalculateBounds(DCoordinate3& minimum, DCoordinate3& maximum) const;
+
+        // converts the elements into single precision x, y, z triplets; the first floats of consecutive
+        // elements are stride floats apart, e.g., 3 for a tightly packed vertex buffer object
+        GLvoid PackToFloats(GLfloat *coordinates, GLuint stride = 3) const;
+
+        // converts count tightly packed DCoordinate3 instances into single precision x, y, z triplets;
+        // since an array of structures is a contiguous array of doubles, no reordering is needed
+        static GLvoid PackToFloats(const DCoordinate3 *coordinates, GLuint count, GLfloat *result);
+
+        // converts count tightly packed pairs (point, point + scale * direction) into 6 single precision floats
+        // each, i.e., into the line segments of a derivative vertex buffer object, without temporary arrays
+        static GLvoid PackSegmentsToFloats(const DCoordinate3 *points, const DCoordinate3 *directions,
+                                           GLdouble scale, GLuint count, GLfloat *result);
+    };
+
+    // the instantiations provided by DCoordinate3Arrays.cpp
+    typedef Coordinate3Array<GLdouble> DCoordinate3Array;
+    typedef Coordinate3Array<GLfloat>  FCoordinate3Array;
+
+    extern template class Coordinate3Array<GLdouble>;
+    extern template class Coordinate3Array<GLfloat>;
+
+    template <typename T>
+    inline GLuint Coordinate3Array<T>::GetSize() const
+    {
+        return _size;
+    }
+
+    template <typename T>
+    inline DCoordinate3 Coordinate3Array<T>::operator [](GLuint index) const
+    {
+        return DCoordinate3(_component[0][index], _component[1][index], _component[2][index]);
+    }
+
+    template <typename T>
+    inline GLvoid Coordinate3Array<T>::Set(GLuint index, const DCoordinate3& coordinate)
+    {
+        _component[0][index] = (T)coordinate[0];
+        _component[1][index] = (T)coordinate[1];
+        _component[2][index] = (T)coordinate[2];
+    }
+
+    template <typename T>
+    inline T* Coordinate3Array<T>::GetData(GLuint component)
+    {
+        return _component[component].data();
+    }
+
+    template <typename T>
+    inline const T* Coordinate3Array<T>::GetData(GLuint component) const
+    {
+        return _component[component].data();
+    }
+}
@@ -0,0 +1,87 @@
+#include "FactorizationCaches.h"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace cagd;
+using namespace std;
+
+// special constructor
+FactorizationCacheKey::FactorizationCacheKey(
+        const type_index& type,
+        const vector<GLdouble>& shape_parameters,
+        const ColumnMatrix<GLdouble>& knot_vector):
+        _type(type),
+        _shape_parameters(shape_parameters),
+        _knot_vector_hash(HashKnotVector(knot_vector)),
+        _knot_vector(knot_vector.GetData(), knot_vector.GetData() + knot_vector.GetRowCount())
+{
+}
+
+std::size_t FactorizationCacheKey::GetKnotVectorHash() const
+{
+    return _knot_vector_hash;
+}
+
+// strict weak ordering, the cheap fields are compared first
+GLboolean FactorizationCacheKey::operator <(const FactorizationCacheKey& rhs) const
+{
+    if (_type != rhs._type)
+        return _type < rhs._type;
+
+    if (_knot_vector_hash != rhs._knot_vector_hash)
+        return _knot_vector_hash < rhs._knot_vector_hash;
+
+    if (_shape_parameters != rhs._shape_parameters)
+        return _shape_parameters < rhs._shape_parameters;
+
+    return _knot_vector < rhs._knot_vector;
+}
+
+// FNV-1a hash of the bit patterns of the knot values
+std::size_t FactorizationCacheKey::HashKnotVector(const ColumnMatrix<GLdouble>& knot_vector)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    const GLdouble *knots = knot_vector.GetData();
+    for (GLuint i = 0; i < knot_vector.GetRowCount(); ++i)
+    {
+        // -0.0 and 0.0 represent the same knot
+        GLdouble knot = (knots[i] == 0.0 ? 0.0 : knots[i]);
+
+        uint64_t bits;
+        memcpy(&bits, &knot, sizeof(bits));
+
+        for (GLuint byte = 0; byte < sizeof(bits); ++byte)
+        {
+            hash ^= (bits >> (8 * byte)) & 0xff;
+            hash *= 1099511628211ull;
+        }
+    }
+
+    return (std::size_t)hash;
+}
+
+// special/default constructor
+FactorizationCache::FactorizationCache(GLuint capacity):
+        LruCache<FactorizationCacheKey, shared_ptr<RealSquareMatrix>>(capacity)
+{
+}
+
+// the cache shared by all curves of the process
+FactorizationCache& FactorizationCache::Instance()
+{
+    static FactorizationCache cache;
+    return cache;
+}
+
+GLboolean FactorizationCache::Insert(const Key& key, const shared_ptr<RealSquareMatrix>& collocation_matrix)
+{
+    // mixed precision factors would be updated by SolveLinearSystem
+    if (!collocation_matrix ||
+        collocation_matrix->GetPrecision() != RealSquareMatrix::DOUBLE_PRECISION ||
+        !collocation_matrix->PerformLUDecomposition())
+        return GL_FALSE;
+
+    return LruCache<FactorizationCacheKey, shared_ptr<RealSquareMatrix>>::Insert(key, collocation_matrix);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <memory>
+#include <typeindex>
+#include <vector>
+#include "LruCaches.h"
+#include "Matrices.h"
+#include "RealSquareMatrices.h"
+
+namespace cagd
+{
+    //----------------------------
+    // class FactorizationCacheKey
+    //----------------------------
+    // identifies a collocation matrix by the dynamic type of the curve, its shape parameters (e.g. the order n
+    // or the parameter alpha) and the knot vector; the hash of the knot vector is compared first, the knot
+    // values themselves are only compared in case of equal hashes
+    class FactorizationCacheKey
+    {
+    protected:
+        std::type_index       _type;
+        std::vector<GLdouble> _shape_parameters;
+        std::size_t           _knot_vector_hash;
+        std::vector<GLdouble> _knot_vector;
+
+    public:
+        FactorizationCacheKey(const std::type_index& type,
+                              const std::vector<GLdouble>& shape_parameters,
+                              const ColumnMatrix<GLdouble>& knot_vector);
+
+        std::size_t GetKnotVectorHash() const;
+
+        GLboolean operator <(const FactorizationCacheKey& rhs) const;
+
+        // FNV-1a hash of the bit patterns of the knot values
+        static std::size_t HashKnotVector(const ColumnMatrix<GLdouble>& knot_vector);
+    };
+
+    //-------------------------
+    // class FactorizationCache
+    //-------------------------
+    // process-wide least recently used cache of LU decomposed collocation matrices; repeated interpolation
+    // over the same knot vector costs only the O(n^2) forward and back substitutions of SolveLinearSystem
+    //
+    // The stored matrices are always factorized in double precision, i.e., their SolveLinearSystem calls
+    // only read the factors and can be shared by several threads.
+    class FactorizationCache: public LruCache<FactorizationCacheKey, std::shared_ptr<RealSquareMatrix>>
+    {
+    public:
+        typedef FactorizationCacheKey Key;
+
+        // special/default constructor
+        FactorizationCache(GLuint capacity = DEFAULT_CAPACITY);
+
+        // the cache shared by all curves of the process
+        static FactorizationCache& Instance();
+
+        // stores a collocation matrix, fails if it cannot be LU decomposed in double precision
+        GLboolean Insert(const Key& key, const std::shared_ptr<RealSquareMatrix>& collocation_matrix);
+    };
+}
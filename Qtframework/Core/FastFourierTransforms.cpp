@@ -0,0 +1,139 @@
+#include "FastFourierTransforms.h"
+#include "Constants.h"
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace cagd;
+using namespace std;
+
+// special/default constructor
+FastFourierTransform::FastFourierTransform(GLuint length):
+        _length(length),
+        _padded_length(1)
+{
+    if (_length <= 1)
+        return;
+
+    // Bluestein's algorithm convolves sequences of length n cyclically, which requires 2n - 1 values
+    GLboolean power_of_two = !(_length & (_length - 1));
+    GLuint    minimal_length = power_of_two ? _length : 2 * _length - 1;
+
+    GLuint log2_length = 0;
+    while (_padded_length < minimal_length)
+    {
+        _padded_length <<= 1;
+        ++log2_length;
+    }
+
+    _bit_reversal.resize(_padded_length);
+    for (GLuint k = 0; k < _padded_length; ++k)
+    {
+        GLuint reversed = 0;
+        for (GLuint bit = 0; bit < log2_length; ++bit)
+            reversed |= ((k >> bit) & 1) << (log2_length - 1 - bit);
+        _bit_reversal[k] = reversed;
+    }
+
+    // the twiddle factors are evaluated directly instead of by recurrences, which would accumulate errors
+    _twiddle_factors.resize(_padded_length / 2);
+    for (GLuint k = 0; k < _padded_length / 2; ++k)
+    {
+        GLdouble angle = -TWO_PI * k / _padded_length;
+        _twiddle_factors[k] = Complex(cos(angle), sin(angle));
+    }
+
+    if (power_of_two)
+        return;
+
+    // the exponent k^2 is reduced modulo 2n in integer arithmetic, such that the angles remain small
+    _chirp.resize(_length);
+    for (GLuint k = 0; k < _length; ++k)
+    {
+        uint64_t exponent = ((uint64_t)k * k) % (2 * (uint64_t)_length);
+        GLdouble angle = -PI * (GLdouble)exponent / _length;
+        _chirp[k] = Complex(cos(angle), sin(angle));
+    }
+
+    _filter_spectrum.assign(_padded_length, Complex(0.0, 0.0));
+    _filter_spectrum[0] = conj(_chirp[0]);
+    for (GLuint k = 1; k < _length; ++k)
+        _filter_spectrum[k] = _filter_spectrum[_padded_length - k] = conj(_chirp[k]);
+
+    _Radix2(_filter_spectrum.data(), GL_FALSE);
+}
+
+GLuint FastFourierTransform::GetLength() const
+{
+    return _length;
+}
+
+GLvoid FastFourierTransform::_Radix2(Complex *values, GLboolean inverse) const
+{
+    for (GLuint k = 0; k < _padded_length; ++k)
+        if (k < _bit_reversal[k])
+            swap(values[k], values[_bit_reversal[k]]);
+
+    for (GLuint half = 1; half < _padded_length; half <<= 1)
+    {
+        GLuint stride = _padded_length / (2 * half);
+
+        for (GLuint start = 0; start < _padded_length; start += 2 * half)
+        {
+            for (GLuint k = 0; k < half; ++k)
+            {
+                Complex w = _twiddle_factors[k * stride];
+                if (inverse)
+                    w = conj(w);
+
+                Complex t = w * values[start + k + half];
+                values[start + k + half] = values[start + k] - t;
+                values[start + k] += t;
+            }
+        }
+    }
+}
+
+GLboolean FastFourierTransform::Transform(vector<Complex>& values, GLboolean inverse) const
+{
+    if (values.size() != _length)
+        return GL_FALSE;
+
+    if (_length <= 1)
+        return GL_TRUE;
+
+    if (_chirp.empty())
+    {
+        _Radix2(values.data(), inverse);
+    }
+    else
+    {
+        // the inverse transform is the conjugate of the forward transform of the conjugate values
+        vector<Complex> padded_values(_padded_length, Complex(0.0, 0.0));
+        for (GLuint k = 0; k < _length; ++k)
+            padded_values[k] = (inverse ? conj(values[k]) : values[k]) * _chirp[k];
+
+        _Radix2(padded_values.data(), GL_FALSE);
+
+        for (GLuint k = 0; k < _padded_length; ++k)
+            padded_values[k] *= _filter_spectrum[k];
+
+        _Radix2(padded_values.data(), GL_TRUE);
+
+        GLdouble scale = 1.0 / _padded_length;
+        for (GLuint k = 0; k < _length; ++k)
+        {
+            Complex value = padded_values[k] * _chirp[k] * scale;
+            values[k] = inverse ? conj(value) : value;
+        }
+    }
+
+    if (inverse)
+    {
+        GLdouble scale = 1.0 / _length;
+        for (GLuint k = 0; k < _length; ++k)
+            values[k] *= scale;
+    }
+
+    return GL_TRUE;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <complex>
+#include <vector>
+
+namespace cagd
+{
+    //---------------------------
+    // class FastFourierTransform
+    //---------------------------
+    // discrete Fourier transform of a fixed length n in O(n log n) operations
+    //
+    // Power of two lengths are transformed by the iterative radix-2 algorithm, every other length is reduced
+    // by Bluestein's chirp-z algorithm to a cyclic convolution of power of two length. The twiddle factors,
+    // the chirp and the spectrum of the convolution filter are calculated only once, in the constructor;
+    // Transform is constant and can be called by several threads simultaneously.
+    class FastFourierTransform
+    {
+    public:
+        typedef std::complex<GLdouble> Complex;
+
+    protected:
+        GLuint               _length;           // n
+        GLuint               _padded_length;    // power of two length of the radix-2 transforms
+        std::vector<GLuint>  _bit_reversal;     // permutation of the radix-2 transforms
+        std::vector<Complex> _twiddle_factors;  // exp(-2 pi i k / _padded_length), k < _padded_length / 2
+        std::vector<Complex> _chirp;            // exp(-pi i k^2 / n), k < n, empty for power of two lengths
+        std::vector<Complex> _filter_spectrum;  // radix-2 transform of the conjugate chirp
+
+        // in-place radix-2 transform of _padded_length values, the inverse is not normalized
+        GLvoid _Radix2(Complex *values, GLboolean inverse) const;
+
+    public:
+        // special/default constructor
+        FastFourierTransform(GLuint length = 0);
+
+        GLuint GetLength() const;
+
+        // X_k = sum_{j=0}^{n-1} x_j exp(-2 pi i j k / n) if inverse == GL_FALSE,
+        // x_j = 1/n sum_{k=0}^{n-1} X_k exp(2 pi i j k / n) otherwise;
+        // fails if the size of values differs from the length of the transform
+        GLboolean Transform(std::vector<Complex>& values, GLboolean inverse = GL_FALSE) const;
+    };
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <GL/glew.h>
+
+namespace cagd
+{
+    //---------------------------
+    // template class FixedMatrix
+    //---------------------------
+    // matrix with compile-time dimensions; its elements are stored inline in row-major order,
+    // therefore it never allocates and loops over its dimensions can be fully unrolled
+    template <typename T, GLuint R, GLuint C>
+    class FixedMatrix
+    {
+    protected:
+        T _data[R * C];
+
+    public:
+        // default constructor, every element is value-initialized
+        FixedMatrix();
+
+        // get element by reference
+        T& operator ()(GLuint row, GLuint column);
+
+        // get element by constant reference
+        const T& operator ()(GLuint row, GLuint column) const;
+
+        // row-major linear indexing, mainly used for 1 x C and R x 1 matrices
+        T& operator [](GLuint index);
+        const T& operator [](GLuint index) const;
+
+        // get dimensions
+        static constexpr GLuint GetRowCount();
+        static constexpr GLuint GetColumnCount();
+
+        // inline row-major storage
+        T*       GetData();
+        const T* GetData() const;
+
+        // sets every element to the given value
+        GLvoid Fill(const T& value);
+    };
+
+    //---------------------------------------------
+    // implementation of template class FixedMatrix
+    //---------------------------------------------
+    template <typename T, GLuint R, GLuint C>
+    inline FixedMatrix<T, R, C>::FixedMatrix(): _data()
+    {
+    }
+
+    template <typename T, GLuint R, GLuint C>
+    inline T& FixedMatrix<T, R, C>::operator ()(GLuint row, GLuint column)
+    {
+        return _data[row * C + column];
+    }
+
+    template <typename T, GLuint R, GLuint C>
+    inline const T& FixedMatrix<T, R, C>::operator ()(GLuint row, GLuint column) const
+    {
+        return _data[row * C + column];
+    }
+
+    template <typename T, GLuint R, GLuint C>
+    inline T& FixedMatrix<T, R, C>::operator [](GLuint index)
+    {
+        return _data[index];
+    }
+
+    template <typename T, GLuint R, GLuint C>
+    inline const T& FixedMatrix<T, R, C>::operator [](GLuint index) const
+    {
+        return _data[index];
+    }
+
+    template <typename T, GLuint R, GLuint C>
+    constexpr GLuint FixedMatrix<T, R, C>::GetRowCount()
+    {
+        return R;
+    }
+
+    template <typename T, GLuint R, GLuint C>
+    constexpr GLuint FixedMatrix<T, R, C>::GetColumnCount()
+    {
+        return C;
+    }
+
+    template <typename T, GLuint R, GLuint C>
+    inline T* FixedMatrix<T, R, C>::GetData()
+    {
+        return _data;
+    }
+
+    template <typename T, GLuint R, GLuint C>
+    inline const T* FixedMatrix<T, R, C>::GetData() const
+    {
+        return _data;
+    }
+
+    template <typename T, GLuint R, GLuint C>
+    inline GLvoid FixedMatrix<T, R, C>::Fill(const T& value)
+    {
+        for (GLuint i = 0; i < R * C; ++i)
+            _data[i] = value;
+    }
+}
@@ -1,4 +1,7 @@
 #include "GenericCurves3.h"
+#include "DCoordinate3Arrays.h"
+#include <algorithm>
+#include <vector>
 
 using namespace cagd;
 using namespace std;
@@ -27,7 +30,8 @@ GenericCurve3::GenericCurve3(const Matrix<DCoordinate3>& derivative, GLenum usag
 GenericCurve3::GenericCurve3(const GenericCurve3& curve):
         _usage_flag(curve._usage_flag),
         _vbo_derivative(RowMatrix<GLuint>(curve._vbo_derivative.GetColumnCount())),
-        _derivative(curve._derivative)
+        _derivative(curve._derivative),
+        _parameters(curve._parameters)
 {
     GLboolean vbo_update_is_possible = GL_TRUE;
     for (GLuint i = 0; i < curve._vbo_derivative.GetColumnCount(); ++i)
@@ -46,6 +50,7 @@ GenericCurve3& GenericCurve3::operator =(const GenericCurve3& rhs)
 
         _usage_flag = rhs._usage_flag;
         _derivative = rhs._derivative;
+        _parameters = rhs._parameters;
 
         GLboolean vbo_update_is_possible = GL_TRUE;
         for (GLuint i = 0; i < rhs._vbo_derivative.GetColumnCount(); ++i)
@@ -57,6 +62,30 @@ GenericCurve3& GenericCurve3::operator =(const GenericCurve3& rhs)
     return *this;
 }
 
+// move constructor
+GenericCurve3::GenericCurve3(GenericCurve3&& curve) noexcept:
+        _usage_flag(curve._usage_flag),
+        _vbo_derivative(std::move(curve._vbo_derivative)),
+        _derivative(std::move(curve._derivative)),
+        _parameters(std::move(curve._parameters))
+{
+}
+
+// move assignment operator
+GenericCurve3& GenericCurve3::operator =(GenericCurve3&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        DeleteVertexBufferObjects();
+
+        _usage_flag = rhs._usage_flag;
+        _vbo_derivative = std::move(rhs._vbo_derivative);
+        _derivative = std::move(rhs._derivative);
+        _parameters = std::move(rhs._parameters);
+    }
+    return *this;
+}
+
 // vertex buffer object handling methods
 GLvoid GenericCurve3::DeleteVertexBufferObjects()
 {
@@ -159,14 +188,10 @@ GLboolean GenericCurve3::UpdateVertexBufferObjects(GLdouble scale,GLenum usage_f
         return GL_FALSE;
     }
 
-    for (GLuint i = 0; i < curve_point_count; ++i)
-    {
-        for (GLuint j = 0; j < 3; ++j)
-        {
-            *coordinate = (GLfloat)_derivative(0,i)[j];
-            ++coordinate;
-        }
-    }
+    // the curve points form a contiguous row of the derivative matrix
+    const DCoordinate3 *point = _derivative.Row(0).GetFirst();
+
+    DCoordinate3Array::PackToFloats(point, curve_point_count, coordinate);
 
     if (!glUnmapBuffer(GL_ARRAY_BUFFER))
     {
@@ -175,7 +200,7 @@ GLboolean GenericCurve3::UpdateVertexBufferObjects(GLdouble scale,GLenum usage_f
         return GL_FALSE;
     }
 
-    // higher order derivatives
+    // higher order derivatives, rendered as the segments [point, point + scale * derivative]
     GLuint higher_order_derivative_byte_size = 2 * curve_point_byte_size;
 
     for (GLuint d = 1; d < _derivative.GetRowCount(); ++d)
@@ -192,20 +217,8 @@ GLboolean GenericCurve3::UpdateVertexBufferObjects(GLdouble scale,GLenum usage_f
             return GL_FALSE;
         }
 
-        for (GLuint i = 0; i < curve_point_count; ++i)
-        {
-            DCoordinate3 sum = _derivative(0, i);
-            sum += scale*_derivative(d, i);
-
-            for (GLint j = 0; j < 3; ++j)
-            {
-                *coordinate = (GLfloat)_derivative(0, i)[j];
-                *(coordinate + 3) = (GLfloat)sum[j];
-                ++coordinate;
-            }
-
-            coordinate += 3;
-        }
+        DCoordinate3Array::PackSegmentsToFloats(point, _derivative.Row(d).GetFirst(), scale,
+                                                curve_point_count, coordinate);
 
         if (!glUnmapBuffer(GL_ARRAY_BUFFER))
         {
@@ -220,6 +233,46 @@ GLboolean GenericCurve3::UpdateVertexBufferObjects(GLdouble scale,GLenum usage_f
     return GL_TRUE;
 }
 
+GLboolean GenericCurve3::UpdateVertexBufferObjectsOfRange(GLuint first_index, GLuint last_index, GLdouble scale)
+{
+    GLuint curve_point_count = _derivative.GetColumnCount();
+
+    if (first_index > last_index || last_index >= curve_point_count)
+        return GL_FALSE;
+
+    for (GLuint d = 0; d < _vbo_derivative.GetColumnCount(); ++d)
+        if (!_vbo_derivative(d))
+            return GL_FALSE;
+
+    GLuint count = last_index - first_index + 1;
+
+    vector<GLfloat> coordinates(6 * count);
+
+    // curve points
+    const DCoordinate3 *point = _derivative.Row(0).GetFirst() + first_index;
+
+    DCoordinate3Array::PackToFloats(point, count, coordinates.data());
+
+    glBindBuffer(GL_ARRAY_BUFFER, _vbo_derivative(0));
+    glBufferSubData(GL_ARRAY_BUFFER, 3 * first_index * sizeof(GLfloat), 3 * count * sizeof(GLfloat),
+                    coordinates.data());
+
+    // higher order derivatives, the segment of a point occupies 6 floats
+    for (GLuint d = 1; d < _derivative.GetRowCount(); ++d)
+    {
+        DCoordinate3Array::PackSegmentsToFloats(point, _derivative.Row(d).GetFirst() + first_index, scale,
+                                                count, coordinates.data());
+
+        glBindBuffer(GL_ARRAY_BUFFER, _vbo_derivative(d));
+        glBufferSubData(GL_ARRAY_BUFFER, 6 * first_index * sizeof(GLfloat), 6 * count * sizeof(GLfloat),
+                        coordinates.data());
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return GL_TRUE;
+}
+
 GLfloat* GenericCurve3::MapDerivatives(GLuint order, GLenum access_mode) const
 {
     if (order >= _derivative.GetRowCount())
@@ -315,6 +368,46 @@ GLenum GenericCurve3::GetUsageFlag() const
     return _usage_flag;
 }
 
+GLboolean GenericCurve3::SetParameters(const vector<GLdouble>& parameters)
+{
+    if (parameters.size() != _derivative.GetColumnCount())
+        return GL_FALSE;
+
+    _parameters = parameters;
+
+    return GL_TRUE;
+}
+
+const vector<GLdouble>& GenericCurve3::GetParameters() const
+{
+    return _parameters;
+}
+
+// arc-length parametrization of the polyline
+GLboolean GenericCurve3::BuildArcLengthTable(ArcLengthTable& table) const
+{
+    return table.BuildChordal(_derivative.Row(0).GetFirst(), _derivative.GetColumnCount());
+}
+
+GLboolean GenericCurve3::GetDerivativesAtArcLength(const ArcLengthTable& table, GLdouble s, ColumnMatrix<DCoordinate3>& d) const
+{
+    GLuint point_count = _derivative.GetColumnCount();
+
+    if (point_count < 2 || table.GetSegmentCount() != point_count - 1)
+        return GL_FALSE;
+
+    GLdouble u = table.ParameterAt(s);
+    GLuint   i = min((GLuint)u, point_count - 2);
+    GLdouble t = u - i;
+
+    d.ResizeRows(_derivative.GetRowCount());
+
+    for (GLuint order = 0; order < _derivative.GetRowCount(); ++order)
+        d[order] = _derivative(order, i) * (1.0 - t) + _derivative(order, i + 1) * t;
+
+    return GL_TRUE;
+}
+
 // destructor
 GenericCurve3::~GenericCurve3()
 {
@@ -332,6 +425,7 @@ ostream& cagd::operator <<(ostream& lhs, const GenericCurve3& rhs)
 std::istream& cagd::operator >>(std::istream& lhs, GenericCurve3& rhs)
 {
     rhs.DeleteVertexBufferObjects();
+    rhs._parameters.clear();
 
     return lhs >> rhs._usage_flag >> rhs._derivative;
 }
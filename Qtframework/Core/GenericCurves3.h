@@ -1,9 +1,11 @@
 #pragma once
 
+#include "ArcLengthTables.h"
 #include "DCoordinates3.h"
 #include <GL/glew.h>
 #include "Matrices.h"
 #include <iostream>
+#include <vector>
 
 namespace cagd
 {
@@ -24,6 +26,7 @@ namespace cagd
         GLenum               _usage_flag;
         RowMatrix<GLuint>    _vbo_derivative;
         Matrix<DCoordinate3> _derivative;
+        std::vector<GLdouble> _parameters;      // parameter values of the points, empty if they are unknown
 
     public:
         // default and special constructor
@@ -41,11 +44,22 @@ namespace cagd
         // assignment operator
         GenericCurve3& operator =(const GenericCurve3& rhs);
 
+        // move constructor: takes over the vertex buffer objects instead of re-uploading them
+        GenericCurve3(GenericCurve3&& curve) noexcept;
+
+        // move assignment operator
+        GenericCurve3& operator =(GenericCurve3&& rhs) noexcept;
+
         // vertex buffer object handling methods
         GLvoid DeleteVertexBufferObjects();
         GLboolean RenderDerivatives(GLuint order, GLenum render_mode) const;
         GLboolean UpdateVertexBufferObjects(GLdouble scale=1.0,GLenum usage_flag = GL_STATIC_DRAW);
 
+        // overwrites the floats of the points first_index,...,last_index in the existing vertex buffer objects by
+        // glBufferSubData, i.e., without reallocating them; scale has to coincide with the one of the last call of
+        // UpdateVertexBufferObjects, fails if the vertex buffer objects do not exist or the range is invalid
+        GLboolean UpdateVertexBufferObjectsOfRange(GLuint first_index, GLuint last_index, GLdouble scale = 1.0);
+
         GLfloat* MapDerivatives(GLuint order, GLenum access_mode = GL_READ_ONLY) const;
         GLboolean UnmapDerivatives(GLuint order) const;
 
@@ -65,6 +79,20 @@ namespace cagd
         GLuint GetPointCount() const;
         GLenum GetUsageFlag() const;
 
+        // parameter values of the points, they are recorded by LinearCombination3::GenerateImage and by
+        // AdaptiveCurveSampler::GenerateImage, otherwise (and after reading the image from a stream) they are
+        // unknown, i.e., empty; the setter fails if the number of the values differs from the point count
+        GLboolean SetParameters(const std::vector<GLdouble>& parameters);
+        const std::vector<GLdouble>& GetParameters() const;
+
+        // arc-length parametrization of the polyline of the points, the parameter of the i-th point is i (see
+        // ArcLengthTable::BuildChordal); fails if there are less than 2 points
+        GLboolean BuildArcLengthTable(ArcLengthTable& table) const;
+
+        // d[r] becomes the derivative of order r, that is linearly interpolated between the two points of the
+        // polyline that enclose the arc length s, where the table has to be built by BuildArcLengthTable
+        GLboolean GetDerivativesAtArcLength(const ArcLengthTable& table, GLdouble s, ColumnMatrix<DCoordinate3>& d) const;
+
         // destructor
         virtual ~GenericCurve3();
     };
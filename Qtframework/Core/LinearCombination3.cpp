@@ -1,5 +1,12 @@
 #include "LinearCombination3.h"
 #include "RealSquareMatrices.h"
+#include "RealRectangularMatrices.h"
+#include "FactorizationCaches.h"
+#include "BasisTableCaches.h"
+#include "AdaptiveCurveSamplers.h"
+#include <algorithm>
+#include <memory>
+#include <typeinfo>
 
 using namespace cagd;
 using namespace std;
@@ -24,13 +31,28 @@ LinearCombination3::Derivatives& LinearCombination3::Derivatives::operator =(con
     return *this;
 }
 
+// move constructor
+LinearCombination3::Derivatives::Derivatives(LinearCombination3::Derivatives&& d) noexcept: ColumnMatrix<DCoordinate3>(std::move(d))
+{
+}
+
+// move assignment operator
+LinearCombination3::Derivatives& LinearCombination3::Derivatives::operator =(LinearCombination3::Derivatives&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        ColumnMatrix<DCoordinate3>::operator =(std::move(rhs));
+    }
+    return *this;
+}
+
 // set every derivative to null vector
 GLvoid LinearCombination3::Derivatives::LoadNullVectors()
 {
     for (GLuint i = 0; i < _data.size(); ++i)
     {
         for (GLuint j = 0; j < 3; ++j)
-            _data[i][0][j] = 0.0;
+            _data[i][j] = 0.0;
     }
 }
 
@@ -73,6 +95,35 @@ LinearCombination3& LinearCombination3::operator =(const LinearCombination3& rhs
     return *this;
 }
 
+// move constructor
+LinearCombination3::LinearCombination3(LinearCombination3&& lc) noexcept:
+        _vbo_data(lc._vbo_data),
+        _data_usage_flag(lc._data_usage_flag),
+        _u_min(lc._u_min), _u_max(lc._u_max),
+        _data(std::move(lc._data))
+{
+    lc._vbo_data = 0;
+}
+
+// move assignment operator
+LinearCombination3& LinearCombination3::operator =(LinearCombination3&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        DeleteVertexBufferObjectsOfData();
+
+        _vbo_data = rhs._vbo_data;
+        _data_usage_flag = rhs._data_usage_flag;
+        _u_min = rhs._u_min;
+        _u_max = rhs._u_max;
+        _data = std::move(rhs._data);
+
+        rhs._vbo_data = 0;
+    }
+
+    return *this;
+}
+
 // vbo handling methods
 GLvoid LinearCombination3::DeleteVertexBufferObjectsOfData()
 {
@@ -153,6 +204,20 @@ GLboolean LinearCombination3::UpdateVertexBufferObjectsOfData(GLenum usage_flag)
     return GL_TRUE;
 }
 
+GLboolean LinearCombination3::UpdateVertexBufferObjectsOfDataPoint(GLuint index)
+{
+    if (!_vbo_data || index >= _data.GetRowCount())
+        return GL_FALSE;
+
+    GLfloat coordinate[3] = {(GLfloat)_data[index][0], (GLfloat)_data[index][1], (GLfloat)_data[index][2]};
+
+    glBindBuffer(GL_ARRAY_BUFFER, _vbo_data);
+    glBufferSubData(GL_ARRAY_BUFFER, 3 * index * sizeof(GLfloat), 3 * sizeof(GLfloat), coordinate);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return GL_TRUE;
+}
+
 // get data by value
 DCoordinate3 LinearCombination3::operator [](GLuint index) const
 {
@@ -167,6 +232,13 @@ DCoordinate3& LinearCombination3::operator [](GLuint index)
 
 
 
+// the collocation matrix is not cached by default
+GLboolean LinearCombination3::CollocationShapeParameters(vector<GLdouble>& shape_parameters) const
+{
+    shape_parameters.clear();
+    return GL_FALSE;
+}
+
 // assure interpolation
 GLboolean LinearCombination3::UpdateDataForInterpolation(const ColumnMatrix<GLdouble>& knot_vector, const ColumnMatrix<DCoordinate3>& data_points_to_interpolate)
 {
@@ -176,18 +248,60 @@ GLboolean LinearCombination3::UpdateDataForInterpolation(const ColumnMatrix<GLdo
         data_count != data_points_to_interpolate.GetRowCount())
         return GL_FALSE;
 
-    RealSquareMatrix collocation_matrix(data_count);
+    vector<GLdouble> shape_parameters;
+    GLboolean        cacheable = CollocationShapeParameters(shape_parameters);
+
+    FactorizationCache &cache = FactorizationCache::Instance();
+    FactorizationCache::Key key(typeid(*this), shape_parameters, knot_vector);
+
+    shared_ptr<RealSquareMatrix> collocation_matrix;
+
+    if (cacheable)
+        collocation_matrix = cache.Find(key);
+
+    if (!collocation_matrix)
+    {
+        collocation_matrix = make_shared<RealSquareMatrix>(data_count);
+
+        RowMatrix<GLdouble> current_blending_function_values(data_count);
+        for (GLuint r = 0; r < knot_vector.GetRowCount(); ++r)
+        {
+            if (!BlendingFunctionValues(knot_vector(r), current_blending_function_values))
+                return GL_FALSE;
+            else
+                collocation_matrix->SetRow(r, current_blending_function_values);
+        }
+
+        if (!collocation_matrix->PerformLUDecomposition())
+            return GL_FALSE;
+
+        if (cacheable)
+            cache.Insert(key, collocation_matrix);
+    }
+
+    return collocation_matrix->SolveLinearSystem(data_points_to_interpolate, _data);
+}
+
+GLboolean LinearCombination3::UpdateDataForLeastSquaresFitting(const ColumnMatrix<GLdouble>& parameter_values, const ColumnMatrix<DCoordinate3>& sample_points)
+{
+    GLuint data_count   = _data.GetRowCount();
+    GLuint sample_count = parameter_values.GetRowCount();
+
+    if (sample_count < data_count || sample_points.GetRowCount() != sample_count)
+        return GL_FALSE;
+
+    RealRectangularMatrix collocation_matrix(sample_count, data_count);
 
     RowMatrix<GLdouble> current_blending_function_values(data_count);
-    for (GLuint r = 0; r < knot_vector.GetRowCount(); ++r)
+    for (GLuint r = 0; r < sample_count; ++r)
     {
-        if (!BlendingFunctionValues(knot_vector(r), current_blending_function_values))
+        if (!BlendingFunctionValues(parameter_values(r), current_blending_function_values))
             return GL_FALSE;
         else
             collocation_matrix.SetRow(r, current_blending_function_values);
     }
 
-    return collocation_matrix.SolveLinearSystem(data_points_to_interpolate, _data);
+    return collocation_matrix.SolveLeastSquares(sample_points, _data);
 }
 
 
@@ -204,50 +318,339 @@ GLvoid LinearCombination3::GetDefinitionDomain(GLdouble& u_min, GLdouble& u_max)
     u_max=_u_max;
 }
 
+// by default the blending function derivatives are not available
+GLboolean LinearCombination3::BlendingFunctionDerivatives(GLuint, GLdouble, Matrix<GLdouble>&) const
+{
+    return GL_FALSE;
+}
+
+// evaluates the samples one by one
+GLboolean LinearCombination3::CalculateDerivativesBatch(
+        GLuint max_order_of_derivatives, const GLdouble *u, GLuint count, Matrix<DCoordinate3>& derivatives) const
+{
+    if (derivatives.GetRowCount() <= max_order_of_derivatives || derivatives.GetColumnCount() < count)
+        return GL_FALSE;
+
+    Derivatives d(max_order_of_derivatives);
+
+    for (GLuint k = 0; k < count; ++k)
+    {
+        if (!CalculateDerivatives(max_order_of_derivatives, u[k], d))
+            return GL_FALSE;
+
+        for (GLuint order = 0; order <= max_order_of_derivatives; ++order)
+            derivatives(order, k) = d[order];
+    }
+
+    return GL_TRUE;
+}
+
+// uniform subdivision points of the definition domain, the last one is exactly _u_max
+GLvoid LinearCombination3::_UniformParameters(GLuint div_point_count, vector<GLdouble>& u) const
+{
+    u.resize(div_point_count);
+
+    GLdouble u_step = (_u_max - _u_min) / (div_point_count - 1);
+
+    for (GLuint i = 0; i < div_point_count - 1; ++i)
+        u[i] = min(_u_min + i * u_step, _u_max);
+    u[div_point_count - 1] = _u_max;
+}
+
+// looks up the basis table of the uniform sample grid, or tabulates and stores it on a miss
+shared_ptr<const Matrix<GLdouble>> LinearCombination3::_BasisTable(
+        GLuint max_order_of_derivatives, GLuint div_point_count) const
+{
+    vector<GLdouble> shape_parameters;
+
+    if (div_point_count <= 1 || !CollocationShapeParameters(shape_parameters))
+        return shared_ptr<const Matrix<GLdouble>>();
+
+    GLuint data_count = _data.GetRowCount();
+
+    BasisTableCache &cache = BasisTableCache::Instance();
+
+    // tables that would not fit into the cache are not worth building
+    size_t table_size = (size_t)(max_order_of_derivatives + 1) * div_point_count * data_count * sizeof(GLdouble);
+
+    if (table_size > min(BasisTableCache::MAXIMUM_TABLE_SIZE, cache.GetCapacity()))
+        return shared_ptr<const Matrix<GLdouble>>();
+
+    BasisTableCache::Key key(typeid(*this), shape_parameters, _u_min, _u_max,
+                             div_point_count, max_order_of_derivatives);
+
+    shared_ptr<const Matrix<GLdouble>> table = cache.Find(key);
+
+    if (table)
+        return table;
+
+    vector<GLdouble> u;
+    _UniformParameters(div_point_count, u);
+
+    shared_ptr<Matrix<GLdouble>> new_table =
+            make_shared<Matrix<GLdouble>>((max_order_of_derivatives + 1) * div_point_count, data_count);
+
+    Matrix<GLdouble> derivatives;
+
+    for (GLuint k = 0; k < div_point_count; ++k)
+    {
+        if (!BlendingFunctionDerivatives(max_order_of_derivatives, u[k], derivatives) ||
+            derivatives.GetRowCount() <= max_order_of_derivatives ||
+            derivatives.GetColumnCount() != data_count)
+            return shared_ptr<const Matrix<GLdouble>>();
+
+        for (GLuint order = 0; order <= max_order_of_derivatives; ++order)
+            for (GLuint i = 0; i < data_count; ++i)
+                (*new_table)(order * div_point_count + k, i) = derivatives(order, i);
+    }
+
+    cache.Insert(key, new_table);
+
+    return new_table;
+}
+
 // generate image/arc
 GenericCurve3* LinearCombination3::GenerateImage(GLuint max_order_of_derivatives, GLuint div_point_count, GLenum usage_flag) const
 {
-  GenericCurve3* result = nullptr;
-  Derivatives _derivatives(max_order_of_derivatives+1);
-
-  result = new GenericCurve3(max_order_of_derivatives, div_point_count, usage_flag);
-
-  if (!result)
-      {
-      return nullptr;
-      }  
-  // set derivatives at the endpoints of the parametric curve
-  for (GLuint order = 0; order < max_order_of_derivatives+1; ++order)
-  {
-      if(!CalculateDerivatives(max_order_of_derivatives,_u_min,_derivatives)){
-          delete result;
-          return nullptr;
-      }      
-      (*result)(order, 0) = _derivatives[order];
-      if(! CalculateDerivatives(max_order_of_derivatives,_u_max,_derivatives)){
-          delete result;
-          return nullptr;
-      }      
-      (*result)(order, div_point_count - 1) = _derivatives[order];      
-  }  
-  // calculate derivatives at inner curve points
-  GLdouble u_step = (_u_max - _u_min) / (div_point_count - 1);
-  GLdouble u = _u_min;
-
-  for (GLuint i = 1; i < div_point_count - 1; i++)
-  {
-      u += u_step;
-
-      for (GLuint order = 0; order < max_order_of_derivatives+1; ++order)
-      {
-          if(! CalculateDerivatives(max_order_of_derivatives,u,_derivatives)){
+    if (div_point_count <= 1)
+        return nullptr;
+
+    GenericCurve3 *result = new GenericCurve3(max_order_of_derivatives, div_point_count, usage_flag);
+
+    // the parameter values of the samples identify the image as a uniform one (see UpdateImageForDataChange)
+    _UniformParameters(div_point_count, result->_parameters);
+
+    // the image is linear in the control points, i.e., if the blending functions are determined by the dynamic
+    // type and the shape parameters of the curve, the rows of the derivative storage of the image are given by
+    // the product of the cached basis table and of the control points
+    shared_ptr<const Matrix<GLdouble>> table = _BasisTable(max_order_of_derivatives, div_point_count);
+
+    if (table)
+    {
+        GLuint data_count = _data.GetRowCount();
+
+        // the derivative storage of the image is a row-major (max_order_of_derivatives + 1) x div_point_count
+        // matrix, i.e., it coincides with the column of (max_order_of_derivatives + 1) * div_point_count
+        // Descartes coordinates; since the product has only 3 columns of doubles, it is evaluated row by
+        // row, as the blocked GEMM kernel would not fill its vectors
+        const GLdouble *rows  = table->GetData();
+        const GLdouble *point = reinterpret_cast<const GLdouble*>(_data.GetData());
+        DCoordinate3   *d     = result->_derivative.GetData();
+
+        GLint     row_count    = (GLint)table->GetRowCount();
+        GLint     thread_count = (GLint)RealSquareMatrix::GetThreadCount();
+        GLboolean parallel     = (thread_count > 1 && row_count >= (GLint)PARALLEL_TABLE_ROW_THRESHOLD);
+        (void)parallel;
+
+        // the rows are independent, hence the result does not depend on the number of threads
+        #pragma omp parallel for num_threads(thread_count) schedule(static) if(parallel)
+        for (GLint k = 0; k < row_count; ++k)
+        {
+            const GLdouble *row = rows + k * data_count;
+
+            GLdouble x = 0.0, y = 0.0, z = 0.0;
+
+            for (GLuint i = 0; i < data_count; ++i)
+            {
+                x += row[i] * point[3 * i];
+                y += row[i] * point[3 * i + 1];
+                z += row[i] * point[3 * i + 2];
+            }
+
+            d[k] = DCoordinate3(x, y, z);
+        }
+
+        return result;
+    }
+
+    // every sample is evaluated exactly once; the samples are split into chunks of SAMPLE_CHUNK_SIZE
+    // consecutive parameter values regardless of the number of threads, thus batch kernels that share work
+    // among the samples of a chunk produce the same bits in serial and in parallel runs
+    const vector<GLdouble> &u = result->_parameters;
+
+    if (div_point_count <= SAMPLE_CHUNK_SIZE)
+    {
+        if (!CalculateDerivativesBatch(max_order_of_derivatives, u.data(), div_point_count, result->_derivative))
+        {
             delete result;
             return nullptr;
-          }
-          (*result)(order, i) = _derivatives[order];
-      }
-  }  
-  return result;
+        }
+
+        return result;
+    }
+
+    GLint             chunk_count  = (GLint)((div_point_count + SAMPLE_CHUNK_SIZE - 1) / SAMPLE_CHUNK_SIZE);
+    GLint             thread_count = (GLint)RealSquareMatrix::GetThreadCount();
+    vector<GLboolean> succeeded(chunk_count, GL_FALSE);
+    (void)thread_count;
+
+    #pragma omp parallel for num_threads(thread_count) schedule(dynamic) if(thread_count > 1)
+    for (GLint c = 0; c < chunk_count; ++c)
+    {
+        GLuint first = c * SAMPLE_CHUNK_SIZE;
+        GLuint count = min((GLuint)SAMPLE_CHUNK_SIZE, div_point_count - first);
+
+        Matrix<DCoordinate3> chunk(max_order_of_derivatives + 1, count);
+
+        if (CalculateDerivativesBatch(max_order_of_derivatives, u.data() + first, count, chunk))
+        {
+            for (GLuint order = 0; order <= max_order_of_derivatives; ++order)
+                for (GLuint k = 0; k < count; ++k)
+                    result->_derivative(order, first + k) = chunk(order, k);
+
+            succeeded[c] = GL_TRUE;
+        }
+    }
+
+    for (GLint c = 0; c < chunk_count; ++c)
+    {
+        if (!succeeded[c])
+        {
+            delete result;
+            return nullptr;
+        }
+    }
+
+    return result;
+}
+
+// generates the images of several curves, the curves are distributed among the threads
+GLboolean LinearCombination3::GenerateImages(
+        const vector<const LinearCombination3*>& curves,
+        GLuint max_order_of_derivatives, GLuint div_point_count,
+        vector<GenericCurve3*>& images, GLenum usage_flag)
+{
+    GLint curve_count  = (GLint)curves.size();
+    GLint thread_count = (GLint)RealSquareMatrix::GetThreadCount();
+    (void)thread_count;
+
+    images.assign(curves.size(), nullptr);
+
+    // the image of a curve is independent of the thread that generates it; the nested parallel regions of
+    // GenerateImage are executed by the calling thread, unless nested parallelism is enabled
+    #pragma omp parallel for num_threads(thread_count) schedule(dynamic) if(thread_count > 1 && curve_count > 1)
+    for (GLint i = 0; i < curve_count; ++i)
+    {
+        if (curves[i])
+            images[i] = curves[i]->GenerateImage(max_order_of_derivatives, div_point_count, usage_flag);
+    }
+
+    for (GLint i = 0; i < curve_count; ++i)
+        if (!images[i])
+            return GL_FALSE;
+
+    return GL_TRUE;
+}
+
+// generate curvature-adaptive image/arc
+GenericCurve3* LinearCombination3::GenerateAdaptiveImage(
+        GLuint max_order_of_derivatives, GLdouble tolerance, GLenum usage_flag) const
+{
+    AdaptiveCurveSampler sampler;
+
+    if (!sampler.SetTolerance(tolerance))
+        return nullptr;
+
+    Derivatives d;
+
+    AdaptiveCurveSampler::Evaluator evaluator =
+            [this, &d](GLuint max_order, GLdouble u, DCoordinate3 *derivatives) -> GLboolean
+    {
+        if (!CalculateDerivatives(max_order, u, d))
+            return GL_FALSE;
+
+        for (GLuint order = 0; order <= max_order; ++order)
+            derivatives[order] = d[order];
+
+        return GL_TRUE;
+    };
+
+    return sampler.GenerateImage(evaluator, max(max_order_of_derivatives, 2u), max_order_of_derivatives,
+                                 _u_min, _u_max, usage_flag);
+}
+
+// arc-length parametrization
+GLboolean LinearCombination3::BuildArcLengthTable(ArcLengthTable& table, GLuint segment_count) const
+{
+    ArcLengthTable::Evaluator evaluator =
+            [this](GLuint max_order, GLdouble u, DCoordinate3 *derivatives) -> GLboolean
+    {
+        Derivatives d(max_order);
+
+        if (!CalculateDerivatives(max_order, u, d))
+            return GL_FALSE;
+
+        for (GLuint order = 0; order <= max_order; ++order)
+            derivatives[order] = d[order];
+
+        return GL_TRUE;
+    };
+
+    return table.Build(evaluator, _u_min, _u_max, segment_count);
+}
+
+GLboolean LinearCombination3::CalculateDerivativesAtArcLength(
+        const ArcLengthTable& table, GLuint max_order_of_derivatives,
+        GLdouble s, Derivatives& d, GLuint newton_iterations) const
+{
+    if (table.IsEmpty())
+        return GL_FALSE;
+
+    return CalculateDerivatives(max_order_of_derivatives, table.ParameterAt(s, newton_iterations), d);
+}
+
+// image(r, k) += delta F_index^(r)(u_k), by means of the cached basis table
+GLboolean LinearCombination3::UpdateImageForDataChange(
+        GLuint index, const DCoordinate3& delta, GenericCurve3& image, GLuint& first_index, GLuint& last_index) const
+{
+    GLuint data_count = _data.GetRowCount();
+
+    if (index >= data_count)
+        return GL_FALSE;
+
+    GLuint max_order_of_derivatives = image.GetMaximumOrderOfDerivatives();
+    GLuint div_point_count          = image.GetPointCount();
+
+    // the rows of the basis table belong to the uniform sample grid, while the points of adaptive images (or
+    // of images of unknown origin) are located at other parameter values
+    vector<GLdouble> u;
+    _UniformParameters(div_point_count, u);
+
+    if (image.GetParameters() != u)
+        return GL_FALSE;
+
+    shared_ptr<const Matrix<GLdouble>> table = _BasisTable(max_order_of_derivatives, div_point_count);
+
+    if (!table)
+        return GL_FALSE;
+
+    // the range of the samples at which a derivative of the blending function F_index does not vanish, it is
+    // empty (first_index > last_index) until the first such sample is found
+    first_index = 1;
+    last_index  = 0;
+
+    for (GLuint order = 0; order <= max_order_of_derivatives; ++order)
+    {
+        for (GLuint k = 0; k < div_point_count; ++k)
+        {
+            GLdouble weight = (*table)(order * div_point_count + k, index);
+
+            if (weight != 0.0)
+            {
+                image._derivative(order, k) += weight * delta;
+
+                if (first_index > last_index)
+                    first_index = last_index = k;
+                else
+                {
+                    first_index = min(first_index, k);
+                    last_index  = max(last_index, k);
+                }
+            }
+        }
+    }
+
+    return GL_TRUE;
 }
 
 // destructor
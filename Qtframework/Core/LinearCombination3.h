@@ -1,8 +1,11 @@
 #pragma once
 
+#include "ArcLengthTables.h"
 #include "DCoordinates3.h"
 #include "GenericCurves3.h"
 #include "Matrices.h"
+#include <memory>
+#include <vector>
 
 namespace cagd
 {
@@ -24,6 +27,10 @@ namespace cagd
             // assignment operator
             Derivatives& operator =(const Derivatives& rhs);
 
+            // move constructor and move assignment operator
+            Derivatives(Derivatives&& d) noexcept;
+            Derivatives& operator =(Derivatives&& rhs) noexcept;
+
             // all inherited Descartes coordinates are set to the null vector
             GLvoid LoadNullVectors();
         };
@@ -34,6 +41,20 @@ namespace cagd
         GLdouble                    _u_min, _u_max;
         ColumnMatrix<DCoordinate3>  _data;
 
+        // GenerateImage evaluates the samples by chunks of this size, that are distributed among the threads
+        static const GLuint SAMPLE_CHUNK_SIZE = 256;
+
+        // basis table products of fewer rows are always evaluated by a single thread
+        static const GLuint PARALLEL_TABLE_ROW_THRESHOLD = 4096;
+
+        // uniform subdivision points of the definition domain, the last one is exactly _u_max
+        GLvoid _UniformParameters(GLuint div_point_count, std::vector<GLdouble>& u) const;
+
+        // the basis table of the uniform sample grid (see BasisTableCache), or a null pointer if the curve does not
+        // provide its shape parameters or its blending function derivatives, or if the table would be larger than
+        // BasisTableCache::MAXIMUM_TABLE_SIZE bytes or than the capacity of the cache
+        std::shared_ptr<const Matrix<GLdouble>> _BasisTable(GLuint max_order_of_derivatives, GLuint div_point_count) const;
+
     public:
         // special constructor
         LinearCombination3(
@@ -47,11 +68,21 @@ namespace cagd
         // assignment operator
         LinearCombination3& operator =(const LinearCombination3& rhs);
 
+        // move constructor: takes over the vertex buffer object of the data instead of re-uploading it
+        LinearCombination3(LinearCombination3&& lc) noexcept;
+
+        // move assignment operator
+        LinearCombination3& operator =(LinearCombination3&& rhs) noexcept;
+
         // vbo handling methods
         virtual GLvoid DeleteVertexBufferObjectsOfData();
         virtual GLboolean RenderData(GLenum render_mode = GL_LINE_STRIP) const;
         virtual GLboolean UpdateVertexBufferObjectsOfData(GLenum usage_flag = GL_STATIC_DRAW);
 
+        // overwrites the floats of the control point _data[index] in the existing vertex buffer object by
+        // glBufferSubData, fails if the vertex buffer object does not exist
+        GLboolean UpdateVertexBufferObjectsOfDataPoint(GLuint index);
+
         // get data by value
         DCoordinate3 operator [](GLuint index) const;
 
@@ -68,6 +99,12 @@ namespace cagd
         // calculates a row matrix which consists of function values {F_i(u)}_{i=0}^{data_count-1}
         virtual GLboolean BlendingFunctionValues(GLdouble u, RowMatrix<GLdouble>& values) const = 0;
 
+        // blending function values (row 0) and their derivatives up to the given order (row r); curves that
+        // provide them and their shape parameters (see CollocationShapeParameters) are imaged by GenerateImage as
+        // the product of a cached basis table and of the control points, the default implementation returns GL_FALSE
+        virtual GLboolean BlendingFunctionDerivatives(
+                GLuint max_order_of_derivatives, GLdouble u, Matrix<GLdouble>& derivatives) const;
+
         //----------------
         // abstract method
         //----------------
@@ -75,12 +112,70 @@ namespace cagd
         // combination sum_{i=0}^{data_count -1} _data[i] F_i(u) at the parameter value u
         virtual GLboolean CalculateDerivatives(GLuint max_order_of_derivatives, GLdouble u, Derivatives& d) const = 0;
 
-        // generate image/arc
+        // calculates the points and their (higher) order derivatives at count parameter values in a single pass,
+        // i.e., derivatives(r, k) becomes the derivative of order r at u[k] for all r <= max_order_of_derivatives
+        // and k < count; derivatives has to have at least max_order_of_derivatives + 1 rows and count columns,
+        // e.g., the derivative storage of a GenericCurve3; the default implementation calls CalculateDerivatives
+        // once per parameter value; GenerateImage relies on it if the curve has no basis table, i.e., if it does
+        // not provide its shape parameters or if its table would be too large to be cached (see _BasisTable),
+        // subclasses may override it by kernels that share work among the samples
+        virtual GLboolean CalculateDerivativesBatch(
+                GLuint max_order_of_derivatives, const GLdouble *u, GLuint count,
+                Matrix<DCoordinate3>& derivatives) const;
+
+        // generate image/arc; long sample ranges are evaluated in parallel by RealSquareMatrix::GetThreadCount()
+        // threads, the result coincides bitwise with the one of a serial run
         virtual GenericCurve3* GenerateImage(GLuint max_order_of_derivatives, GLuint div_point_count, GLenum usage_flag = GL_STATIC_DRAW) const;
 
+        // generates the images of several curves in parallel, images[i] becomes the image of curves[i] (as if it
+        // was generated by curves[i]->GenerateImage); the vertex buffer objects are not updated, since the
+        // rendering context belongs to the calling thread; fails, if any of the images could not be generated,
+        // the caller takes the ownership of the non-null images in any case
+        static GLboolean GenerateImages(const std::vector<const LinearCombination3*>& curves,
+                                        GLuint max_order_of_derivatives, GLuint div_point_count,
+                                        std::vector<GenericCurve3*>& images, GLenum usage_flag = GL_STATIC_DRAW);
+
+        // curvature-adaptive image, whose chordal deviation is at most the given tolerance (see
+        // AdaptiveCurveSampler); the samples are evaluated by CalculateDerivatives up to the order
+        // max(max_order_of_derivatives, 2), the point count of the image depends on the shape of the curve
+        GenericCurve3* GenerateAdaptiveImage(GLuint max_order_of_derivatives, GLdouble tolerance,
+                                             GLenum usage_flag = GL_STATIC_DRAW) const;
+
+        // arc-length table of the curve on its definition domain (see ArcLengthTable::Build), whose speed is
+        // evaluated by CalculateDerivatives; the table refers to *this, hence it has to be rebuilt after the
+        // data or the definition domain have been modified
+        GLboolean BuildArcLengthTable(ArcLengthTable& table,
+                                      GLuint segment_count = ArcLengthTable::DEFAULT_SEGMENT_COUNT) const;
+
+        // the point and its derivatives (with respect to the original parameter u) at the parameter value that
+        // belongs to the arc length s of a table built by BuildArcLengthTable
+        GLboolean CalculateDerivativesAtArcLength(const ArcLengthTable& table, GLuint max_order_of_derivatives,
+                                                  GLdouble s, Derivatives& d, GLuint newton_iterations = 2) const;
+
+        // incremental image update, when the control point _data[index] is displaced by delta (the caller updates
+        // _data itself): adds delta * F_index^(r)(u_k) to every derivative of the given image; first_index and
+        // last_index return the range of the changed samples, which can be passed to
+        // GenericCurve3::UpdateVertexBufferObjectsOfRange, if no sample has changed, the empty range
+        // first_index = 1, last_index = 0 is returned; fails, if the image has not been generated by GenerateImage
+        // (e.g. adaptive images, whose parameter values differ from the uniform grid), or if the curve does not
+        // provide a basis table (see BlendingFunctionDerivatives), in which case the image has to be regenerated
+        GLboolean UpdateImageForDataChange(GLuint index, const DCoordinate3& delta, GenericCurve3& image,
+                                           GLuint& first_index, GLuint& last_index) const;
+
+        // shape parameters (e.g. order, alpha) that, together with the dynamic type of the curve, determine the
+        // blending functions on a given definition domain; curves that provide them share the LU decompositions
+        // of their collocation matrices through FactorizationCache::Instance() and the tables of their sampled
+        // blending functions through BasisTableCache::Instance(), the default implementation returns GL_FALSE,
+        // i.e., the collocation matrix is factorized on every call of UpdateDataForInterpolation
+        virtual GLboolean CollocationShapeParameters(std::vector<GLdouble>& shape_parameters) const;
+
         // assure interpolation
         virtual GLboolean UpdateDataForInterpolation(const ColumnMatrix<GLdouble>& knot_vector, const ColumnMatrix<DCoordinate3>& data_points_to_interpolate);
 
+        // least squares fitting, i.e., updates the control points such that sum_r ||c(u_r) - d_r||^2 is minimal,
+        // where the number of sample points d_r has to be at least the number of control points
+        virtual GLboolean UpdateDataForLeastSquaresFitting(const ColumnMatrix<GLdouble>& parameter_values, const ColumnMatrix<DCoordinate3>& sample_points);
+
         // destructor
         virtual ~LinearCombination3();
     };
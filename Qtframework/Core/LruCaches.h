@@ -0,0 +1,222 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace cagd
+{
+    //--------------------
+    // class UnitEntryCost
+    //--------------------
+    // the default cost functor of LruCache, every entry costs 1, i.e., the capacity is a number of entries
+    class UnitEntryCost
+    {
+    public:
+        template <class Value>
+        std::size_t operator ()(const Value&) const
+        {
+            return 1;
+        }
+    };
+
+    //------------------------------------------
+    // template class LruCache<Key, Value, Cost>
+    //------------------------------------------
+    // thread-safe least recently used cache; Key has to provide a strict weak ordering by operator <, while
+    // Value is a shared pointer type, a null value denotes a missing entry; the function object Cost returns
+    // the cost of a stored value (e.g. its size in bytes), the total cost of the entries never exceeds the
+    // capacity of the cache
+    template <class Key, class Value, class Cost = UnitEntryCost>
+    class LruCache
+    {
+    public:
+        // number of entries kept by default
+        static const GLuint DEFAULT_CAPACITY = 32;
+
+    protected:
+        typedef std::pair<Key, Value> Entry;
+
+        mutable std::mutex                                  _mutex;
+        GLuint                                              _capacity;
+        std::size_t                                         _cost;     // total cost of the stored entries
+        std::list<Entry>                                    _entries;  // the most recently used entry is the first one
+        std::map<Key, typename std::list<Entry>::iterator>  _index;
+        GLuint                                              _hit_count, _miss_count;
+
+        // evicts the least recently used entries until their total cost does not exceed the given one
+        GLvoid _Shrink(std::size_t cost);
+
+    public:
+        // special/default constructor
+        LruCache(GLuint capacity = DEFAULT_CAPACITY);
+
+        // a cache cannot be copied
+        LruCache(const LruCache&) = delete;
+        LruCache& operator =(const LruCache&) = delete;
+
+        // returns the value associated with the key and marks it as the most recently used one, or a null value
+        // if it is not stored; updates the hit and miss counters
+        Value Find(const Key& key);
+
+        // stores a value, fails in case of a null value; a value that costs more than the capacity is not stored
+        GLboolean Insert(const Key& key, const Value& value);
+
+        // capacity handling, a capacity of 0 disables caching
+        GLvoid SetCapacity(GLuint capacity);
+        GLuint GetCapacity() const;
+
+        // number and total cost of the stored entries
+        GLuint      GetSize() const;
+        std::size_t GetCost() const;
+
+        // statistics
+        GLuint GetHitCount() const;
+        GLuint GetMissCount() const;
+        GLvoid ResetCounters();
+
+        // removes all stored values, the counters are kept
+        GLvoid Clear();
+    };
+
+    //------------------------------------------
+    // implementation of template class LruCache
+    //------------------------------------------
+    template <class Key, class Value, class Cost>
+    const GLuint LruCache<Key, Value, Cost>::DEFAULT_CAPACITY;
+
+    template <class Key, class Value, class Cost>
+    LruCache<Key, Value, Cost>::LruCache(GLuint capacity):
+            _capacity(capacity),
+            _cost(0),
+            _hit_count(0), _miss_count(0)
+    {
+    }
+
+    template <class Key, class Value, class Cost>
+    GLvoid LruCache<Key, Value, Cost>::_Shrink(std::size_t cost)
+    {
+        while (_cost > cost)
+        {
+            _cost -= Cost()(_entries.back().second);
+            _index.erase(_entries.back().first);
+            _entries.pop_back();
+        }
+    }
+
+    template <class Key, class Value, class Cost>
+    Value LruCache<Key, Value, Cost>::Find(const Key& key)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _index.find(key);
+
+        if (it == _index.end())
+        {
+            ++_miss_count;
+            return Value();
+        }
+
+        ++_hit_count;
+
+        // move the entry to the front of the recency list, the iterators remain valid
+        _entries.splice(_entries.begin(), _entries, it->second);
+
+        return it->second->second;
+    }
+
+    template <class Key, class Value, class Cost>
+    GLboolean LruCache<Key, Value, Cost>::Insert(const Key& key, const Value& value)
+    {
+        if (!value)
+            return GL_FALSE;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        std::size_t cost = Cost()(value);
+
+        if (cost > _capacity)
+            return GL_TRUE;
+
+        auto it = _index.find(key);
+
+        if (it != _index.end())
+        {
+            // another thread has already stored an equivalent value
+            _cost -= Cost()(it->second->second);
+            _entries.erase(it->second);
+            _index.erase(it);
+        }
+
+        _Shrink(_capacity - cost);
+
+        _entries.push_front(Entry(key, value));
+        _index.insert(std::make_pair(key, _entries.begin()));
+        _cost += cost;
+
+        return GL_TRUE;
+    }
+
+    template <class Key, class Value, class Cost>
+    GLvoid LruCache<Key, Value, Cost>::SetCapacity(GLuint capacity)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _capacity = capacity;
+        _Shrink(_capacity);
+    }
+
+    template <class Key, class Value, class Cost>
+    GLuint LruCache<Key, Value, Cost>::GetCapacity() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _capacity;
+    }
+
+    template <class Key, class Value, class Cost>
+    GLuint LruCache<Key, Value, Cost>::GetSize() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return (GLuint)_entries.size();
+    }
+
+    template <class Key, class Value, class Cost>
+    std::size_t LruCache<Key, Value, Cost>::GetCost() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _cost;
+    }
+
+    template <class Key, class Value, class Cost>
+    GLuint LruCache<Key, Value, Cost>::GetHitCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _hit_count;
+    }
+
+    template <class Key, class Value, class Cost>
+    GLuint LruCache<Key, Value, Cost>::GetMissCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _miss_count;
+    }
+
+    template <class Key, class Value, class Cost>
+    GLvoid LruCache<Key, Value, Cost>::ResetCounters()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _hit_count = _miss_count = 0;
+    }
+
+    template <class Key, class Value, class Cost>
+    GLvoid LruCache<Key, Value, Cost>::Clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _index.clear();
+        _entries.clear();
+        _cost = 0;
+    }
+}
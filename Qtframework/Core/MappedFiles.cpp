@@ -0,0 +1,140 @@
+#include "MappedFiles.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace cagd;
+using namespace std;
+
+// default constructor
+MappedFile::MappedFile():
+        _data(nullptr), _size(0),
+#ifdef _WIN32
+        _file_handle(INVALID_HANDLE_VALUE), _mapping_handle(nullptr)
+#else
+        _file_descriptor(-1)
+#endif
+{
+}
+
+// maps the given file
+GLboolean MappedFile::Open(const string& file_name)
+{
+    Close();
+
+#ifdef _WIN32
+    _file_handle = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (_file_handle == INVALID_HANDLE_VALUE)
+        return GL_FALSE;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(_file_handle, &size) || size.QuadPart == 0)
+    {
+        Close();
+        return GL_FALSE;
+    }
+    _size = (size_t)size.QuadPart;
+
+    _mapping_handle = CreateFileMappingA(_file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!_mapping_handle)
+    {
+        Close();
+        return GL_FALSE;
+    }
+
+    _data = (const char*)MapViewOfFile(_mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (!_data)
+    {
+        Close();
+        return GL_FALSE;
+    }
+#else
+    _file_descriptor = open(file_name.c_str(), O_RDONLY);
+    if (_file_descriptor < 0)
+        return GL_FALSE;
+
+    struct stat status;
+    if (fstat(_file_descriptor, &status) != 0 || status.st_size == 0)
+    {
+        Close();
+        return GL_FALSE;
+    }
+    _size = (size_t)status.st_size;
+
+    void *address = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _file_descriptor, 0);
+    if (address == MAP_FAILED)
+    {
+        Close();
+        return GL_FALSE;
+    }
+
+    // the content is consumed front to back
+    madvise(address, _size, MADV_SEQUENTIAL);
+
+    _data = (const char*)address;
+#endif
+
+    return GL_TRUE;
+}
+
+// unmaps the file
+GLvoid MappedFile::Close()
+{
+#ifdef _WIN32
+    if (_data)
+        UnmapViewOfFile(_data);
+
+    if (_mapping_handle)
+    {
+        CloseHandle(_mapping_handle);
+        _mapping_handle = nullptr;
+    }
+
+    if (_file_handle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(_file_handle);
+        _file_handle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (_data)
+        munmap((void*)_data, _size);
+
+    if (_file_descriptor >= 0)
+    {
+        close(_file_descriptor);
+        _file_descriptor = -1;
+    }
+#endif
+
+    _data = nullptr;
+    _size = 0;
+}
+
+// get properties
+GLboolean MappedFile::IsOpen() const
+{
+    return _data != nullptr;
+}
+
+const char* MappedFile::GetData() const
+{
+    return _data;
+}
+
+size_t MappedFile::GetSize() const
+{
+    return _size;
+}
+
+// destructor
+MappedFile::~MappedFile()
+{
+    Close();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <string>
+
+namespace cagd
+{
+    //-----------------
+    // class MappedFile
+    //-----------------
+    // read-only memory mapping of a whole file; the mapped bytes remain valid until Close() is
+    // called or the object is destroyed
+    class MappedFile
+    {
+    protected:
+        const char*  _data;
+        std::size_t  _size;
+
+#ifdef _WIN32
+        void*        _file_handle;
+        void*        _mapping_handle;
+#else
+        int          _file_descriptor;
+#endif
+
+    public:
+        // default constructor
+        MappedFile();
+
+        // a mapping cannot be shared
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator =(const MappedFile&) = delete;
+
+        // maps the given file, a previously opened mapping is closed first
+        GLboolean Open(const std::string& file_name);
+
+        // unmaps the file
+        GLvoid Close();
+
+        // get properties
+        GLboolean   IsOpen() const;
+        const char* GetData() const;
+        std::size_t GetSize() const;
+
+        // destructor
+        ~MappedFile();
+    };
+}
@@ -1,56 +1,94 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <memory>
+#include <utility>
 #include <vector>
 #include <GL/glew.h>
 
 namespace cagd
 {
-    // forward declaration of template class Matrix
+    // forward declaration of template class MatrixSpan
     template <typename T>
+    class MatrixSpan;
+
+    // forward declaration of template class Matrix
+    template <typename T, class Allocator = std::allocator<T>>
     class Matrix;
 
     // forward declaration of template class RowMatrix
-    template <typename T>
+    template <typename T, class Allocator = std::allocator<T>>
     class RowMatrix;
 
     // forward declaration of template class ColumnMatrix
-    template <typename T>
+    template <typename T, class Allocator = std::allocator<T>>
     class ColumnMatrix;
 
 	// forward declaration of template class TriangularMatrix
-    template <typename T>
+    template <typename T, class Allocator = std::allocator<T>>
     class TriangularMatrix;
 
     // forward declarations of overloaded and templated input/output from/to stream operators
-    template <typename T>
-    std::ostream& operator << (std::ostream& lhs, const Matrix<T>& rhs);
+    template <typename T, class Allocator>
+    std::ostream& operator << (std::ostream& lhs, const Matrix<T, Allocator>& rhs);
 
-    template <typename T>
-    std::istream& operator >>(std::istream& lhs, Matrix<T>& rhs);
+    template <typename T, class Allocator>
+    std::istream& operator >>(std::istream& lhs, Matrix<T, Allocator>& rhs);
 
-	template <typename T>
-    std::istream& operator >>(std::istream& lhs, TriangularMatrix<T>& rhs);
+	template <typename T, class Allocator>
+    std::istream& operator >>(std::istream& lhs, TriangularMatrix<T, Allocator>& rhs);
     
+    template <typename T, class Allocator>
+    std::ostream& operator << (std::ostream& lhs, const TriangularMatrix<T, Allocator>& rhs);
+
+    //--------------------------
+    // template class MatrixSpan
+    //--------------------------
+    // non-owning view of a row (stride 1) or of a column (stride = column count) of a Matrix;
+    // it remains valid only as long as the dimensions of the viewed matrix do not change
     template <typename T>
-    std::ostream& operator << (std::ostream& lhs, const TriangularMatrix<T>& rhs);
+    class MatrixSpan
+    {
+    protected:
+        T*      _first;
+        GLuint  _count;
+        GLuint  _stride;
+
+    public:
+        // special constructor
+        MatrixSpan(T* first = nullptr, GLuint count = 0, GLuint stride = 1);
+
+        // a mutable span can always be viewed as a read-only one
+        template <typename U>
+        MatrixSpan(const MatrixSpan<U>& span);
+
+        // get element by reference
+        T& operator [](GLuint index) const;
+
+        // get properties
+        T*     GetFirst() const;
+        GLuint GetCount() const;
+        GLuint GetStride() const;
+    };
 
     //----------------------
     // template class Matrix
     //----------------------
-    template <typename T>
+    template <typename T, class Allocator>
     class Matrix
     {
-        friend std::ostream& cagd::operator << <T>(std::ostream&, const Matrix<T>& rhs);
-        friend std::istream& cagd::operator >> <T>(std::istream&, Matrix<T>& rhs);
+        friend std::ostream& cagd::operator << <T, Allocator>(std::ostream&, const Matrix<T, Allocator>& rhs);
+        friend std::istream& cagd::operator >> <T, Allocator>(std::istream&, Matrix<T, Allocator>& rhs);
 
     protected:
         GLuint                          _row_count;
         GLuint                          _column_count;
-        std::vector< std::vector<T> >   _data;
+        std::vector<T, Allocator>       _data;          // row-major, element (r, c) is _data[r * _column_count + c]
     public:
         // special constructor (can also be used as a default constructor)
-        Matrix(GLuint row_count = 1, GLuint column_count = 1);//_data(_row_count, std::vector<T> (_column_count))
+        Matrix(GLuint row_count = 1, GLuint column_count = 1);
 
         // copy constructor
         Matrix(const Matrix& m);
@@ -58,6 +96,12 @@ namespace cagd
         // assignment operator
         Matrix& operator =(const Matrix& m);
 
+        // move constructor, m is left as an empty 0 x 0 matrix
+        Matrix(Matrix&& m) noexcept;
+
+        // move assignment operator
+        Matrix& operator =(Matrix&& m) noexcept;
+
         // get element by reference
         T& operator ()(GLuint row, GLuint column);
 
@@ -72,9 +116,21 @@ namespace cagd
         virtual GLboolean ResizeRows(GLuint row_count);
         virtual GLboolean ResizeColumns(GLuint column_count);
 
+        // non-owning views of a row or column, no elements are copied
+        MatrixSpan<T>       Row(GLuint index);
+        MatrixSpan<const T> Row(GLuint index) const;
+        MatrixSpan<T>       Column(GLuint index);
+        MatrixSpan<const T> Column(GLuint index) const;
+
+        // contiguous row-major storage
+        T*       GetData();
+        const T* GetData() const;
+
         // update
-        GLboolean SetRow(GLuint index, const RowMatrix<T>& row);
-        GLboolean SetColumn(GLuint index, const ColumnMatrix<T>& column);
+        GLboolean SetRow(GLuint index, const RowMatrix<T, Allocator>& row);
+        GLboolean SetRow(GLuint index, const MatrixSpan<const T>& row);
+        GLboolean SetColumn(GLuint index, const ColumnMatrix<T, Allocator>& column);
+        GLboolean SetColumn(GLuint index, const MatrixSpan<const T>& column);
 
         // destructor
         virtual ~Matrix();
@@ -83,8 +139,8 @@ namespace cagd
     //-------------------------
     // template class RowMatrix
     //-------------------------
-    template <typename T>
-    class RowMatrix: public Matrix<T>
+    template <typename T, class Allocator>
+    class RowMatrix: public Matrix<T, Allocator>
     {
     public:
         // special constructor (can also be used as a default constructor)
@@ -105,8 +161,8 @@ namespace cagd
     //----------------------------
     // template class ColumnMatrix
     //----------------------------
-    template <typename T>
-    class ColumnMatrix: public Matrix<T>
+    template <typename T, class Allocator>
+    class ColumnMatrix: public Matrix<T, Allocator>
     {
     public:
         // special constructor (can also be used as a default constructor)
@@ -129,15 +185,18 @@ namespace cagd
     // template class TriangularMatrix
     //--------------------------------
 
-    template <typename T>
+    template <typename T, class Allocator>
     class TriangularMatrix
     {
-        friend std::istream& cagd::operator >> <T>(std::istream&, TriangularMatrix<T>& rhs);
-        friend std::ostream& cagd::operator << <T>(std::ostream&, const TriangularMatrix<T>& rhs);
+        friend std::istream& cagd::operator >> <T, Allocator>(std::istream&, TriangularMatrix<T, Allocator>& rhs);
+        friend std::ostream& cagd::operator << <T, Allocator>(std::ostream&, const TriangularMatrix<T, Allocator>& rhs);
 
     protected:
         GLuint                        _row_count;
-        std::vector< std::vector<T> > _data;
+        std::vector<T, Allocator>     _data;    // packed rows, element (r, c) is _data[r * (r + 1) / 2 + c]
+
+        // position of element (row, column) in the packed buffer
+        static GLuint _Index(GLuint row, GLuint column);
 
     public:
         // special constructor (can also be used as a default constructor)
@@ -152,94 +211,214 @@ namespace cagd
         // get dimension
         GLuint GetRowCount() const;
 
+        // contiguous packed storage of row_count * (row_count + 1) / 2 elements
+        T*       GetData();
+        const T* GetData() const;
+
         // set dimension
         GLboolean ResizeRows(GLuint row_count);
     };
 
+    //--------------------------------------------
+    // implementation of template class MatrixSpan
+    //--------------------------------------------
+      template <typename T>
+      MatrixSpan<T>::MatrixSpan(T* first, GLuint count, GLuint stride):_first(first),_count(count),_stride(stride){}
+
+      template <typename T>
+      template <typename U>
+      MatrixSpan<T>::MatrixSpan(const MatrixSpan<U>& span):_first(span.GetFirst()),_count(span.GetCount()),_stride(span.GetStride()){}
+
+      template <typename T>
+      T& MatrixSpan<T>::operator [](GLuint index) const{
+          return _first[index * _stride];
+      }
+
+      template <typename T>
+      T* MatrixSpan<T>::GetFirst() const{
+          return _first;
+      }
+
+      template <typename T>
+      GLuint MatrixSpan<T>::GetCount() const{
+          return _count;
+      }
+
+      template <typename T>
+      GLuint MatrixSpan<T>::GetStride() const{
+          return _stride;
+      }
+
     //--------------------------------------------------
     // homework: implementation of template class Matrix
     //--------------------------------------------------
-      template <typename T>
-      Matrix<T>::Matrix(GLuint row_count , GLuint column_count):_row_count(row_count),_column_count(column_count),_data(row_count, std::vector<T> (column_count)){}
+      template <typename T, class Allocator>
+      Matrix<T, Allocator>::Matrix(GLuint row_count , GLuint column_count):_row_count(row_count),_column_count(column_count),_data(row_count * column_count){}
 
-      template <typename T>
-      Matrix<T>::Matrix(const Matrix& m):_row_count(m._row_count),_column_count(m._column_count), _data(m._data){//lehet olyat tenni, hogy _data=m._data ?
-        _data=m._data;
+      template <typename T, class Allocator>
+      Matrix<T, Allocator>::Matrix(const Matrix& m):_row_count(m._row_count),_column_count(m._column_count), _data(m._data){
       }
 
-      template <typename T>//?Ha nem ugyanakkorak, akkor meg kell cserelni a mereteket ?
-      Matrix<T>& Matrix<T>::operator =(const Matrix& m){
+      template <typename T, class Allocator>
+      Matrix<T, Allocator>& Matrix<T, Allocator>::operator =(const Matrix& m){
         if(this != &m){
           _row_count=m._row_count;
           _column_count=m._column_count;
-          _data=m._data;          
+          _data=m._data;
         }
         return *this;
       }
-      template <typename T>
-      T& Matrix<T>::operator ()(GLuint row, GLuint column){
-          return _data[row][column];
+      template <typename T, class Allocator>
+      Matrix<T, Allocator>::Matrix(Matrix&& m) noexcept:_row_count(m._row_count),_column_count(m._column_count), _data(std::move(m._data)){
+        m._row_count = 0;
+        m._column_count = 0;
+        m._data.clear();
       }
-      template <typename T>
-      T Matrix<T>::operator ()(GLuint row, GLuint column) const{
-          return _data[row][column];
+
+      template <typename T, class Allocator>
+      Matrix<T, Allocator>& Matrix<T, Allocator>::operator =(Matrix&& m) noexcept{
+        if(this != &m){
+          _row_count=m._row_count;
+          _column_count=m._column_count;
+          _data=std::move(m._data);
+          m._row_count = 0;
+          m._column_count = 0;
+          m._data.clear();
+        }
+        return *this;
+      }
+
+      template <typename T, class Allocator>
+      T& Matrix<T, Allocator>::operator ()(GLuint row, GLuint column){
+          return _data[row * _column_count + column];
+      }
+      template <typename T, class Allocator>
+      T Matrix<T, Allocator>::operator ()(GLuint row, GLuint column) const{
+          return _data[row * _column_count + column];
       }
 
       // get dimensions
-      template <typename T>
-      GLuint Matrix<T>::GetRowCount() const{
+      template <typename T, class Allocator>
+      GLuint Matrix<T, Allocator>::GetRowCount() const{
         return _row_count;
       }
 
-      template <typename T>
-      GLuint Matrix<T>::GetColumnCount() const{
+      template <typename T, class Allocator>
+      GLuint Matrix<T, Allocator>::GetColumnCount() const{
         return _column_count;
       }
 
       // set dimensions
-      template <typename T>//Milyen bool erteket kell visszateriteni ?
-      GLboolean Matrix<T>::ResizeRows(GLuint row_count){
+      template <typename T, class Allocator>
+      GLboolean Matrix<T, Allocator>::ResizeRows(GLuint row_count){
+          // rows are stored one after the other, so existing elements keep their place
           _row_count = row_count;
-           _data.resize(_row_count,std::vector<T>(_column_count));//le kell nullazni az uj sorokat ? es ha a T nem szam ?
+          _data.resize(_row_count * _column_count);
           return GL_TRUE;
       }
 
-      template <typename T>//Milyen bool erteket kell visszateriteni ?
-      GLboolean Matrix<T>::ResizeColumns(GLuint column_count){
-        _column_count = column_count;
+      template <typename T, class Allocator>
+      GLboolean Matrix<T, Allocator>::ResizeColumns(GLuint column_count){
+        if (column_count == _column_count)
+            return GL_TRUE;
+
+        // the row stride changes, so the surviving elements have to be repacked
+        std::vector<T, Allocator> data(_row_count * column_count, T(), _data.get_allocator());
+        GLuint kept_column_count = std::min(_column_count, column_count);
         for(GLuint i=0;i<_row_count;i++){
-            _data[i].resize(_column_count); //le kell nullazni az uj oszlopokat ? es ha a T nem szam ?
+            std::copy(_data.begin() + i * _column_count,
+                      _data.begin() + i * _column_count + kept_column_count,
+                      data.begin() + i * column_count);
         }
+        _data.swap(data);
+        _column_count = column_count;
         return GL_TRUE;
       }
 
+      // views
+      template <typename T, class Allocator>
+      MatrixSpan<T> Matrix<T, Allocator>::Row(GLuint index){
+          return MatrixSpan<T>(_data.data() + index * _column_count, _column_count, 1);
+      }
+
+      template <typename T, class Allocator>
+      MatrixSpan<const T> Matrix<T, Allocator>::Row(GLuint index) const{
+          return MatrixSpan<const T>(_data.data() + index * _column_count, _column_count, 1);
+      }
+
+      template <typename T, class Allocator>
+      MatrixSpan<T> Matrix<T, Allocator>::Column(GLuint index){
+          return MatrixSpan<T>(_data.data() + index, _row_count, _column_count);
+      }
+
+      template <typename T, class Allocator>
+      MatrixSpan<const T> Matrix<T, Allocator>::Column(GLuint index) const{
+          return MatrixSpan<const T>(_data.data() + index, _row_count, _column_count);
+      }
+
+      template <typename T, class Allocator>
+      T* Matrix<T, Allocator>::GetData(){
+          return _data.data();
+      }
+
+      template <typename T, class Allocator>
+      const T* Matrix<T, Allocator>::GetData() const{
+          return _data.data();
+      }
+
       // update
-      template  <typename T>
-      GLboolean Matrix<T>::SetRow(GLuint index, const RowMatrix<T>& row){
+      template <typename T, class Allocator>
+      GLboolean Matrix<T, Allocator>::SetRow(GLuint index, const RowMatrix<T, Allocator>& row){
         if(index>=_row_count||row._column_count!=_column_count){
          return GL_FALSE;
         }
 
-          _data[index]=row._data[0];
+          std::copy(row._data.begin(), row._data.end(), _data.begin() + index * _column_count);
           return GL_TRUE;
       }
 
-      template  <typename T>
-      GLboolean Matrix<T>::SetColumn(GLuint index, const ColumnMatrix<T>& column){
+      template <typename T, class Allocator>
+      GLboolean Matrix<T, Allocator>::SetRow(GLuint index, const MatrixSpan<const T>& row){
+        if(index>=_row_count||row.GetCount()!=_column_count){
+         return GL_FALSE;
+        }
+
+        T* destination = _data.data() + index * _column_count;
+        for(GLuint j=0;j<_column_count;j++){
+            destination[j]=row[j];
+        }
+        return GL_TRUE;
+      }
+
+      template <typename T, class Allocator>
+      GLboolean Matrix<T, Allocator>::SetColumn(GLuint index, const ColumnMatrix<T, Allocator>& column){
 
         if( index>=_column_count || _row_count!=column._row_count){
             return GL_FALSE;
         }
 
-        for(int i=0;i<_row_count;i++){
-            _data[i][index]=column._data[i][0];
+        for(GLuint i=0;i<_row_count;i++){
+            _data[i * _column_count + index]=column._data[i];
+          }
+        return GL_TRUE;
+      }
+
+      template <typename T, class Allocator>
+      GLboolean Matrix<T, Allocator>::SetColumn(GLuint index, const MatrixSpan<const T>& column){
+
+        if( index>=_column_count || _row_count!=column.GetCount()){
+            return GL_FALSE;
+        }
+
+        for(GLuint i=0;i<_row_count;i++){
+            _data[i * _column_count + index]=column[i];
           }
         return GL_TRUE;
       }
 
       // destructor
-      template <typename T>
-      Matrix<T>::~Matrix(){
+      template <typename T, class Allocator>
+      Matrix<T, Allocator>::~Matrix(){
         _data.clear();
       }
     //-----------------------------------------------------
@@ -247,67 +426,67 @@ namespace cagd
     //-----------------------------------------------------
 
       // special constructor (can also be used as a default constructor)
-      template <typename T>
-      RowMatrix<T>::RowMatrix(GLuint column_count):Matrix<T>(1,column_count){
+      template <typename T, class Allocator>
+      RowMatrix<T, Allocator>::RowMatrix(GLuint column_count):Matrix<T, Allocator>(1,column_count){
 
       }
 
       // get element by reference
-      template <typename T>
-      T& RowMatrix<T>::operator ()(GLuint column){
-          return Matrix<T>::_data[0][column];
+      template <typename T, class Allocator>
+      T& RowMatrix<T, Allocator>::operator ()(GLuint column){
+          return Matrix<T, Allocator>::_data[column];
       }
 
-      template <typename T>
-      T& RowMatrix<T>::operator [](GLuint column){
-        return Matrix<T>::_data[0][column];
+      template <typename T, class Allocator>
+      T& RowMatrix<T, Allocator>::operator [](GLuint column){
+        return Matrix<T, Allocator>::_data[column];
       }
 
-      template <typename T>
-      T RowMatrix<T>::operator ()(GLuint column) const{
-        return Matrix<T>::_data[0][column];
+      template <typename T, class Allocator>
+      T RowMatrix<T, Allocator>::operator ()(GLuint column) const{
+        return Matrix<T, Allocator>::_data[column];
       }
-      template <typename T>
-      T RowMatrix<T>::operator [](GLuint column) const{
-        return Matrix<T>::_data[0][column];
+      template <typename T, class Allocator>
+      T RowMatrix<T, Allocator>::operator [](GLuint column) const{
+        return Matrix<T, Allocator>::_data[column];
       }
 
       // a row matrix consists of a single row
-      template <typename T>
-      GLboolean RowMatrix<T>::ResizeRows(GLuint row_count){//itt most akkor tobb sort kell letrehozni, vagy oszlopokat kell novelni ?          
+      template <typename T, class Allocator>
+      GLboolean RowMatrix<T, Allocator>::ResizeRows(GLuint row_count){//itt most akkor tobb sort kell letrehozni, vagy oszlopokat kell novelni ?          
           return (row_count == 1);
       }
 
     //--------------------------------------------------------
     // homework: implementation of template class ColumnMatrix
     //--------------------------------------------------------
-      template <typename T>
-      ColumnMatrix<T>::ColumnMatrix(GLuint row_count):Matrix<T>(row_count,1){}
+      template <typename T, class Allocator>
+      ColumnMatrix<T, Allocator>::ColumnMatrix(GLuint row_count):Matrix<T, Allocator>(row_count,1){}
 
       // get element by reference
-      template <typename T>
-      T& ColumnMatrix<T>::operator ()(GLuint row){
-        return Matrix<T>::_data[row][0];
+      template <typename T, class Allocator>
+      T& ColumnMatrix<T, Allocator>::operator ()(GLuint row){
+        return Matrix<T, Allocator>::_data[row];
       }
-      template <typename T>
-      T& ColumnMatrix<T>::operator [](GLuint row){
-        return Matrix<T>::_data[row][0];
+      template <typename T, class Allocator>
+      T& ColumnMatrix<T, Allocator>::operator [](GLuint row){
+        return Matrix<T, Allocator>::_data[row];
       }
 
       // get copy of an element
-      template <typename T>
-      T ColumnMatrix<T>::operator ()(GLuint row) const{
-        return Matrix<T>::_data[row][0];
+      template <typename T, class Allocator>
+      T ColumnMatrix<T, Allocator>::operator ()(GLuint row) const{
+        return Matrix<T, Allocator>::_data[row];
       }
 
-      template <typename T>
-      T ColumnMatrix<T>::operator [](GLuint row) const{
-        return Matrix<T>::_data[row][0];
+      template <typename T, class Allocator>
+      T ColumnMatrix<T, Allocator>::operator [](GLuint row) const{
+        return Matrix<T, Allocator>::_data[row];
       }
 
       // a column matrix consists of a single column
-      template <typename T>
-      GLboolean ColumnMatrix<T>::ResizeColumns(GLuint column_count){//Itt nem a sorokat akarjuk vajon valtoztatni, marmint, ha megvaltoztatjuk mar nem lesz oszlopmatrix       
+      template <typename T, class Allocator>
+      GLboolean ColumnMatrix<T, Allocator>::ResizeColumns(GLuint column_count){//Itt nem a sorokat akarjuk vajon valtoztatni, marmint, ha megvaltoztatjuk mar nem lesz oszlopmatrix       
         return (column_count == 1);
       }
     //------------------------------------------------------------
@@ -315,38 +494,50 @@ namespace cagd
     //------------------------------------------------------------
 
       // special constructor (can also be used as a default constructor)
-      template <typename T>
-      TriangularMatrix<T>::TriangularMatrix(GLuint row_count ):_row_count(row_count),_data(row_count){
-        for(int i=0;i<_row_count;i++){
-            _data[i].resize(i+1);
-        }
+      template <typename T, class Allocator>
+      TriangularMatrix<T, Allocator>::TriangularMatrix(GLuint row_count ):_row_count(row_count),_data((std::size_t)row_count * (row_count + 1) / 2){
+      }
+
+      template <typename T, class Allocator>
+      inline GLuint TriangularMatrix<T, Allocator>::_Index(GLuint row, GLuint column){
+        return row * (row + 1) / 2 + column;
       }
 
       // get element by reference
-      template <typename T>
-      T& TriangularMatrix<T>::operator ()(GLuint row, GLuint column){
-        return _data[row][column];
+      template <typename T, class Allocator>
+      T& TriangularMatrix<T, Allocator>::operator ()(GLuint row, GLuint column){
+        return _data[_Index(row, column)];
       }
 
       // get copy of an element
-      template <typename T>
-      T TriangularMatrix<T>::operator ()(GLuint row, GLuint column) const{
-        return _data[row][column];
+      template <typename T, class Allocator>
+      T TriangularMatrix<T, Allocator>::operator ()(GLuint row, GLuint column) const{
+        return _data[_Index(row, column)];
       }
 
       // get dimension
-      template <typename T>
-      GLuint TriangularMatrix<T>::GetRowCount() const{
+      template <typename T, class Allocator>
+      GLuint TriangularMatrix<T, Allocator>::GetRowCount() const{
         return _row_count;
       }
 
+      template <typename T, class Allocator>
+      T* TriangularMatrix<T, Allocator>::GetData(){
+        return _data.data();
+      }
+
+      template <typename T, class Allocator>
+      const T* TriangularMatrix<T, Allocator>::GetData() const{
+        return _data.data();
+      }
+
       // set dimension
-      template <typename T>
-      GLboolean TriangularMatrix<T>::ResizeRows(GLuint row_count){//Milyen boolean erteket kell teriteni ?
-        _data.resize(row_count);
-        for(GLuint i=_row_count;i<row_count;i++){
-            _data[i].resize(i+1);
-        }
+      template <typename T, class Allocator>
+      GLboolean TriangularMatrix<T, Allocator>::ResizeRows(GLuint row_count){
+        // rows are packed one after the other, so existing elements keep their place and
+        // shrinking or re-growing within the reserved capacity does not reallocate; the element count is
+        // evaluated in std::size_t, since it exceeds GLuint from 92682 rows on
+        _data.resize((std::size_t)row_count * (row_count + 1) / 2);
         _row_count=row_count;
         return GL_TRUE;
       }
@@ -355,63 +546,53 @@ namespace cagd
     //------------------------------------------------------------------------------
 
     // output to stream
-    template <typename T>//todo resize matrices on input
-    std::ostream& operator <<(std::ostream& lhs, const Matrix<T>& rhs)
+    template <typename T, class Allocator>
+    std::ostream& operator <<(std::ostream& lhs, const Matrix<T, Allocator>& rhs)
     {
         lhs << rhs._row_count << " " << rhs._column_count << std::endl;
-        for (typename std::vector< std::vector<T> >::const_iterator row = rhs._data.begin();
-             row != rhs._data.end(); ++row)
+        typename std::vector<T, Allocator>::const_iterator element = rhs._data.begin();
+        for (GLuint row = 0; row < rhs._row_count; ++row)
         {
-            for (typename std::vector<T>::const_iterator column = row->begin();
-                 column != row->end(); ++column)
-                    lhs << *column << " ";
+            for (GLuint column = 0; column < rhs._column_count; ++column, ++element)
+                    lhs << *element << " ";
             lhs << std::endl;
         }
         return lhs;
     }
-    template <typename T>
-    std::ostream& operator <<(std::ostream& lhs, const TriangularMatrix<T>& rhs){
+    template <typename T, class Allocator>
+    std::ostream& operator <<(std::ostream& lhs, const TriangularMatrix<T, Allocator>& rhs){
       lhs << rhs._row_count  << std::endl;
-      for (typename std::vector< std::vector<T> >::const_iterator row = rhs._data.begin();
-           row != rhs._data.end(); ++row)
+      typename std::vector<T, Allocator>::const_iterator element = rhs._data.begin();
+      for (GLuint row = 0; row < rhs._row_count; ++row)
       {
-          for (typename std::vector<T>::const_iterator column = row->begin();
-               column != row->end(); ++column)
-                  lhs << *column << " ";
+          for (GLuint column = 0; column <= row; ++column, ++element)
+                  lhs << *element << " ";
           lhs << std::endl;
       }
       return lhs;
     }
 
     // input from stream
-    template <typename T>
-    std::istream& operator >>(std::istream& lhs, Matrix<T>& rhs)
+    template <typename T, class Allocator>
+    std::istream& operator >>(std::istream& lhs, Matrix<T, Allocator>& rhs)
     {
-        // homework sima iteratorokat hasznalunk, a kiiratas szimmetrikusa kell
+        // the elements are stored contiguously, so a single pass over the buffer is symmetric to the output
         lhs >> rhs._row_count  >> rhs._column_count;
-        rhs.ResizeRows(rhs._row_count);
-        rhs.ResizeColumns(rhs._column_count);
-        for (typename std::vector< std::vector<T> >::iterator row = rhs._data.begin();
-             row != rhs._data.end(); ++row)
-        {
-            for (typename std::vector<T>::iterator column = row->begin();
-                 column != row->end(); ++column)
-              lhs >> *column;
-        }
+        rhs._data.resize(rhs._row_count * rhs._column_count);
+        for (typename std::vector<T, Allocator>::iterator element = rhs._data.begin();
+             element != rhs._data.end(); ++element)
+              lhs >> *element;
         return lhs;
    }
 
-    template <typename T>
-    std::istream& operator >> (std::istream& lhs, TriangularMatrix<T>& rhs){
-      lhs >> rhs._row_count;//resize matrix
-      rhs.ResizeRows(rhs._row_count);
-      for (typename std::vector< std::vector<T> >::iterator row = rhs._data.begin();
-           row != rhs._data.end(); ++row)
-      {
-          for (typename std::vector<T>::iterator column = row->begin();
-               column != row->end(); ++column)
-            lhs >> *column;
-      }
+    template <typename T, class Allocator>
+    std::istream& operator >> (std::istream& lhs, TriangularMatrix<T, Allocator>& rhs){
+      GLuint row_count;
+      lhs >> row_count;
+      rhs.ResizeRows(row_count);
+      for (typename std::vector<T, Allocator>::iterator element = rhs._data.begin();
+           element != rhs._data.end(); ++element)
+            lhs >> *element;
       return lhs;
     }
 }
@@ -0,0 +1,222 @@
+#include "MatrixAlgebra.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#include <immintrin.h>
+#define CAGD_GEMM_AVX2_FMA
+#endif
+
+using namespace cagd;
+using namespace std;
+
+// every register tile of c consists of 4 rows and of two 256-bit vectors per row
+template <typename T>
+struct Tile
+{
+    static const GLuint ROWS    = 4;
+    static const GLuint COLUMNS = 64 / sizeof(T);
+};
+
+// c[0:count] += alpha * b[0:count]
+template <typename T>
+static inline GLvoid RowUpdate(T * __restrict c, T alpha, const T * __restrict b, GLuint count)
+{
+    for (GLuint j = 0; j < count; ++j)
+        c[j] += alpha * b[j];
+}
+
+// c[0:4, 0:w] += alpha * a[0:4, 0:depth] * b[0:depth, 0:w], where the 4 x w tile of c is accumulated in registers
+template <typename T>
+static inline GLvoid TileUpdate(GLuint depth, T alpha,
+                                const T *a, GLuint lda,
+                                const T *b, GLuint ldb,
+                                T *c, GLuint ldc)
+{
+    const GLuint w = Tile<T>::COLUMNS;
+
+    T tile[4][w] = {};
+
+    for (GLuint p = 0; p < depth; ++p, b += ldb)
+        for (GLuint r = 0; r < 4; ++r)
+        {
+            T a_rp = a[r * lda + p];
+            for (GLuint j = 0; j < w; ++j)
+                tile[r][j] += a_rp * b[j];
+        }
+
+    for (GLuint r = 0; r < 4; ++r, c += ldc)
+        for (GLuint j = 0; j < w; ++j)
+            c[j] += alpha * tile[r][j];
+}
+
+#ifdef CAGD_GEMM_AVX2_FMA
+template <>
+inline GLvoid RowUpdate<GLdouble>(GLdouble * __restrict c, GLdouble alpha, const GLdouble * __restrict b, GLuint count)
+{
+    GLuint j = 0;
+
+    __m256d factor = _mm256_set1_pd(alpha);
+    for (; j + 4 <= count; j += 4)
+        _mm256_storeu_pd(c + j, _mm256_fmadd_pd(factor, _mm256_loadu_pd(b + j), _mm256_loadu_pd(c + j)));
+
+    for (; j < count; ++j)
+        c[j] += alpha * b[j];
+}
+
+template <>
+inline GLvoid RowUpdate<GLfloat>(GLfloat * __restrict c, GLfloat alpha, const GLfloat * __restrict b, GLuint count)
+{
+    GLuint j = 0;
+
+    __m256 factor = _mm256_set1_ps(alpha);
+    for (; j + 8 <= count; j += 8)
+        _mm256_storeu_ps(c + j, _mm256_fmadd_ps(factor, _mm256_loadu_ps(b + j), _mm256_loadu_ps(c + j)));
+
+    for (; j < count; ++j)
+        c[j] += alpha * b[j];
+}
+
+template <>
+inline GLvoid TileUpdate<GLdouble>(GLuint depth, GLdouble alpha,
+                                   const GLdouble *a, GLuint lda,
+                                   const GLdouble *b, GLuint ldb,
+                                   GLdouble *c, GLuint ldc)
+{
+    __m256d t[4][2];
+    for (GLuint r = 0; r < 4; ++r)
+        t[r][0] = t[r][1] = _mm256_setzero_pd();
+
+    for (GLuint p = 0; p < depth; ++p, b += ldb)
+    {
+        __m256d b0 = _mm256_loadu_pd(b), b1 = _mm256_loadu_pd(b + 4);
+        for (GLuint r = 0; r < 4; ++r)
+        {
+            __m256d a_rp = _mm256_broadcast_sd(a + r * lda + p);
+            t[r][0] = _mm256_fmadd_pd(a_rp, b0, t[r][0]);
+            t[r][1] = _mm256_fmadd_pd(a_rp, b1, t[r][1]);
+        }
+    }
+
+    __m256d factor = _mm256_set1_pd(alpha);
+    for (GLuint r = 0; r < 4; ++r, c += ldc)
+    {
+        _mm256_storeu_pd(c,     _mm256_fmadd_pd(factor, t[r][0], _mm256_loadu_pd(c)));
+        _mm256_storeu_pd(c + 4, _mm256_fmadd_pd(factor, t[r][1], _mm256_loadu_pd(c + 4)));
+    }
+}
+
+template <>
+inline GLvoid TileUpdate<GLfloat>(GLuint depth, GLfloat alpha,
+                                  const GLfloat *a, GLuint lda,
+                                  const GLfloat *b, GLuint ldb,
+                                  GLfloat *c, GLuint ldc)
+{
+    __m256 t[4][2];
+    for (GLuint r = 0; r < 4; ++r)
+        t[r][0] = t[r][1] = _mm256_setzero_ps();
+
+    for (GLuint p = 0; p < depth; ++p, b += ldb)
+    {
+        __m256 b0 = _mm256_loadu_ps(b), b1 = _mm256_loadu_ps(b + 8);
+        for (GLuint r = 0; r < 4; ++r)
+        {
+            __m256 a_rp = _mm256_broadcast_ss(a + r * lda + p);
+            t[r][0] = _mm256_fmadd_ps(a_rp, b0, t[r][0]);
+            t[r][1] = _mm256_fmadd_ps(a_rp, b1, t[r][1]);
+        }
+    }
+
+    __m256 factor = _mm256_set1_ps(alpha);
+    for (GLuint r = 0; r < 4; ++r, c += ldc)
+    {
+        _mm256_storeu_ps(c,     _mm256_fmadd_ps(factor, t[r][0], _mm256_loadu_ps(c)));
+        _mm256_storeu_ps(c + 8, _mm256_fmadd_ps(factor, t[r][1], _mm256_loadu_ps(c + 8)));
+    }
+}
+#endif
+
+// block sizes: a KB x NB panel of b (at most 256 KB) stays in L2, while a 4 x KB slice of a stays in L1
+static const GLuint MB = 64;
+static const GLuint NB = 512;
+static const GLuint KB = 64;
+
+template <typename T>
+static GLvoid BlockedGEMM(GLuint m, GLuint n, GLuint k,
+                          const T *a, GLuint lda,
+                          const T *b, GLuint ldb,
+                          T *c, GLuint ldc,
+                          GLboolean accumulate,
+                          T alpha)
+{
+    const GLuint w = Tile<T>::COLUMNS;
+
+    if (!accumulate)
+        for (GLuint i = 0; i < m; ++i)
+            memset(c + (size_t)i * ldc, 0, n * sizeof(T));
+
+    for (GLuint jj = 0; jj < n; jj += NB)
+    {
+        GLuint j_end = min(jj + NB, n);
+
+        for (GLuint pp = 0; pp < k; pp += KB)
+        {
+            GLuint p_end = min(pp + KB, k);
+
+            for (GLuint ii = 0; ii < m; ii += MB)
+            {
+                GLuint i_end = min(ii + MB, m);
+
+                GLuint i = ii;
+
+                // full tiles, the remaining columns of each group of 4 rows are updated row by row
+                for (; i + 4 <= i_end; i += 4)
+                {
+                    GLuint j = jj;
+                    for (; j + w <= j_end; j += w)
+                        TileUpdate<T>(p_end - pp, alpha,
+                                      a + (size_t)i * lda + pp, lda,
+                                      b + (size_t)pp * ldb + j, ldb,
+                                      c + (size_t)i * ldc + j, ldc);
+
+                    if (j < j_end)
+                        for (GLuint r = i; r < i + 4; ++r)
+                            for (GLuint p = pp; p < p_end; ++p)
+                                RowUpdate<T>(c + (size_t)r * ldc + j, alpha * a[(size_t)r * lda + p],
+                                             b + (size_t)p * ldb + j, j_end - j);
+                }
+
+                // remaining rows
+                for (; i < i_end; ++i)
+                {
+                    T       *c_row = c + (size_t)i * ldc;
+                    const T *a_row = a + (size_t)i * lda;
+
+                    for (GLuint p = pp; p < p_end; ++p)
+                        RowUpdate<T>(c_row + jj, alpha * a_row[p], b + (size_t)p * ldb + jj, j_end - jj);
+                }
+            }
+        }
+    }
+}
+
+GLvoid cagd::GEMM(GLuint m, GLuint n, GLuint k,
+                  const GLdouble *a, GLuint lda,
+                  const GLdouble *b, GLuint ldb,
+                  GLdouble *c, GLuint ldc,
+                  GLboolean accumulate,
+                  GLdouble alpha)
+{
+    BlockedGEMM<GLdouble>(m, n, k, a, lda, b, ldb, c, ldc, accumulate, alpha);
+}
+
+GLvoid cagd::GEMM(GLuint m, GLuint n, GLuint k,
+                  const GLfloat *a, GLuint lda,
+                  const GLfloat *b, GLuint ldb,
+                  GLfloat *c, GLuint ldc,
+                  GLboolean accumulate,
+                  GLfloat alpha)
+{
+    BlockedGEMM<GLfloat>(m, n, k, a, lda, b, ldb, c, ldc, accumulate, alpha);
+}
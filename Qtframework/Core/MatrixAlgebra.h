@@ -0,0 +1,109 @@
+#pragma once
+
+#include <GL/glew.h>
+#include "DCoordinates3.h"
+#include "Matrices.h"
+
+namespace cagd
+{
+    // the GEMM kernels below view a row of DCoordinate3 elements as 3 consecutive doubles
+    static_assert(sizeof(DCoordinate3) == 3 * sizeof(GLdouble),
+                  "DCoordinate3 has to be laid out as three consecutive GLdouble values");
+
+    //-------------------------------------------------------------------------------------
+    // cache-blocked general matrix multiplication on row-major double arrays
+    //
+    // c = alpha * a * b          if accumulate == GL_FALSE,
+    // c = c + alpha * a * b      otherwise,
+    //
+    // where a is an m x k, b is a k x n, c is an m x n matrix, while lda, ldb, ldc denote the
+    // distances (in doubles) between consecutive rows. The innermost loop runs over contiguous
+    // rows of b and c; it uses AVX2/FMA instructions when the build targets them, otherwise it
+    // is left to the auto-vectorizer of the compiler.
+    //-------------------------------------------------------------------------------------
+    GLvoid GEMM(GLuint m, GLuint n, GLuint k,
+                const GLdouble *a, GLuint lda,
+                const GLdouble *b, GLuint ldb,
+                GLdouble *c, GLuint ldc,
+                GLboolean accumulate = GL_FALSE,
+                GLdouble alpha = 1.0);
+
+    // single precision variant, its vectors hold twice as many elements
+    GLvoid GEMM(GLuint m, GLuint n, GLuint k,
+                const GLfloat *a, GLuint lda,
+                const GLfloat *b, GLuint ldb,
+                GLfloat *c, GLuint ldc,
+                GLboolean accumulate = GL_FALSE,
+                GLfloat alpha = 1.0f);
+
+    // c = a * b, where the elements of b and c are either scalars or Descartes coordinates; the operands may
+    // use different allocators
+    template <class A, class B, class C>
+    GLboolean Multiply(const Matrix<GLdouble, A>& a, const Matrix<GLdouble, B>& b, Matrix<GLdouble, C>& c);
+
+    template <class A, class B, class C>
+    GLboolean Multiply(const Matrix<GLdouble, A>& a, const Matrix<DCoordinate3, B>& b, Matrix<DCoordinate3, C>& c);
+
+    // b = a^T
+    template <typename T, class A, class B>
+    GLvoid Transpose(const Matrix<T, A>& a, Matrix<T, B>& b);
+
+    //---------------------------
+    // implementation of Multiply
+    //---------------------------
+    template <class A, class B, class C>
+    GLboolean Multiply(const Matrix<GLdouble, A>& a, const Matrix<GLdouble, B>& b, Matrix<GLdouble, C>& c)
+    {
+        if (a.GetColumnCount() != b.GetRowCount() ||
+            (const GLvoid*)&c == (const GLvoid*)&a || (const GLvoid*)&c == (const GLvoid*)&b)
+            return GL_FALSE;
+
+        GLuint m = a.GetRowCount(), n = b.GetColumnCount(), k = a.GetColumnCount();
+
+        if (!c.ResizeRows(m) || !c.ResizeColumns(n))
+            return GL_FALSE;
+
+        GEMM(m, n, k, a.GetData(), k, b.GetData(), n, c.GetData(), n);
+
+        return GL_TRUE;
+    }
+
+    template <class A, class B, class C>
+    GLboolean Multiply(const Matrix<GLdouble, A>& a, const Matrix<DCoordinate3, B>& b, Matrix<DCoordinate3, C>& c)
+    {
+        if (a.GetColumnCount() != b.GetRowCount() || (const GLvoid*)&c == (const GLvoid*)&b)
+            return GL_FALSE;
+
+        GLuint m = a.GetRowCount(), n = b.GetColumnCount(), k = a.GetColumnCount();
+
+        if (!c.ResizeRows(m) || !c.ResizeColumns(n))
+            return GL_FALSE;
+
+        // every row of b and c is viewed as a row of 3n doubles
+        GEMM(m, 3 * n, k,
+             a.GetData(), k,
+             reinterpret_cast<const GLdouble*>(b.GetData()), 3 * n,
+             reinterpret_cast<GLdouble*>(c.GetData()), 3 * n);
+
+        return GL_TRUE;
+    }
+
+    //----------------------------
+    // implementation of Transpose
+    //----------------------------
+    template <typename T, class A, class B>
+    GLvoid Transpose(const Matrix<T, A>& a, Matrix<T, B>& b)
+    {
+        GLuint row_count = a.GetRowCount(), column_count = a.GetColumnCount();
+
+        b.ResizeRows(column_count);
+        b.ResizeColumns(row_count);
+
+        const T *source = a.GetData();
+        T *target = b.GetData();
+
+        for (GLuint i = 0; i < row_count; ++i)
+            for (GLuint j = 0; j < column_count; ++j)
+                target[j * row_count + i] = source[i * column_count + j];
+    }
+}
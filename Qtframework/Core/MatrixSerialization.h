@@ -0,0 +1,318 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include "Matrices.h"
+#include "MappedFiles.h"
+
+namespace cagd
+{
+    //----------------------------------------------------------------------------------------
+    // binary format of Matrix<T> and TriangularMatrix<T>
+    //
+    // a fixed size header followed by the raw contiguous element storage of the matrix:
+    //  - 4 byte magic: "CGDM" for dense, "CGDT" for packed lower triangular matrices;
+    //  - format version;
+    //  - byte order tag 0x01020304 written in the native order of the writer;
+    //  - sizeof(T), guarding against reading data that was written with another element type;
+    //  - row and column counts (the column count of a triangular matrix equals its row count).
+    //
+    // Elements are stored bit-exactly, so no precision is lost as opposed to the text operators.
+    // Files written on a machine of different byte order are rejected, just like headers whose counts
+    // exceed the available data; hence loading from a stream requires a seekable one.
+    //----------------------------------------------------------------------------------------
+    struct BinaryMatrixHeader
+    {
+        char    magic[4];
+        GLuint  version;
+        GLuint  byte_order;
+        GLuint  element_size;
+        GLuint  row_count;
+        GLuint  column_count;
+    };
+
+    static const GLuint BINARY_MATRIX_VERSION    = 1;
+    static const GLuint BINARY_MATRIX_BYTE_ORDER = 0x01020304;
+
+    // dense matrices
+    template <typename T, class Allocator>
+    GLboolean SaveBinary(std::ostream& lhs, const Matrix<T, Allocator>& rhs);
+
+    template <typename T, class Allocator>
+    GLboolean LoadBinary(std::istream& lhs, Matrix<T, Allocator>& rhs);
+
+    template <typename T, class Allocator>
+    GLboolean LoadBinary(const MappedFile& file, Matrix<T, Allocator>& rhs);
+
+    // packed lower triangular matrices
+    template <typename T, class Allocator>
+    GLboolean SaveBinary(std::ostream& lhs, const TriangularMatrix<T, Allocator>& rhs);
+
+    template <typename T, class Allocator>
+    GLboolean LoadBinary(std::istream& lhs, TriangularMatrix<T, Allocator>& rhs);
+
+    template <typename T, class Allocator>
+    GLboolean LoadBinary(const MappedFile& file, TriangularMatrix<T, Allocator>& rhs);
+
+    // file based variants, loading goes through a read-only memory mapping of the file
+    template <class M>
+    GLboolean SaveBinary(const std::string& file_name, const M& rhs);
+
+    template <class M>
+    GLboolean LoadBinary(const std::string& file_name, M& rhs);
+
+    //---------------------------------------------------
+    // implementation details shared by both matrix types
+    //---------------------------------------------------
+    namespace binary_matrix
+    {
+        template <typename T>
+        inline BinaryMatrixHeader MakeHeader(const char* magic, GLuint row_count, GLuint column_count)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "binary matrix serialization requires trivially copyable elements");
+
+            BinaryMatrixHeader header;
+            std::memcpy(header.magic, magic, 4);
+            header.version      = BINARY_MATRIX_VERSION;
+            header.byte_order   = BINARY_MATRIX_BYTE_ORDER;
+            header.element_size = (GLuint)sizeof(T);
+            header.row_count    = row_count;
+            header.column_count = column_count;
+            return header;
+        }
+
+        template <typename T>
+        inline GLboolean IsValid(const BinaryMatrixHeader& header, const char* magic)
+        {
+            return std::memcmp(header.magic, magic, 4) == 0 &&
+                   header.version      == BINARY_MATRIX_VERSION &&
+                   header.byte_order   == BINARY_MATRIX_BYTE_ORDER &&
+                   header.element_size == (GLuint)sizeof(T);
+        }
+
+        // the byte size of the element buffer described by the header; fails if the counts of the header are
+        // corrupt, i.e., if the element count cannot be indexed by GLuint (as done by the matrices) or the
+        // byte size cannot be represented by std::size_t
+        template <typename T>
+        inline GLboolean ByteCount(const BinaryMatrixHeader& header, GLboolean triangular, std::size_t& byte_count)
+        {
+            const std::size_t max_count = std::min<std::size_t>(std::numeric_limits<GLuint>::max(),
+                                                                std::numeric_limits<std::size_t>::max() / sizeof(T));
+
+            std::size_t rows = header.row_count, columns = header.column_count;
+
+            // the packed lower triangle stores rows * (rows + 1) / 2 elements, one of the factors is even
+            if (triangular)
+            {
+                columns = rows + 1;
+                if (rows % 2)
+                    columns /= 2;
+                else
+                    rows /= 2;
+            }
+
+            if (columns && rows > max_count / columns)
+                return GL_FALSE;
+
+            byte_count = rows * columns * sizeof(T);
+            return GL_TRUE;
+        }
+
+        // the number of bytes between the current read position and the end of the stream, the position is
+        // left unchanged; fails if the stream is not seekable
+        inline GLboolean RemainingByteCount(std::istream& lhs, std::size_t& byte_count)
+        {
+            std::istream::pos_type current = lhs.tellg();
+            if (current == std::istream::pos_type(-1) || !lhs.seekg(0, std::ios_base::end))
+                return GL_FALSE;
+
+            std::istream::pos_type end = lhs.tellg();
+            if (end == std::istream::pos_type(-1) || !lhs.seekg(current))
+                return GL_FALSE;
+
+            byte_count = (std::size_t)(end - current);
+            return GL_TRUE;
+        }
+
+        // checks the size of the element buffer described by the header against the bytes that follow it
+        template <typename T>
+        inline GLboolean HasData(std::istream& lhs, const BinaryMatrixHeader& header, GLboolean triangular,
+                                 std::size_t& byte_count)
+        {
+            std::size_t remaining_byte_count;
+            return ByteCount<T>(header, triangular, byte_count) &&
+                   RemainingByteCount(lhs, remaining_byte_count) && byte_count <= remaining_byte_count;
+        }
+
+        template <typename T>
+        inline GLboolean HasData(const MappedFile& file, const BinaryMatrixHeader& header, GLboolean triangular,
+                                 std::size_t& byte_count)
+        {
+            return ByteCount<T>(header, triangular, byte_count) &&
+                   byte_count <= file.GetSize() - sizeof(BinaryMatrixHeader);
+        }
+
+        // writes the header and the element buffer with two bulk writes
+        template <typename T>
+        inline GLboolean Write(std::ostream& lhs, const BinaryMatrixHeader& header, const T* data, std::size_t count)
+        {
+            lhs.write((const char*)&header, sizeof(BinaryMatrixHeader));
+            if (count)
+                lhs.write((const char*)data, count * sizeof(T));
+            return (GLboolean)lhs.good();
+        }
+
+        static const char DENSE_MAGIC[]      = "CGDM";
+        static const char TRIANGULAR_MAGIC[] = "CGDT";
+    }
+
+    //---------------------------------------------
+    // implementation of dense matrix serialization
+    //---------------------------------------------
+    template <typename T, class Allocator>
+    GLboolean SaveBinary(std::ostream& lhs, const Matrix<T, Allocator>& rhs)
+    {
+        BinaryMatrixHeader header = binary_matrix::MakeHeader<T>(
+                binary_matrix::DENSE_MAGIC, rhs.GetRowCount(), rhs.GetColumnCount());
+
+        return binary_matrix::Write(lhs, header, rhs.GetData(),
+                                    (std::size_t)rhs.GetRowCount() * rhs.GetColumnCount());
+    }
+
+    template <typename T, class Allocator>
+    GLboolean LoadBinary(std::istream& lhs, Matrix<T, Allocator>& rhs)
+    {
+        BinaryMatrixHeader header;
+        if (!lhs.read((char*)&header, sizeof(BinaryMatrixHeader)) ||
+            !binary_matrix::IsValid<T>(header, binary_matrix::DENSE_MAGIC))
+            return GL_FALSE;
+
+        std::size_t byte_count;
+        if (!binary_matrix::HasData<T>(lhs, header, GL_FALSE, byte_count))
+            return GL_FALSE;
+
+        if (!rhs.ResizeColumns(header.column_count) || !rhs.ResizeRows(header.row_count) ||
+            rhs.GetRowCount() != header.row_count || rhs.GetColumnCount() != header.column_count)
+            return GL_FALSE;
+
+        // a single bulk read straight into the contiguous storage
+        if (byte_count)
+            lhs.read((char*)rhs.GetData(), byte_count);
+
+        return (GLboolean)!lhs.fail();
+    }
+
+    template <typename T, class Allocator>
+    GLboolean LoadBinary(const MappedFile& file, Matrix<T, Allocator>& rhs)
+    {
+        if (!file.IsOpen() || file.GetSize() < sizeof(BinaryMatrixHeader))
+            return GL_FALSE;
+
+        BinaryMatrixHeader header;
+        std::memcpy(&header, file.GetData(), sizeof(BinaryMatrixHeader));
+        std::size_t byte_count;
+        if (!binary_matrix::IsValid<T>(header, binary_matrix::DENSE_MAGIC) ||
+            !binary_matrix::HasData<T>(file, header, GL_FALSE, byte_count))
+            return GL_FALSE;
+
+        if (!rhs.ResizeColumns(header.column_count) || !rhs.ResizeRows(header.row_count) ||
+            rhs.GetRowCount() != header.row_count || rhs.GetColumnCount() != header.column_count)
+            return GL_FALSE;
+
+        if (byte_count)
+            std::memcpy((void*)rhs.GetData(), file.GetData() + sizeof(BinaryMatrixHeader), byte_count);
+
+        return GL_TRUE;
+    }
+
+    //--------------------------------------------------
+    // implementation of triangular matrix serialization
+    //--------------------------------------------------
+    template <typename T, class Allocator>
+    GLboolean SaveBinary(std::ostream& lhs, const TriangularMatrix<T, Allocator>& rhs)
+    {
+        GLuint row_count = rhs.GetRowCount();
+        BinaryMatrixHeader header = binary_matrix::MakeHeader<T>(
+                binary_matrix::TRIANGULAR_MAGIC, row_count, row_count);
+
+        return binary_matrix::Write(lhs, header, rhs.GetData(),
+                                    (std::size_t)row_count * (row_count + 1) / 2);
+    }
+
+    template <typename T, class Allocator>
+    GLboolean LoadBinary(std::istream& lhs, TriangularMatrix<T, Allocator>& rhs)
+    {
+        BinaryMatrixHeader header;
+        if (!lhs.read((char*)&header, sizeof(BinaryMatrixHeader)) ||
+            !binary_matrix::IsValid<T>(header, binary_matrix::TRIANGULAR_MAGIC) ||
+            header.row_count != header.column_count)
+            return GL_FALSE;
+
+        std::size_t byte_count;
+        if (!binary_matrix::HasData<T>(lhs, header, GL_TRUE, byte_count))
+            return GL_FALSE;
+
+        if (!rhs.ResizeRows(header.row_count) || rhs.GetRowCount() != header.row_count)
+            return GL_FALSE;
+
+        if (byte_count)
+            lhs.read((char*)rhs.GetData(), byte_count);
+
+        return (GLboolean)!lhs.fail();
+    }
+
+    template <typename T, class Allocator>
+    GLboolean LoadBinary(const MappedFile& file, TriangularMatrix<T, Allocator>& rhs)
+    {
+        if (!file.IsOpen() || file.GetSize() < sizeof(BinaryMatrixHeader))
+            return GL_FALSE;
+
+        BinaryMatrixHeader header;
+        std::memcpy(&header, file.GetData(), sizeof(BinaryMatrixHeader));
+        if (!binary_matrix::IsValid<T>(header, binary_matrix::TRIANGULAR_MAGIC) ||
+            header.row_count != header.column_count)
+            return GL_FALSE;
+
+        std::size_t byte_count;
+        if (!binary_matrix::HasData<T>(file, header, GL_TRUE, byte_count))
+            return GL_FALSE;
+
+        if (!rhs.ResizeRows(header.row_count) || rhs.GetRowCount() != header.row_count)
+            return GL_FALSE;
+
+        if (byte_count)
+            std::memcpy((void*)rhs.GetData(), file.GetData() + sizeof(BinaryMatrixHeader), byte_count);
+
+        return GL_TRUE;
+    }
+
+    //--------------------------------------
+    // implementation of file based variants
+    //--------------------------------------
+    template <class M>
+    GLboolean SaveBinary(const std::string& file_name, const M& rhs)
+    {
+        std::ofstream f(file_name.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        if (!f || !f.good())
+            return GL_FALSE;
+
+        return SaveBinary(f, rhs);
+    }
+
+    template <class M>
+    GLboolean LoadBinary(const std::string& file_name, M& rhs)
+    {
+        MappedFile file;
+        if (!file.Open(file_name))
+            return GL_FALSE;
+
+        return LoadBinary(file, rhs);
+    }
+}
@@ -0,0 +1,122 @@
+#include "RealBandedMatrices.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace cagd;
+using namespace std;
+
+// special/default constructor
+RealBandedMatrix::RealBandedMatrix(GLuint size, GLuint lower_bandwidth, GLuint upper_bandwidth):
+        _discarded(0.0)
+{
+    Resize(size, lower_bandwidth, upper_bandwidth);
+}
+
+GLboolean RealBandedMatrix::Resize(GLuint size, GLuint lower_bandwidth, GLuint upper_bandwidth)
+{
+    _size                     = size;
+    _lower_bandwidth          = lower_bandwidth;
+    _upper_bandwidth          = upper_bandwidth;
+    _leading_dimension        = 2 * lower_bandwidth + upper_bandwidth + 1;
+    _lu_decomposition_is_done = GL_FALSE;
+
+    _data.assign((size_t)size * _leading_dimension, 0.0);
+    _row_permutation.resize(size);
+
+    return GL_TRUE;
+}
+
+GLuint RealBandedMatrix::GetSize() const
+{
+    return _size;
+}
+
+GLuint RealBandedMatrix::GetLowerBandwidth() const
+{
+    return _lower_bandwidth;
+}
+
+GLuint RealBandedMatrix::GetUpperBandwidth() const
+{
+    return _upper_bandwidth;
+}
+
+GLboolean RealBandedMatrix::IsInBand(GLuint row, GLuint column) const
+{
+    return row < _size && column < _size &&
+           row <= column + _lower_bandwidth && column <= row + _upper_bandwidth;
+}
+
+GLdouble& RealBandedMatrix::operator ()(GLuint row, GLuint column)
+{
+    assert(IsInBand(row, column));
+
+    if (!IsInBand(row, column))
+    {
+        _discarded = 0.0;
+        return _discarded;
+    }
+
+    return _data[column * _leading_dimension + _Offset(row, column)];
+}
+
+GLdouble RealBandedMatrix::operator ()(GLuint row, GLuint column) const
+{
+    return IsInBand(row, column) ? _data[column * _leading_dimension + _Offset(row, column)] : 0.0;
+}
+
+GLboolean RealBandedMatrix::PerformLUDecomposition()
+{
+    GLuint    n = _size, kl = _lower_bandwidth;
+    GLuint    upper_bandwidth = _lower_bandwidth + _upper_bandwidth;
+    GLdouble *a = _data.data();
+
+    for (GLuint k = 0; k < n; ++k)
+    {
+        GLuint    last_row    = min(n - 1, k + kl);
+        GLuint    last_column = min(n - 1, k + upper_bandwidth);
+        GLdouble *a_k         = a + k * _leading_dimension + _Offset(k, k);
+
+        // partial pivoting within the k-th column of the band
+        GLuint   pivot = k;
+        GLdouble big   = fabs(a_k[0]);
+
+        for (GLuint i = k + 1; i <= last_row; ++i)
+        {
+            if (fabs(a_k[i - k]) > big)
+            {
+                big   = fabs(a_k[i - k]);
+                pivot = i;
+            }
+        }
+
+        if (big == 0.0)
+            return GL_FALSE;
+
+        _row_permutation[k] = pivot;
+
+        if (pivot != k)
+            for (GLuint j = k; j <= last_column; ++j)
+                swap(a[j * _leading_dimension + _Offset(k, j)], a[j * _leading_dimension + _Offset(pivot, j)]);
+
+        GLdouble inverse_pivot = 1.0 / a_k[0];
+        for (GLuint i = k + 1; i <= last_row; ++i)
+            a_k[i - k] *= inverse_pivot;
+
+        // rank-1 update of the trailing part of the band, column by column
+        for (GLuint j = k + 1; j <= last_column; ++j)
+        {
+            GLdouble *a_j  = a + j * _leading_dimension + _Offset(k, j);
+            GLdouble  u_kj = a_j[0];
+
+            if (u_kj != 0.0)
+                for (GLuint i = k + 1; i <= last_row; ++i)
+                    a_j[i - k] -= a_k[i - k] * u_kj;
+        }
+    }
+
+    _lu_decomposition_is_done = GL_TRUE;
+
+    return GL_TRUE;
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <vector>
+#include "DCoordinates3.h"
+#include "Matrices.h"
+
+namespace cagd
+{
+    //-----------------------
+    // class RealBandedMatrix
+    //-----------------------
+    // n x n matrices whose non-zero elements lie within lower_bandwidth sub- and upper_bandwidth superdiagonals,
+    // e.g., the coefficient matrices of the continuity conditions of spline curves; only the band is stored,
+    // hence the LU decomposition and the solution of linear systems require O(n) memory and operations
+    // for fixed bandwidths
+    class RealBandedMatrix
+    {
+    private:
+        GLuint                _size;
+        GLuint                _lower_bandwidth;
+        GLuint                _upper_bandwidth;
+        GLuint                _leading_dimension;       // 2 * lower_bandwidth + upper_bandwidth + 1
+        std::vector<GLdouble> _data;                    // column-major band storage, element (r, c) is
+                                                        // _data[c * _leading_dimension + _Offset(r, c)]; the first
+                                                        // lower_bandwidth positions of each column are reserved
+                                                        // for the fill-in of the row interchanges
+        GLboolean             _lu_decomposition_is_done;
+        std::vector<GLuint>   _row_permutation;         // row k was interchanged with row _row_permutation[k]
+        GLdouble              _discarded;               // target of the references to positions outside of the band
+
+        GLuint _Offset(GLuint row, GLuint column) const;
+
+    public:
+        // special/default constructor, creates a null matrix
+        RealBandedMatrix(GLuint size = 1, GLuint lower_bandwidth = 0, GLuint upper_bandwidth = 0);
+
+        // replaces the matrix by a null matrix of the given size and bandwidths
+        GLboolean Resize(GLuint size, GLuint lower_bandwidth, GLuint upper_bandwidth);
+
+        // get properties
+        GLuint GetSize() const;
+        GLuint GetLowerBandwidth() const;
+        GLuint GetUpperBandwidth() const;
+
+        // set, if row - lower_bandwidth <= column <= row + upper_bandwidth
+        GLboolean IsInBand(GLuint row, GLuint column) const;
+
+        // get element by reference, the position has to lie within the band; otherwise an assertion fails in
+        // debug builds, while release builds return a reference to a zeroed dummy element, hence the written
+        // value is discarded instead of overwriting another element or memory outside of the storage
+        GLdouble& operator ()(GLuint row, GLuint column);
+
+        // get element by value, elements outside of the band are zero
+        GLdouble operator ()(GLuint row, GLuint column) const;
+
+        // tries to determine the LU decomposition of this matrix in place, by Gaussian elimination with partial
+        // pivoting restricted to the band; the row interchanges widen the upper band of U by lower_bandwidth
+        GLboolean PerformLUDecomposition();
+
+        // Solves linear systems of type A * x = b, where A is a regular banded matrix, while b and x are row or
+        // column matrices with elements of type T, e.g., GLdouble or DCoordinate3. The decomposition is
+        // performed first, if it has not been done yet.
+        template <class T>
+        GLboolean SolveLinearSystem(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns = GL_TRUE);
+    };
+
+    inline GLuint RealBandedMatrix::_Offset(GLuint row, GLuint column) const
+    {
+        return _lower_bandwidth + _upper_bandwidth + row - column;
+    }
+
+    template <class T>
+    GLboolean RealBandedMatrix::SolveLinearSystem(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns)
+    {
+        if (!_lu_decomposition_is_done)
+            if (!PerformLUDecomposition())
+                return GL_FALSE;
+
+        GLuint n = _size;
+
+        if ((represent_solutions_as_columns ? b.GetRowCount() : b.GetColumnCount()) != n)
+            return GL_FALSE;
+
+        GLuint rhs_count = represent_solutions_as_columns ? b.GetColumnCount() : b.GetRowCount();
+
+        if (represent_solutions_as_columns)
+        {
+            x.ResizeRows(n);
+            x.ResizeColumns(rhs_count);
+        }
+        else
+        {
+            x.ResizeRows(rhs_count);
+            x.ResizeColumns(n);
+        }
+
+        GLuint          upper_bandwidth = _lower_bandwidth + _upper_bandwidth;
+        const GLdouble *lu = _data.data();
+        std::vector<T>  y(n);
+
+        for (GLuint q = 0; q < rhs_count; ++q)
+        {
+            for (GLuint i = 0; i < n; ++i)
+                y[i] = represent_solutions_as_columns ? b(i, q) : b(q, i);
+
+            // L y = P b
+            for (GLuint k = 0; k < n; ++k)
+            {
+                if (_row_permutation[k] != k)
+                    std::swap(y[k], y[_row_permutation[k]]);
+
+                GLuint          last = std::min(n - 1, k + _lower_bandwidth);
+                const GLdouble *l_k  = lu + k * _leading_dimension + _Offset(k, k);
+
+                for (GLuint i = k + 1; i <= last; ++i)
+                    y[i] -= l_k[i - k] * y[k];
+            }
+
+            // U x = y
+            for (GLuint k = n; k-- > 0; )
+            {
+                GLuint last = std::min(n - 1, k + upper_bandwidth);
+                T      sum  = y[k];
+
+                for (GLuint j = k + 1; j <= last; ++j)
+                    sum -= lu[j * _leading_dimension + _Offset(k, j)] * y[j];
+
+                y[k] = sum / lu[k * _leading_dimension + _Offset(k, k)];
+            }
+
+            for (GLuint i = 0; i < n; ++i)
+            {
+                if (represent_solutions_as_columns)
+                    x(i, q) = y[i];
+                else
+                    x(q, i) = y[i];
+            }
+        }
+
+        return GL_TRUE;
+    }
+}
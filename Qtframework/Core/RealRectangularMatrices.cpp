@@ -0,0 +1,278 @@
+#include "RealRectangularMatrices.h"
+#include "MatrixAlgebra.h"
+#include "RealSquareMatrices.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace cagd;
+using namespace std;
+
+// special/default constructor
+RealRectangularMatrix::RealRectangularMatrix(GLuint row_count, GLuint column_count):
+        Matrix<GLdouble>(row_count, column_count),
+        _qr_decomposition_is_done(GL_FALSE),
+        _full_column_rank(GL_FALSE)
+{
+}
+
+GLboolean RealRectangularMatrix::ResizeRows(GLuint row_count)
+{
+    _qr_decomposition_is_done = GL_FALSE;
+    return Matrix<GLdouble>::ResizeRows(row_count);
+}
+
+GLboolean RealRectangularMatrix::ResizeColumns(GLuint column_count)
+{
+    _qr_decomposition_is_done = GL_FALSE;
+    return Matrix<GLdouble>::ResizeColumns(column_count);
+}
+
+GLvoid RealRectangularMatrix::_FactorizePanel(GLuint first_column, GLuint width)
+{
+    GLuint    m = _row_count, n = _column_count;
+    GLdouble *a = _data.data();
+
+    vector<GLdouble> w(width);
+
+    for (GLuint k = first_column; k < first_column + width; ++k)
+    {
+        // reflector H_k = I - tau_k v_k v_k^T that annihilates A[k+1:m, k], where v_k(k) = 1 and the
+        // remaining components of v_k overwrite the annihilated elements
+        GLdouble alpha = a[k * n + k], norm2 = 0.0;
+        for (GLuint i = k + 1; i < m; ++i)
+            norm2 += a[i * n + k] * a[i * n + k];
+
+        if (norm2 == 0.0)
+        {
+            _tau[k] = 0.0;
+            continue;
+        }
+
+        GLdouble beta = -copysign(sqrt(alpha * alpha + norm2), alpha);
+        _tau[k] = (beta - alpha) / beta;
+
+        GLdouble scale = 1.0 / (alpha - beta);
+        for (GLuint i = k + 1; i < m; ++i)
+            a[i * n + k] *= scale;
+        a[k * n + k] = beta;
+
+        // applying H_k to the remaining columns of the panel, row by row
+        GLuint j_begin = k + 1, j_end = first_column + width;
+        if (j_begin == j_end)
+            continue;
+
+        for (GLuint j = j_begin; j < j_end; ++j)
+            w[j - j_begin] = a[k * n + j];
+
+        for (GLuint i = k + 1; i < m; ++i)
+        {
+            GLdouble v_i = a[i * n + k];
+            for (GLuint j = j_begin; j < j_end; ++j)
+                w[j - j_begin] += v_i * a[i * n + j];
+        }
+
+        for (GLuint j = j_begin; j < j_end; ++j)
+            w[j - j_begin] *= _tau[k];
+
+        for (GLuint j = j_begin; j < j_end; ++j)
+            a[k * n + j] -= w[j - j_begin];
+
+        for (GLuint i = k + 1; i < m; ++i)
+        {
+            GLdouble v_i = a[i * n + k];
+            for (GLuint j = j_begin; j < j_end; ++j)
+                a[i * n + j] -= v_i * w[j - j_begin];
+        }
+    }
+}
+
+GLvoid RealRectangularMatrix::_CalculateBlockReflector(GLuint first_column, GLuint width)
+{
+    GLuint          m = _row_count, n = _column_count;
+    const GLdouble *a = _data.data();
+    GLdouble       *t = _block_reflectors.data() + (first_column / QR_BLOCK_SIZE) * QR_BLOCK_SIZE * QR_BLOCK_SIZE;
+
+    // forward columnwise recurrence: T(0:q, q) = -tau_q T(0:q, 0:q) V(:, 0:q)^T v_q and T(q, q) = tau_q
+    vector<GLdouble> z(width);
+
+    for (GLuint q = 0; q < width; ++q)
+    {
+        GLuint k = first_column + q;
+
+        // z(p) = v_p^T v_q, where v_p vanishes above its unit component p, i.e., the sum starts at row k
+        for (GLuint p = 0; p < q; ++p)
+            z[p] = a[k * n + first_column + p];
+
+        for (GLuint i = k + 1; i < m; ++i)
+        {
+            GLdouble v_iq = a[i * n + k];
+            for (GLuint p = 0; p < q; ++p)
+                z[p] += a[i * n + first_column + p] * v_iq;
+        }
+
+        for (GLuint p = 0; p < q; ++p)
+        {
+            GLdouble sum = 0.0;
+            for (GLuint r = p; r < q; ++r)
+                sum += t[p * QR_BLOCK_SIZE + r] * z[r];
+            t[p * QR_BLOCK_SIZE + q] = -_tau[k] * sum;
+        }
+
+        t[q * QR_BLOCK_SIZE + q] = _tau[k];
+
+        for (GLuint p = q + 1; p < QR_BLOCK_SIZE; ++p)
+            t[p * QR_BLOCK_SIZE + q] = 0.0;
+    }
+}
+
+GLvoid RealRectangularMatrix::_ApplyTransposedBlockReflector(GLuint first_column, GLuint width,
+                                                             GLdouble *c, GLuint ldc, GLuint column_count) const
+{
+    GLuint          m = _row_count, n = _column_count;
+    GLuint          row_count = m - first_column;
+    const GLdouble *a = _data.data();
+    const GLdouble *t = _block_reflectors.data() + (first_column / QR_BLOCK_SIZE) * QR_BLOCK_SIZE * QR_BLOCK_SIZE;
+
+    ArenaScope scope;
+
+    // explicit copies of V (with its unit diagonal and zero upper triangle) and of its transpose, as well as
+    // of T^T, such that all products are performed by GEMM
+    ArenaMatrix<GLdouble> v(row_count, width), v_transposed(width, row_count), t_transposed(width, width);
+
+    for (GLuint i = 0; i < row_count; ++i)
+    {
+        for (GLuint q = 0; q < width; ++q)
+        {
+            GLdouble v_iq = (i == q) ? 1.0 : (i < q ? 0.0 : a[(first_column + i) * n + first_column + q]);
+            v(i, q) = v_iq;
+            v_transposed(q, i) = v_iq;
+        }
+    }
+
+    for (GLuint p = 0; p < width; ++p)
+        for (GLuint q = 0; q < width; ++q)
+            t_transposed(p, q) = t[q * QR_BLOCK_SIZE + p];
+
+    // c -= V (T^T (V^T c))
+    ArenaMatrix<GLdouble> w(width, column_count), y(width, column_count);
+
+    GEMM(width, column_count, row_count, v_transposed.GetData(), row_count, c, ldc, w.GetData(), column_count);
+    GEMM(width, column_count, width, t_transposed.GetData(), width, w.GetData(), column_count, y.GetData(), column_count);
+    GEMM(row_count, column_count, width, v.GetData(), width, y.GetData(), column_count, c, ldc, GL_TRUE, -1.0);
+}
+
+GLboolean RealRectangularMatrix::PerformQRDecomposition()
+{
+    if (_qr_decomposition_is_done)
+        return _full_column_rank;
+
+    GLuint m = _row_count, n = _column_count;
+
+    if (!n || m < n)
+        return GL_FALSE;
+
+    _tau.assign(n, 0.0);
+    _block_reflectors.assign(((n + QR_BLOCK_SIZE - 1) / QR_BLOCK_SIZE) * QR_BLOCK_SIZE * QR_BLOCK_SIZE, 0.0);
+
+    //-------------------------------------------------------------------------------------
+    // right-looking blocked Householder QR decomposition: for each block column [k0, k1)
+    //
+    //  1. the panel A[k0:m, k0:k1] is reduced by unblocked Householder reflections;
+    //  2. the product of the reflections is represented as I - V T V^T (compact WY form);
+    //  3. the trailing submatrix A[k0:m, k1:n] is multiplied by (I - V T V^T)^T = I - V T^T V^T
+    //     by means of three GEMM calls, column block by column block.
+    //
+    // R overwrites the upper triangle, while the essential parts of the Householder vectors
+    // are stored below the diagonal. The factors T are kept for the least squares solutions.
+    //-------------------------------------------------------------------------------------
+    GLint thread_count = (GLint)RealSquareMatrix::GetThreadCount();
+
+    for (GLuint k0 = 0; k0 < n; k0 += QR_BLOCK_SIZE)
+    {
+        GLuint k1 = min(k0 + QR_BLOCK_SIZE, n);
+
+        _FactorizePanel(k0, k1 - k0);
+        _CalculateBlockReflector(k0, k1 - k0);
+
+        if (k1 == n)
+            break;
+
+        GLint     trailing_width = (GLint)(n - k1);
+        GLboolean parallel = (thread_count > 1 && trailing_width > (GLint)COLUMN_BLOCK_WIDTH &&
+                              m - k0 >= PARALLEL_SIZE_THRESHOLD);
+        (void)parallel;
+
+        #pragma omp parallel for num_threads(thread_count) schedule(dynamic) if(parallel)
+        for (GLint j0 = 0; j0 < trailing_width; j0 += (GLint)COLUMN_BLOCK_WIDTH)
+        {
+            GLuint j_begin = k1 + j0, j_end = min(j_begin + COLUMN_BLOCK_WIDTH, n);
+
+            _ApplyTransposedBlockReflector(k0, k1 - k0, _data.data() + k0 * n + j_begin, n, j_end - j_begin);
+        }
+    }
+
+    _qr_decomposition_is_done = GL_TRUE;
+
+    // the diagonal elements of R are compared to the largest one
+    GLdouble largest = 0.0;
+    for (GLuint i = 0; i < n; ++i)
+        largest = max(largest, fabs(_data[i * n + i]));
+
+    GLdouble tolerance = m * numeric_limits<GLdouble>::epsilon() * largest;
+
+    _full_column_rank = (largest > 0.0);
+    for (GLuint i = 0; i < n && _full_column_rank; ++i)
+        if (fabs(_data[i * n + i]) <= tolerance)
+            _full_column_rank = GL_FALSE;
+
+    return _full_column_rank;
+}
+
+GLvoid RealRectangularMatrix::_ApplyTransposedQ(GLdouble *c, GLuint column_count) const
+{
+    GLuint m = _row_count, n = _column_count;
+
+    // Q^T = (H_1 H_2 ... H_n)^T, i.e., the blocks are applied in increasing order; the right-hand sides are
+    // independent of each other
+    GLint     thread_count = (GLint)RealSquareMatrix::GetThreadCount();
+    GLboolean parallel = (thread_count > 1 && column_count > COLUMN_BLOCK_WIDTH && m >= PARALLEL_SIZE_THRESHOLD);
+    (void)parallel;
+
+    #pragma omp parallel for num_threads(thread_count) schedule(static) if(parallel)
+    for (GLint c0 = 0; c0 < (GLint)column_count; c0 += (GLint)COLUMN_BLOCK_WIDTH)
+    {
+        GLuint c_end = min((GLuint)c0 + COLUMN_BLOCK_WIDTH, column_count);
+
+        for (GLuint k0 = 0; k0 < n; k0 += QR_BLOCK_SIZE)
+        {
+            GLuint k1 = min(k0 + QR_BLOCK_SIZE, n);
+
+            _ApplyTransposedBlockReflector(k0, k1 - k0, c + k0 * column_count + c0, column_count, c_end - c0);
+        }
+    }
+}
+
+GLvoid RealRectangularMatrix::_BackSubstitute(GLdouble *c, GLuint column_count) const
+{
+    GLuint          n = _column_count;
+    const GLdouble *r = _data.data();
+
+    for (GLuint i = n; i-- > 0; )
+    {
+        GLdouble *c_i = c + i * column_count;
+
+        for (GLuint j = i + 1; j < n; ++j)
+        {
+            GLdouble        r_ij = r[i * n + j];
+            const GLdouble *c_j  = c + j * column_count;
+
+            for (GLuint k = 0; k < column_count; ++k)
+                c_i[k] -= r_ij * c_j[k];
+        }
+
+        GLdouble r_ii = r[i * n + i];
+        for (GLuint k = 0; k < column_count; ++k)
+            c_i[k] /= r_ii;
+    }
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <vector>
+#include "Arenas.h"
+#include "DCoordinates3.h"
+#include "Matrices.h"
+
+namespace cagd
+{
+    //----------------------------
+    // class RealRectangularMatrix
+    //----------------------------
+    // m x n matrices (m >= n) of full column rank, whose QR decomposition provides the solutions of
+    // overdetermined linear systems in the least squares sense, e.g., the control points of curves and
+    // surfaces that approximate more sample points than they have control points
+    class RealRectangularMatrix: public Matrix<GLdouble>
+    {
+    private:
+        GLboolean             _qr_decomposition_is_done;
+        GLboolean             _full_column_rank;
+        std::vector<GLdouble> _tau;                 // scalar factors of the Householder reflectors
+        std::vector<GLdouble> _block_reflectors;    // upper triangular QR_BLOCK_SIZE x QR_BLOCK_SIZE factors T
+
+        // column count of the panels of the blocked QR decomposition
+        static const GLuint QR_BLOCK_SIZE = 32;
+
+        // column count of the blocks of right-hand sides, resp. trailing columns shared among the threads
+        static const GLuint COLUMN_BLOCK_WIDTH = 96;
+
+        // systems with fewer rows than this are always processed by a single thread
+        static const GLuint PARALLEL_SIZE_THRESHOLD = 256;
+
+        // Householder reflections of the columns [first_column, first_column + width) within the panel
+        GLvoid _FactorizePanel(GLuint first_column, GLuint width);
+
+        // calculates the upper triangular factor T of the panel, such that H_1 H_2 ... H_width = I - V T V^T
+        GLvoid _CalculateBlockReflector(GLuint first_column, GLuint width);
+
+        // c = (I - V T V^T)^T c, where c is the row-major (m - first_column) x column_count array of leading
+        // dimension ldc, and V, T belong to the panel that starts at first_column
+        GLvoid _ApplyTransposedBlockReflector(GLuint first_column, GLuint width,
+                                              GLdouble *c, GLuint ldc, GLuint column_count) const;
+
+        // c = Q^T c, where c is a row-major m x column_count array
+        GLvoid _ApplyTransposedQ(GLdouble *c, GLuint column_count) const;
+
+        // solves R x = c in place, where c is a row-major array, whose first n rows are considered
+        GLvoid _BackSubstitute(GLdouble *c, GLuint column_count) const;
+
+        // access of the components of the right-hand sides
+        static GLuint    _ComponentCount(const GLdouble*);
+        static GLuint    _ComponentCount(const DCoordinate3*);
+        static GLdouble& _Component(GLdouble& value, GLuint component);
+        static GLdouble& _Component(DCoordinate3& value, GLuint component);
+
+    public:
+        // special/default constructor
+        RealRectangularMatrix(GLuint row_count = 1, GLuint column_count = 1);
+
+        // resizing invalidates the decomposition
+        GLboolean ResizeRows(GLuint row_count);
+        GLboolean ResizeColumns(GLuint column_count);
+
+        // tries to determine the blocked Householder QR decomposition A = Q R of this matrix in place;
+        // fails if the row count is less than the column count, or if the matrix does not have (numerically)
+        // full column rank
+        GLboolean PerformQRDecomposition();
+
+        // Determines the least squares solutions of the overdetermined linear systems A * x = b, i.e., x
+        // minimizes ||A * x - b||_2, where b has m and x has n rows (resp. columns if the solutions are
+        // represented as rows). T can be either GLdouble or DCoordinate3. All right-hand sides are first
+        // transformed by Q^T at once, then R x = (Q^T b)[0:n] is solved by back substitution.
+        template <class T>
+        GLboolean SolveLeastSquares(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns = GL_TRUE);
+    };
+
+    template <class T>
+    GLboolean RealRectangularMatrix::SolveLeastSquares(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns)
+    {
+        if (!_qr_decomposition_is_done)
+            if (!PerformQRDecomposition())
+                return GL_FALSE;
+
+        if (!_full_column_rank)
+            return GL_FALSE;
+
+        GLuint m = _row_count, n = _column_count;
+
+        if ((represent_solutions_as_columns ? b.GetRowCount() : b.GetColumnCount()) != m)
+            return GL_FALSE;
+
+        GLuint rhs_count       = represent_solutions_as_columns ? b.GetColumnCount() : b.GetRowCount();
+        GLuint component_count = _ComponentCount(b.GetData());
+        GLuint width           = component_count * rhs_count;
+
+        // the components of all right-hand sides are gathered into the columns of a row-major array
+        ArenaScope scope;
+        ArenaMatrix<GLdouble> c(m, width);
+
+        for (GLuint i = 0; i < m; ++i)
+        {
+            for (GLuint k = 0; k < rhs_count; ++k)
+            {
+                T b_ik = represent_solutions_as_columns ? b(i, k) : b(k, i);
+                for (GLuint q = 0; q < component_count; ++q)
+                    c(i, component_count * k + q) = _Component(b_ik, q);
+            }
+        }
+
+        _ApplyTransposedQ(c.GetData(), width);
+        _BackSubstitute(c.GetData(), width);
+
+        if (represent_solutions_as_columns)
+        {
+            x.ResizeRows(n);
+            x.ResizeColumns(rhs_count);
+        }
+        else
+        {
+            x.ResizeRows(rhs_count);
+            x.ResizeColumns(n);
+        }
+
+        for (GLuint i = 0; i < n; ++i)
+        {
+            for (GLuint k = 0; k < rhs_count; ++k)
+            {
+                T &x_ik = represent_solutions_as_columns ? x(i, k) : x(k, i);
+                for (GLuint q = 0; q < component_count; ++q)
+                    _Component(x_ik, q) = c(i, component_count * k + q);
+            }
+        }
+
+        return GL_TRUE;
+    }
+
+    inline GLuint RealRectangularMatrix::_ComponentCount(const GLdouble*)
+    {
+        return 1;
+    }
+
+    inline GLuint RealRectangularMatrix::_ComponentCount(const DCoordinate3*)
+    {
+        return 3;
+    }
+
+    inline GLdouble& RealRectangularMatrix::_Component(GLdouble& value, GLuint)
+    {
+        return value;
+    }
+
+    inline GLdouble& RealRectangularMatrix::_Component(DCoordinate3& value, GLuint component)
+    {
+        return value[component];
+    }
+}
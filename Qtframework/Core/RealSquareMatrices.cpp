@@ -1,17 +1,44 @@
 #include "RealSquareMatrices.h"
+#include "MatrixAlgebra.h"
+#include "SmallLinearSystems.h"
+#include <algorithm>
+#include <cfloat>
+#include <thread>
 
 using namespace cagd;
 using namespace std;
 
+GLuint RealSquareMatrix::_thread_count = 0;
+
+GLvoid RealSquareMatrix::SetThreadCount(GLuint thread_count)
+{
+    _thread_count = thread_count;
+}
+
+GLuint RealSquareMatrix::GetThreadCount()
+{
+    if (_thread_count)
+        return _thread_count;
+
+    GLuint hardware_thread_count = thread::hardware_concurrency();
+    return hardware_thread_count ? hardware_thread_count : 1;
+}
+
 RealSquareMatrix::RealSquareMatrix(GLuint size):
         Matrix<GLdouble>(size, size),
-        _lu_decomposition_is_done(GL_FALSE)
+        _lu_decomposition_is_done(GL_FALSE),
+        _precision(DOUBLE_PRECISION),
+        _single_precision_factors(GL_FALSE),
+        _norm(0.0),
+        _residual(-1.0)
 {
 }
 //mine
 
 RealSquareMatrix::RealSquareMatrix(const RealSquareMatrix& m): Matrix<GLdouble>(m),
-  _lu_decomposition_is_done(m._lu_decomposition_is_done),_row_permutation(m._row_permutation){
+  _lu_decomposition_is_done(m._lu_decomposition_is_done),_row_permutation(m._row_permutation),
+  _precision(m._precision),_single_precision_factors(m._single_precision_factors),
+  _single_precision_lu(m._single_precision_lu),_norm(m._norm),_residual(m._residual){
 }
 
 
@@ -25,10 +52,39 @@ RealSquareMatrix& RealSquareMatrix::operator =(const RealSquareMatrix& rhs){
       Matrix<GLdouble>::operator=(rhs);
     _lu_decomposition_is_done=rhs._lu_decomposition_is_done;
     _row_permutation=rhs._row_permutation;
+    _precision=rhs._precision;
+    _single_precision_factors=rhs._single_precision_factors;
+    _single_precision_lu=rhs._single_precision_lu;
+    _norm=rhs._norm;
+    _residual=rhs._residual;
     }
   return *this;
 }
 
+RealSquareMatrix::RealSquareMatrix(RealSquareMatrix&& m) noexcept: Matrix<GLdouble>(std::move(m)),
+  _lu_decomposition_is_done(m._lu_decomposition_is_done),_row_permutation(std::move(m._row_permutation)),
+  _precision(m._precision),_single_precision_factors(m._single_precision_factors),
+  _single_precision_lu(std::move(m._single_precision_lu)),_norm(m._norm),_residual(m._residual){
+  m._lu_decomposition_is_done = GL_FALSE;
+  m._single_precision_factors = GL_FALSE;
+}
+
+RealSquareMatrix& RealSquareMatrix::operator =(RealSquareMatrix&& rhs) noexcept{
+  if(this != &rhs){
+    Matrix<GLdouble>::operator=(std::move(rhs));
+    _lu_decomposition_is_done=rhs._lu_decomposition_is_done;
+    _row_permutation=std::move(rhs._row_permutation);
+    _precision=rhs._precision;
+    _single_precision_factors=rhs._single_precision_factors;
+    _single_precision_lu=std::move(rhs._single_precision_lu);
+    _norm=rhs._norm;
+    _residual=rhs._residual;
+    rhs._lu_decomposition_is_done = GL_FALSE;
+    rhs._single_precision_factors = GL_FALSE;
+  }
+  return *this;
+}
+
 GLboolean RealSquareMatrix::ResizeRows(GLuint row_count){
 
 //  _data.resize(row_count,std::vector<GLdouble>(row_count));
@@ -52,33 +108,58 @@ GLboolean RealSquareMatrix::ResizeColumns(GLuint row_count){
 }
 //EOF mine
 
-GLboolean RealSquareMatrix::PerformLUDecomposition()
+GLboolean RealSquareMatrix::SetPrecision(Precision precision)
 {
     if (_lu_decomposition_is_done)
-        return GL_TRUE;
-
-    if (_row_count <= 1)
         return GL_FALSE;
 
-    const GLdouble tiny = numeric_limits<GLdouble>::min();
+    _precision = precision;
 
-    GLuint size = (GLuint)_data.size();
-    vector<GLdouble> implicit_scaling_of_each_row(size);
+    return GL_TRUE;
+}
 
-    _row_permutation.resize(size);
+RealSquareMatrix::Precision RealSquareMatrix::GetPrecision() const
+{
+    return _precision;
+}
+
+GLboolean RealSquareMatrix::HasSinglePrecisionFactors() const
+{
+    return _single_precision_factors;
+}
+
+GLdouble RealSquareMatrix::GetResidual() const
+{
+    return _residual;
+}
+
+GLdouble RealSquareMatrix::_Magnitude(GLdouble value)
+{
+    return abs(value);
+}
+
+GLdouble RealSquareMatrix::_Magnitude(const DCoordinate3& value)
+{
+    return max(abs(value[0]), max(abs(value[1]), abs(value[2])));
+}
 
-    GLdouble row_interchanges = 1.0;
+GLboolean RealSquareMatrix::_CalculateImplicitScaling(vector<GLdouble>& implicit_scaling_of_each_row) const
+{
+    GLuint size = _row_count;
+
+    implicit_scaling_of_each_row.resize(size);
 
     //-------------------------------------------------------
     // loop over rows to get the implicit scaling information
     //-------------------------------------------------------
-    vector<GLdouble>::iterator its = implicit_scaling_of_each_row.begin();
-    for (vector<vector<GLdouble> >::const_iterator itr = _data.begin(); itr < _data.end(); ++itr)
+    for (GLuint i = 0; i < size; ++i)
     {
+        const GLdouble *row_i = &_data[i * size];
+
         GLdouble big = 0.0;
-        for (vector<GLdouble>::const_iterator itc = itr->begin(); itc < itr->end(); ++itc)
+        for (GLuint j = 0; j < size; ++j)
         {
-            GLdouble temp = abs(*itc);
+            GLdouble temp = abs(row_i[j]);
             if (temp > big)
                     big = temp;
         }
@@ -88,20 +169,31 @@ GLboolean RealSquareMatrix::PerformLUDecomposition()
             // the matrix is singular
             return GL_FALSE;
         }
-        *its = 1.0 / big;
-        ++its;
+        implicit_scaling_of_each_row[i] = 1.0 / big;
     }
 
-    //-----------------------------------
+    return GL_TRUE;
+}
+
+// factorizes the columns [first_column, last_column) of the not yet reduced rows; row interchanges are applied
+// to whole rows, while the elimination only updates the columns of the panel
+template <typename F>
+GLvoid RealSquareMatrix::_FactorizePanel(F *lu, GLuint first_column, GLuint last_column, vector<GLdouble>& implicit_scaling_of_each_row)
+{
+    const F tiny = numeric_limits<F>::min();
+
+    GLuint size = _row_count;
+
+    //-------------------------------------
     // search for the largest pivot element
-    //-----------------------------------
-    for (GLuint k = 0; k < size; ++k)
+    //-------------------------------------
+    for (GLuint k = first_column; k < last_column; ++k)
     {
         GLuint imax = k;
         GLdouble big = 0.0;
         for (GLuint i = k; i < size; ++i)
         {
-            GLdouble temp = implicit_scaling_of_each_row[i] * abs(_data[i][k]);
+            GLdouble temp = implicit_scaling_of_each_row[i] * abs(lu[i * size + k]);
             if (temp > big)
             {
                 big = temp;
@@ -109,37 +201,211 @@ GLboolean RealSquareMatrix::PerformLUDecomposition()
             }
         }
 
+        F *row_k = lu + k * size;
+
         // do we need to interchange rows?
         if (k != imax)
         {
-            for (GLuint j = 0; j < size; ++j)
-            {
-                GLdouble temp = _data[imax][j];
-                _data[imax][j] = _data[k][j];
-                _data[k][j] = temp;
-            }
-            // change the parity of row_interchanges
-            row_interchanges = -row_interchanges;
+            swap_ranges(row_k, row_k + size, lu + imax * size);
             // also interchange the scale factor
             implicit_scaling_of_each_row[imax] = implicit_scaling_of_each_row[k];
         }
 
         _row_permutation[k] = imax;
-        if (_data[k][k] == 0.0)
-            _data[k][k] = tiny;
+        if (row_k[k] == F(0))
+            row_k[k] = tiny;
 
         for (GLuint i = k + 1; i < size; ++i)
         {
+            F *row_i = lu + i * size;
+
             // divide by pivot element
-            GLdouble temp = _data[i][k] /= _data[k][k];
+            F temp = row_i[k] /= row_k[k];
 
-            // reduce remaining submatrix
-            for (GLuint j = k + 1; j < size; ++j)
-                _data[i][j] -= temp * _data[k][j];
+            // reduce the remaining columns of the panel, both rows are contiguous in memory
+            for (GLuint j = k + 1; j < last_column; ++j)
+                row_i[j] -= temp * row_k[j];
         }
     }
+}
+
+template <typename F>
+GLvoid RealSquareMatrix::_FactorizeBlocked(F *lu, vector<GLdouble>& implicit_scaling_of_each_row)
+{
+    GLuint size = _row_count;
+
+    _row_permutation.resize(size);
+
+    //-------------------------------------------------------------------------------------
+    // right-looking blocked elimination: for each block column [k0, k1)
+    //
+    //  1. the panel A[k0:n, k0:k1] is factorized (with partial pivoting) into L11, L21;
+    //  2. the block row U12 = L11^{-1} A[k0:k1, k1:n] is obtained by forward substitution;
+    //  3. the trailing submatrix A[k1:n, k1:n] -= L21 * U12 is updated by the blocked GEMM.
+    //
+    // Matrices of at most LU_BLOCK_SIZE rows consist of a single panel, i.e., they are
+    // factorized by the classical unblocked algorithm.
+    //
+    // Steps 2 and 3 are split into independent column, resp. row blocks that are shared
+    // among the threads, while the panel factorization remains sequential.
+    //-------------------------------------------------------------------------------------
+    GLint thread_count = (GLint)GetThreadCount();
+
+    for (GLuint k0 = 0; k0 < size; k0 += LU_BLOCK_SIZE)
+    {
+        GLuint k1 = min(k0 + LU_BLOCK_SIZE, size);
+
+        _FactorizePanel(lu, k0, k1, implicit_scaling_of_each_row);
+
+        if (k1 == size)
+            break;
+
+        GLint trailing_size = (GLint)(size - k1);
+        GLboolean parallel  = (thread_count > 1 && trailing_size >= (GLint)PARALLEL_SIZE_THRESHOLD);
+        (void)parallel;
+
+        // U12, the unit lower triangular L11 is applied row by row within each column block
+        #pragma omp parallel for num_threads(thread_count) schedule(static) if(parallel)
+        for (GLint j0 = 0; j0 < trailing_size; j0 += (GLint)LU_BLOCK_SIZE)
+        {
+            GLuint j_begin = k1 + j0, j_end = min(j_begin + LU_BLOCK_SIZE, size);
+
+            for (GLuint k = k0; k < k1; ++k)
+            {
+                const F *row_k = lu + k * size;
+                for (GLuint i = k + 1; i < k1; ++i)
+                {
+                    F *row_i = lu + i * size;
+                    F  l_ik  = row_i[k];
+                    for (GLuint j = j_begin; j < j_end; ++j)
+                        row_i[j] -= l_ik * row_k[j];
+                }
+            }
+        }
+
+        // A22 -= L21 * U12, row block by row block
+        #pragma omp parallel for num_threads(thread_count) schedule(dynamic) if(parallel)
+        for (GLint i0 = 0; i0 < trailing_size; i0 += (GLint)LU_BLOCK_SIZE)
+        {
+            GLuint i_begin = k1 + i0, i_end = min(i_begin + LU_BLOCK_SIZE, size);
+
+            GEMM(i_end - i_begin, size - k1, k1 - k0,
+                 lu + i_begin * size + k0, size,
+                 lu + k0 * size + k1, size,
+                 lu + i_begin * size + k1, size,
+                 GL_TRUE, F(-1));
+        }
+    }
+}
+
+GLboolean RealSquareMatrix::_PerformDoublePrecisionLUDecomposition()
+{
+    vector<GLdouble> implicit_scaling_of_each_row;
+
+    if (!_CalculateImplicitScaling(implicit_scaling_of_each_row))
+        return GL_FALSE;
+
+    _FactorizeBlocked(_data.data(), implicit_scaling_of_each_row);
+
+    _single_precision_factors = GL_FALSE;
+    _single_precision_lu.clear();
+    _single_precision_lu.shrink_to_fit();
 
     _lu_decomposition_is_done = GL_TRUE;
 
     return GL_TRUE;
 }
+
+// the original matrix is kept by _data for the residuals of the iterative refinement
+GLboolean RealSquareMatrix::_PerformMixedPrecisionLUDecomposition()
+{
+    vector<GLdouble> implicit_scaling_of_each_row;
+
+    if (!_CalculateImplicitScaling(implicit_scaling_of_each_row))
+        return GL_FALSE;
+
+    GLuint size = _row_count;
+
+    _single_precision_lu.resize(size * size);
+    _norm = 0.0;
+
+    for (GLuint i = 0; i < size; ++i)
+    {
+        const GLdouble *row_i = &_data[i * size];
+        GLfloat        *lu_i  = &_single_precision_lu[i * size];
+
+        GLdouble row_sum = 0.0;
+        for (GLuint j = 0; j < size; ++j)
+        {
+            GLdouble magnitude = abs(row_i[j]);
+
+            // out of the single precision range
+            if (magnitude > FLT_MAX)
+                return _PerformDoublePrecisionLUDecomposition();
+
+            lu_i[j]  = (GLfloat)row_i[j];
+            row_sum += magnitude;
+        }
+
+        _norm = max(_norm, row_sum);
+    }
+
+    _FactorizeBlocked(_single_precision_lu.data(), implicit_scaling_of_each_row);
+
+    _single_precision_factors = GL_TRUE;
+    _lu_decomposition_is_done = GL_TRUE;
+
+    return GL_TRUE;
+}
+
+// dispatches to the unrolled kernel of the matching size
+GLboolean RealSquareMatrix::_PerformFixedSizeLUDecomposition()
+{
+    _row_permutation.resize(_row_count);
+
+    GLdouble *lu          = _data.data();
+    GLuint   *permutation = _row_permutation.data();
+
+    GLboolean regular = GL_FALSE;
+
+    switch (_row_count)
+    {
+    case 2: regular = FixedSizeLU<2>::Decompose(lu, permutation); break;
+    case 3: regular = FixedSizeLU<3>::Decompose(lu, permutation); break;
+    case 4: regular = FixedSizeLU<4>::Decompose(lu, permutation); break;
+    case 5: regular = FixedSizeLU<5>::Decompose(lu, permutation); break;
+    case 6: regular = FixedSizeLU<6>::Decompose(lu, permutation); break;
+    case 7: regular = FixedSizeLU<7>::Decompose(lu, permutation); break;
+    case 8: regular = FixedSizeLU<8>::Decompose(lu, permutation); break;
+    default: return _PerformDoublePrecisionLUDecomposition();
+    }
+
+    if (!regular)
+        return GL_FALSE;
+
+    _single_precision_factors = GL_FALSE;
+    _single_precision_lu.clear();
+
+    _lu_decomposition_is_done = GL_TRUE;
+
+    return GL_TRUE;
+}
+
+GLboolean RealSquareMatrix::PerformLUDecomposition()
+{
+    if (_lu_decomposition_is_done)
+        return GL_TRUE;
+
+    if (_row_count <= 1)
+        return GL_FALSE;
+
+    _residual = -1.0;
+
+    if (_row_count <= FIXED_SIZE_LIMIT)
+        return _PerformFixedSizeLUDecomposition();
+
+    if (_precision == MIXED_PRECISION)
+        return _PerformMixedPrecisionLUDecomposition();
+
+    return _PerformDoublePrecisionLUDecomposition();
+}
@@ -1,17 +1,94 @@
 #pragma once
 
 #include <GL/glew.h>
-#include <limits>
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include "Arenas.h"
+#include "MatrixAlgebra.h"
+#include "DCoordinates3.h"
 #include "Matrices.h"
 
 namespace cagd
 {
     class RealSquareMatrix: public Matrix<GLdouble>
     {
+    public:
+        // arithmetic of the LU decomposition: MIXED_PRECISION factorizes a single precision copy of the matrix
+        // and refines the solutions of SolveLinearSystem in double precision
+        enum Precision {DOUBLE_PRECISION, MIXED_PRECISION};
+
     private:
-        GLboolean           _lu_decomposition_is_done;
-        std::vector<GLuint> _row_permutation;
+        GLboolean            _lu_decomposition_is_done;
+        std::vector<GLuint>  _row_permutation;
+
+        Precision            _precision;
+        GLboolean            _single_precision_factors; // if set, the factors are stored by _single_precision_lu,
+                                                        // while _data still stores the original matrix
+        std::vector<GLfloat> _single_precision_lu;
+        GLdouble             _norm;                     // maximum absolute row sum of the original matrix
+        GLdouble             _residual;                 // relative residual of the latest refined solution
+
+        // column count of the panels of the blocked LU decomposition
+        static const GLuint LU_BLOCK_SIZE = 64;
+
+        // systems smaller than this are always processed by a single thread
+        static const GLuint PARALLEL_SIZE_THRESHOLD = 256;
+
+        // matrices of at most this size are decomposed by the unrolled kernels of FixedSizeLU<N>
+        static const GLuint FIXED_SIZE_LIMIT = 8;
+
+        // number of contiguous right-hand side columns processed by a thread in a structure-of-arrays substitution
+        static const GLuint SUBSTITUTION_BLOCK_WIDTH = 96;
+
+        // upper bound of the iterative refinement steps of a mixed precision solution
+        static const GLuint MAXIMUM_REFINEMENT_STEP_COUNT = 10;
+
+        // number of threads requested by SetThreadCount(), 0 stands for all hardware threads
+        static GLuint       _thread_count;
+
+        // reciprocals of the largest absolute values of the rows, fails if a row vanishes
+        GLboolean _CalculateImplicitScaling(std::vector<GLdouble>& implicit_scaling_of_each_row) const;
+
+        // pivots and eliminates the columns [first_column, last_column) within the panel
+        template <typename F>
+        GLvoid _FactorizePanel(F *lu, GLuint first_column, GLuint last_column, std::vector<GLdouble>& implicit_scaling_of_each_row);
+
+        // blocked LU decomposition of the row-major size x size array lu in place
+        template <typename F>
+        GLvoid _FactorizeBlocked(F *lu, std::vector<GLdouble>& implicit_scaling_of_each_row);
+
+        GLboolean _PerformDoublePrecisionLUDecomposition();
+        GLboolean _PerformFixedSizeLUDecomposition();
+        GLboolean _PerformMixedPrecisionLUDecomposition();
+
+        // in place forward and back substitution of the right-hand sides stored by x
+        template <typename F, class T>
+        GLvoid _Substitute(const F *lu, Matrix<T>& x, GLboolean represent_solutions_as_columns) const;
+
+        // Descartes coordinates are split into 3 double columns per right-hand side, and the substitution sweeps
+        // over all right-hand sides at once, in chunks of 4 coordinates that stay in registers; the operations are
+        // performed in the same order as by the generic variant above, hence the results are identical
+        template <typename F>
+        GLvoid _Substitute(const F *lu, Matrix<DCoordinate3>& x, GLboolean represent_solutions_as_columns) const;
+
+        // in place forward and back substitution of the columns [first_column, last_column) of the row-major
+        // size x leading_dimension array x, the number of columns has to be divisible by 3
+        template <typename F>
+        GLvoid _SubstituteColumns(const F *lu, GLdouble *x, GLuint leading_dimension,
+                                  GLuint first_column, GLuint last_column) const;
+
+        // substitution of the first WIDTH columns of x
+        template <GLuint WIDTH, typename F>
+        GLvoid _SubstituteChunk(const F *lu, GLdouble *x, GLuint leading_dimension) const;
+
+        // r = b - A * x, returns ||r|| / (||A|| ||x|| + ||b||) in maximum norm
+        template <class T>
+        GLdouble _CalculateResidual(const GLdouble *a, const Matrix<T>& b, const Matrix<T>& x, Matrix<T>& r,
+                                    GLboolean represent_solutions_as_columns) const;
+
+        static GLdouble _Magnitude(GLdouble value);
+        static GLdouble _Magnitude(const DCoordinate3& value);
 
     public:
         // special/default constructor
@@ -23,40 +100,65 @@ namespace cagd
         // assignment operator
         RealSquareMatrix& operator =(const RealSquareMatrix& rhs);
 
+        // move constructor and move assignment operator
+        RealSquareMatrix(RealSquareMatrix&& m) noexcept;
+        RealSquareMatrix& operator =(RealSquareMatrix&& rhs) noexcept;
+
         // square matrices have the same number of rows and columns!
         GLboolean ResizeRows(GLuint row_count);
         GLboolean ResizeColumns(GLuint row_count);
 
-        // tries to determine the LU decomposition of this square matrix
+        // selects the arithmetic of the next LU decomposition, fails if the decomposition has already been done
+        GLboolean SetPrecision(Precision precision);
+        Precision GetPrecision() const;
+
+        // tries to determine the LU decomposition of this square matrix; in mixed precision mode matrices with
+        // elements outside the single precision range are factorized in double precision, while matrices of
+        // size at most FIXED_SIZE_LIMIT are always factorized in double precision by unrolled kernels that
+        // neither allocate nor loop at run-time
         GLboolean PerformLUDecomposition();
 
+        // set, if the current LU factors are stored in single precision, i.e., mixed precision mode did not
+        // (yet) have to fall back to a double precision factorization
+        GLboolean HasSinglePrecisionFactors() const;
+
+        // relative residual ||b - A * x|| / (||A|| ||x|| + ||b||) in maximum norm achieved by the latest
+        // SolveLinearSystem call in mixed precision mode, -1 if no such solution has been determined
+        GLdouble GetResidual() const;
+
+        // number of threads that share the trailing updates of the LU decomposition and the right-hand sides
+        // of SolveLinearSystem in case of large systems; 0 (default) selects the number of hardware threads,
+        // while builds without OpenMP always run on the calling thread
+        static GLvoid SetThreadCount(GLuint thread_count);
+        static GLuint GetThreadCount();
+
         // Solves linear systems of type A * x = b, where A is a regular square matrix,
         // while b and x are row or column matrices with elements of type T.
         // Here matrix A corresponds to *this.
         // Advantage: T can be either GLdouble or DCoordinate, 
         // or any other type which has similar mathematical operators.
+        //
+        // With single precision factors, the solution is refined until its relative residual drops to
+        // size * DBL_EPSILON. If the refinement stalls, the matrix is factorized again in double precision
+        // and the system is solved directly.
         template <class T>
         GLboolean SolveLinearSystem(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns = GL_TRUE);
         //mine
     };
 
-
-    template <class T>
-    GLboolean RealSquareMatrix::SolveLinearSystem(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns)
+    template <typename F, class T>
+    GLvoid RealSquareMatrix::_Substitute(const F *lu, Matrix<T>& x, GLboolean represent_solutions_as_columns) const
     {
-        if (!_lu_decomposition_is_done)
-            if (!PerformLUDecomposition())
-                return GL_FALSE;
+        GLint size = (GLint)_row_count;
+
+        // the right-hand sides are independent of each other
+        GLint rhs_count = (GLint)(represent_solutions_as_columns ? x.GetColumnCount() : x.GetRowCount());
+        GLint thread_count = (GLint)GetThreadCount();
 
         if (represent_solutions_as_columns)
         {
-            GLint size = GetColumnCount();
-            if ((GLint)b.GetRowCount() != size)
-                    return GL_FALSE;
-
-            x = b;
-
-            for (GLuint k = 0; k < b.GetColumnCount(); ++k)
+            #pragma omp parallel for num_threads(thread_count) schedule(static) if(thread_count > 1 && rhs_count > 1 && size >= (GLint)PARALLEL_SIZE_THRESHOLD)
+            for (GLint k = 0; k < rhs_count; ++k)
             {
                 GLint ii = 0;
                 for (GLint i = 0; i < size; ++i)
@@ -66,7 +168,7 @@ namespace cagd
                     x(ip, k) = x(i, k);
                     if (ii != 0)
                         for (GLint j = ii - 1; j < i; ++j)
-                            sum -= _data[i][j] * x(j, k);
+                            sum -= (GLdouble)lu[i * size + j] * x(j, k);
                     else
                         if (sum != 0.0)
                             ii = i + 1;
@@ -77,20 +179,15 @@ namespace cagd
                 {
                     T sum = x(i, k);
                     for (GLint j = i + 1; j < size; ++j)
-                        sum -= _data[i][j] * x(j, k);
-                    x(i, k) = sum /= _data[i][i];
+                        sum -= (GLdouble)lu[i * size + j] * x(j, k);
+                    x(i, k) = sum /= (GLdouble)lu[i * size + i];
                 }
             }
         }
         else
         {
-            GLint size = GetRowCount();
-            if ((GLint)b.GetColumnCount() != size)
-                return GL_FALSE;
-
-            x = b;
-
-            for (GLuint k = 0; k < b.GetRowCount(); ++k)
+            #pragma omp parallel for num_threads(thread_count) schedule(static) if(thread_count > 1 && rhs_count > 1 && size >= (GLint)PARALLEL_SIZE_THRESHOLD)
+            for (GLint k = 0; k < rhs_count; ++k)
             {
                 GLint ii = 0;
                 for (GLint i = 0; i < size; ++i)
@@ -100,7 +197,7 @@ namespace cagd
                     x(k, ip) = x(k, i);
                     if (ii != 0)
                         for (GLint j = ii - 1; j < i; ++j)
-                            sum -= _data[i][j] * x(k, j);
+                            sum -= (GLdouble)lu[i * size + j] * x(k, j);
                     else
                         if (sum != 0.0)
                             ii = i + 1;
@@ -111,13 +208,232 @@ namespace cagd
                 {
                     T sum = x(k, i);
                     for (GLint j = i + 1; j < size; ++j)
-                        sum -= _data[i][j] * x(k, j);
-                    x(k, i) = sum /= _data[i][i];
+                        sum -= (GLdouble)lu[i * size + j] * x(k, j);
+                    x(k, i) = sum /= (GLdouble)lu[i * size + i];
                 }
             }
         }
+    }
 
-        return GL_TRUE;
+    template <GLuint WIDTH, typename F>
+    GLvoid RealSquareMatrix::_SubstituteChunk(const F *lu, GLdouble *x, GLuint leading_dimension) const
+    {
+        // the chunk is accumulated as COUNT local Descartes coordinates, whose inlined operators spell out
+        // the 3 components, i.e., the compiler keeps them in registers without having to unroll any loops
+        const GLuint COUNT = WIDTH / 3;
+
+        GLuint size = _row_count;
+
+        DCoordinate3 sum[COUNT];
+
+        // forward substitution, the unit diagonal of L is not stored
+        for (GLuint i = 0; i < size; ++i)
+        {
+            DCoordinate3 *x_i = reinterpret_cast<DCoordinate3*>(x + i * leading_dimension);
+
+            GLuint ip = _row_permutation[i];
+            if (ip != i)
+                std::swap_ranges(x_i, x_i + COUNT, reinterpret_cast<DCoordinate3*>(x + ip * leading_dimension));
+
+            for (GLuint q = 0; q < COUNT; ++q)
+                sum[q] = x_i[q];
+
+            const F *lu_i = lu + i * size;
+            for (GLuint j = 0; j < i; ++j)
+            {
+                GLdouble            l_ij = (GLdouble)lu_i[j];
+                const DCoordinate3 *x_j  = reinterpret_cast<const DCoordinate3*>(x + j * leading_dimension);
+
+                for (GLuint q = 0; q < COUNT; ++q)
+                    sum[q] -= l_ij * x_j[q];
+            }
+
+            for (GLuint q = 0; q < COUNT; ++q)
+                x_i[q] = sum[q];
+        }
+
+        // back substitution
+        for (GLuint i = size; i-- > 0; )
+        {
+            DCoordinate3 *x_i = reinterpret_cast<DCoordinate3*>(x + i * leading_dimension);
+
+            for (GLuint q = 0; q < COUNT; ++q)
+                sum[q] = x_i[q];
+
+            const F *lu_i = lu + i * size;
+            for (GLuint j = i + 1; j < size; ++j)
+            {
+                GLdouble            u_ij = (GLdouble)lu_i[j];
+                const DCoordinate3 *x_j  = reinterpret_cast<const DCoordinate3*>(x + j * leading_dimension);
+
+                for (GLuint q = 0; q < COUNT; ++q)
+                    sum[q] -= u_ij * x_j[q];
+            }
+
+            GLdouble u_ii = (GLdouble)lu_i[i];
+            for (GLuint q = 0; q < COUNT; ++q)
+                x_i[q] = sum[q] / u_ii;
+        }
+    }
+
+    template <typename F>
+    GLvoid RealSquareMatrix::_SubstituteColumns(const F *lu, GLdouble *x, GLuint leading_dimension,
+                                                GLuint first_column, GLuint last_column) const
+    {
+        GLuint c = first_column;
+
+        // 4 coordinates at a time, then the remaining ones one by one
+        for (; c + 12 <= last_column; c += 12)
+            _SubstituteChunk<12>(lu, x + c, leading_dimension);
+
+        for (; c + 3 <= last_column; c += 3)
+            _SubstituteChunk<3>(lu, x + c, leading_dimension);
+    }
+
+    template <typename F>
+    GLvoid RealSquareMatrix::_Substitute(const F *lu, Matrix<DCoordinate3>& x, GLboolean represent_solutions_as_columns) const
+    {
+        GLuint size      = _row_count;
+        GLuint rhs_count = represent_solutions_as_columns ? x.GetColumnCount() : x.GetRowCount();
+        GLuint width     = 3 * rhs_count;
+
+        ArenaScope scope;
+        ArenaMatrix<GLdouble> transposed;
+
+        GLdouble *soa;
+
+        if (represent_solutions_as_columns)
+        {
+            // the rows of x already consist of 3 * rhs_count consecutive doubles
+            soa = reinterpret_cast<GLdouble*>(x.GetData());
+        }
+        else
+        {
+            transposed.ResizeRows(size);
+            transposed.ResizeColumns(width);
+
+            for (GLuint k = 0; k < rhs_count; ++k)
+                for (GLuint i = 0; i < size; ++i)
+                    for (GLuint c = 0; c < 3; ++c)
+                        transposed(i, 3 * k + c) = x(k, i)[c];
+
+            soa = transposed.GetData();
+        }
+
+        // the column blocks are independent of each other
+        GLint thread_count = (GLint)GetThreadCount();
+        (void)thread_count;
+
+        #pragma omp parallel for num_threads(thread_count) schedule(static) if(thread_count > 1 && width > SUBSTITUTION_BLOCK_WIDTH && size >= PARALLEL_SIZE_THRESHOLD)
+        for (GLint c0 = 0; c0 < (GLint)width; c0 += (GLint)SUBSTITUTION_BLOCK_WIDTH)
+            _SubstituteColumns(lu, soa, width, (GLuint)c0, std::min((GLuint)c0 + SUBSTITUTION_BLOCK_WIDTH, width));
+
+        if (!represent_solutions_as_columns)
+        {
+            for (GLuint k = 0; k < rhs_count; ++k)
+                for (GLuint i = 0; i < size; ++i)
+                    for (GLuint c = 0; c < 3; ++c)
+                        x(k, i)[c] = transposed(i, 3 * k + c);
+        }
+    }
+
+    template <class T>
+    GLdouble RealSquareMatrix::_CalculateResidual(const GLdouble *a, const Matrix<T>& b, const Matrix<T>& x, Matrix<T>& r,
+                                                  GLboolean represent_solutions_as_columns) const
+    {
+        GLint size = (GLint)_row_count;
+        GLint rhs_count = (GLint)(represent_solutions_as_columns ? b.GetColumnCount() : b.GetRowCount());
+
+        r = b;
+
+        GLdouble r_norm = 0.0, x_norm = 0.0, b_norm = 0.0;
+
+        for (GLint k = 0; k < rhs_count; ++k)
+        {
+            for (GLint i = 0; i < size; ++i)
+            {
+                T &r_i = represent_solutions_as_columns ? r(i, k) : r(k, i);
+
+                b_norm = std::max(b_norm, _Magnitude(r_i));
+                x_norm = std::max(x_norm, _Magnitude(represent_solutions_as_columns ? x(i, k) : x(k, i)));
+
+                const GLdouble *row_i = a + i * size;
+                for (GLint j = 0; j < size; ++j)
+                    r_i -= row_i[j] * (represent_solutions_as_columns ? x(j, k) : x(k, j));
+
+                r_norm = std::max(r_norm, _Magnitude(r_i));
+            }
+        }
+
+        GLdouble denominator = _norm * x_norm + b_norm;
+
+        return denominator > 0.0 ? r_norm / denominator : r_norm;
     }
 
+    template <class T>
+    GLboolean RealSquareMatrix::SolveLinearSystem(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns)
+    {
+        if (!_lu_decomposition_is_done)
+            if (!PerformLUDecomposition())
+                return GL_FALSE;
+
+        GLuint size = GetRowCount();
+        if ((represent_solutions_as_columns ? b.GetRowCount() : b.GetColumnCount()) != size)
+            return GL_FALSE;
+
+        x = b;
+
+        if (!_single_precision_factors)
+        {
+            _Substitute(_data.data(), x, represent_solutions_as_columns);
+            return GL_TRUE;
+        }
+
+        //---------------------------------------------------------
+        // iterative refinement of the single precision solution
+        //---------------------------------------------------------
+        _Substitute(_single_precision_lu.data(), x, represent_solutions_as_columns);
+
+        const GLdouble tolerance = size * std::numeric_limits<GLdouble>::epsilon();
+        GLdouble previous_residual = std::numeric_limits<GLdouble>::max();
+
+        Matrix<T> r;
+
+        for (GLuint step = 0; ; ++step)
+        {
+            _residual = _CalculateResidual(_data.data(), b, x, r, represent_solutions_as_columns);
+
+            if (_residual <= tolerance)
+                return GL_TRUE;
+
+            // the correction does not converge (fast enough)
+            if (step == MAXIMUM_REFINEMENT_STEP_COUNT || !std::isfinite(_residual) || _residual > 0.5 * previous_residual)
+                break;
+
+            previous_residual = _residual;
+
+            // x += A^{-1} r
+            _Substitute(_single_precision_lu.data(), r, represent_solutions_as_columns);
+
+            T *x_data = x.GetData();
+            const T *r_data = r.GetData();
+            for (GLuint i = 0; i < x.GetRowCount() * x.GetColumnCount(); ++i)
+                x_data[i] += r_data[i];
+        }
+
+        //---------------------------------------------------------
+        // fall back to the double precision factorization
+        //---------------------------------------------------------
+        std::vector<GLdouble> a(_data);
+
+        if (!_PerformDoublePrecisionLUDecomposition())
+            return GL_FALSE;
+
+        x = b;
+        _Substitute(_data.data(), x, represent_solutions_as_columns);
+
+        _residual = _CalculateResidual(a.data(), b, x, r, represent_solutions_as_columns);
+
+        return GL_TRUE;
+    }
 }
@@ -0,0 +1,265 @@
+#include "SmallLinearSystems.h"
+
+using namespace cagd;
+using namespace std;
+
+// the structure-of-arrays sweep pays off if the compiler can blend, multiply and divide 4 doubles at once;
+// otherwise the systems are solved one by one by the unrolled kernels
+#if defined(__AVX__)
+    #define CAGD_SMALL_SYSTEMS_SOA
+#endif
+
+namespace
+{
+    // solves a single system by the unrolled decomposition and substitution, b and x may coincide
+    GLboolean SolveSystem(const GLdouble *a, const DCoordinate3 *b, DCoordinate3 *x)
+    {
+        GLdouble lu[16];
+        GLuint   row_permutation[4];
+
+        copy(a, a + 16, lu);
+
+        if (!FixedSizeLU<4>::Decompose(lu, row_permutation))
+        {
+            fill(x, x + 4, DCoordinate3());
+            return GL_FALSE;
+        }
+
+        DCoordinate3 y[4];
+        copy(b, b + 4, y);
+
+        // forward substitution
+        StaticFor<0, 4>::Run([&](auto i)
+        {
+            swap(y[i], y[row_permutation[i]]);
+
+            StaticFor<0, decltype(i)::value>::Run([&](auto j)
+            {
+                y[i] -= lu[4 * i + j] * y[j];
+            });
+        });
+
+        // back substitution
+        StaticFor<0, 4>::Run([&](auto r)
+        {
+            const GLuint i = 3 - decltype(r)::value;
+
+            StaticFor<i + 1, 4>::Run([&](auto j)
+            {
+                y[i] -= lu[4 * i + j] * y[j];
+            });
+
+            y[i] /= lu[4 * i + i];
+        });
+
+        copy(y, y + 4, x);
+
+        return GL_TRUE;
+    }
+
+#if defined(CAGD_SMALL_SYSTEMS_SOA)
+    // number of systems processed together, i.e., the length of the innermost loops
+    const GLuint LANES = 4;
+
+    // the 4 x 4 systems of a group in structure-of-arrays form
+    struct Group
+    {
+        GLdouble  a[4][4][LANES];
+        GLdouble  b[4][3][LANES];
+        GLdouble  scaling[4][LANES];
+        GLboolean singular[LANES];
+    };
+
+    // interchanges x[l] and y[l] in the lanes where w[l] = 1, while w[l] = 0 leaves them unchanged
+    inline GLvoid Interchange(const GLdouble *w, GLdouble *x, GLdouble *y)
+    {
+        for (GLuint l = 0; l < LANES; ++l)
+        {
+            GLdouble x_l = x[l], y_l = y[l];
+            x[l] = (1.0 - w[l]) * x_l + w[l] * y_l;
+            y[l] = (1.0 - w[l]) * y_l + w[l] * x_l;
+        }
+    }
+
+    // the loops over rows, columns and coordinates are unrolled at compile time, hence the arithmetic loops run
+    // over the lanes (i.e., over the same element of different systems) with constant bounds and offsets, which
+    // is the pattern that compilers vectorize
+    GLvoid SolveGroup(Group& g)
+    {
+        // implicit scaling of the rows, singular systems are detected afterwards
+        StaticFor<0, 4>::Run([&](auto i)
+        {
+            GLdouble big[LANES] = {};
+
+            StaticFor<0, 4>::Run([&](auto j)
+            {
+                for (GLuint l = 0; l < LANES; ++l)
+                    big[l] = max(big[l], abs(g.a[i][j][l]));
+            });
+
+            for (GLuint l = 0; l < LANES; ++l)
+                g.scaling[i][l] = 1.0 / big[l];
+        });
+
+        for (GLuint l = 0; l < LANES; ++l)
+        {
+            g.singular[l] = GL_FALSE;
+            for (GLuint i = 0; i < 4; ++i)
+                if (isinf(g.scaling[i][l]))
+                    g.singular[l] = GL_TRUE;
+        }
+
+        StaticFor<0, 4>::Run([&](auto k)
+        {
+            // scaled magnitudes of the pivot candidates
+            GLdouble candidate[4][LANES];
+            StaticFor<decltype(k)::value, 4>::Run([&](auto i)
+            {
+                for (GLuint l = 0; l < LANES; ++l)
+                    candidate[i][l] = g.scaling[i][l] * abs(g.a[i][k][l]);
+            });
+
+            // search for the largest pivot element of each system
+            GLdouble big[LANES], pivot[LANES];
+            for (GLuint l = 0; l < LANES; ++l)
+            {
+                big[l]   = candidate[k][l];
+                pivot[l] = k;
+            }
+
+            StaticFor<decltype(k)::value + 1, 4>::Run([&](auto i)
+            {
+                for (GLuint l = 0; l < LANES; ++l)
+                {
+                    pivot[l] = (candidate[i][l] > big[l]) ? (GLdouble)i : pivot[l];
+                    big[l]   = max(big[l], candidate[i][l]);
+                }
+            });
+
+            // interchange the rows k and pivot of each system by blending with the weights 0 and 1, which
+            // reproduces finite values exactly
+            StaticFor<decltype(k)::value + 1, 4>::Run([&](auto i)
+            {
+                GLdouble w[LANES];
+                for (GLuint l = 0; l < LANES; ++l)
+                    w[l] = (pivot[l] == i) ? 1.0 : 0.0;
+
+                StaticFor<0, 4>::Run([&](auto j)
+                {
+                    Interchange(w, g.a[k][j], g.a[i][j]);
+                });
+
+                StaticFor<0, 3>::Run([&](auto c)
+                {
+                    Interchange(w, g.b[k][c], g.b[i][c]);
+                });
+
+                for (GLuint l = 0; l < LANES; ++l)
+                    g.scaling[i][l] = (1.0 - w[l]) * g.scaling[i][l] + w[l] * g.scaling[k][l];
+            });
+
+            for (GLuint l = 0; l < LANES; ++l)
+                if (g.a[k][k][l] == 0.0)
+                    g.a[k][k][l] = numeric_limits<GLdouble>::min();
+
+            // elimination, the right-hand sides are reduced by forward substitution on the fly
+            StaticFor<decltype(k)::value + 1, 4>::Run([&](auto i)
+            {
+                GLdouble temp[LANES];
+                for (GLuint l = 0; l < LANES; ++l)
+                    temp[l] = g.a[i][k][l] /= g.a[k][k][l];
+
+                StaticFor<decltype(k)::value + 1, 4>::Run([&](auto j)
+                {
+                    for (GLuint l = 0; l < LANES; ++l)
+                        g.a[i][j][l] -= temp[l] * g.a[k][j][l];
+                });
+
+                StaticFor<0, 3>::Run([&](auto c)
+                {
+                    for (GLuint l = 0; l < LANES; ++l)
+                        g.b[i][c][l] -= temp[l] * g.b[k][c][l];
+                });
+            });
+        });
+
+        // back substitution
+        StaticFor<0, 4>::Run([&](auto r)
+        {
+            const GLuint i = 3 - decltype(r)::value;
+
+            StaticFor<0, 3>::Run([&](auto c)
+            {
+                StaticFor<i + 1, 4>::Run([&](auto j)
+                {
+                    for (GLuint l = 0; l < LANES; ++l)
+                        g.b[i][c][l] -= g.a[i][j][l] * g.b[j][c][l];
+                });
+
+                for (GLuint l = 0; l < LANES; ++l)
+                    g.b[i][c][l] /= g.a[i][i][l];
+            });
+        });
+    }
+#endif
+}
+
+GLboolean cagd::SolveLinearSystems4x4(GLuint count, const GLdouble *a, const DCoordinate3 *b, DCoordinate3 *x,
+                                      GLboolean *regular)
+{
+    GLboolean result = GL_TRUE;
+
+    GLuint s = 0;
+
+#if defined(CAGD_SMALL_SYSTEMS_SOA)
+    Group g;
+
+    for (; s + LANES <= count; s += LANES)
+    {
+        // transpose the group
+        for (GLuint l = 0; l < LANES; ++l)
+        {
+            const GLdouble     *a_s = a + 16 * (s + l);
+            const DCoordinate3 *b_s = b + 4 * (s + l);
+
+            for (GLuint i = 0; i < 4; ++i)
+            {
+                for (GLuint j = 0; j < 4; ++j)
+                    g.a[i][j][l] = a_s[4 * i + j];
+
+                for (GLuint c = 0; c < 3; ++c)
+                    g.b[i][c][l] = b_s[i][c];
+            }
+        }
+
+        SolveGroup(g);
+
+        for (GLuint l = 0; l < LANES; ++l)
+        {
+            GLboolean regular_s = !g.singular[l];
+
+            if (regular)
+                regular[s + l] = regular_s;
+
+            result = result && regular_s;
+
+            for (GLuint i = 0; i < 4; ++i)
+                for (GLuint c = 0; c < 3; ++c)
+                    x[4 * (s + l) + i][c] = regular_s ? g.b[i][c][l] : 0.0;
+        }
+    }
+#endif
+
+    // the remaining systems one by one
+    for (; s < count; ++s)
+    {
+        GLboolean regular_s = SolveSystem(a + 16 * s, b + 4 * s, x + 4 * s);
+
+        if (regular)
+            regular[s] = regular_s;
+
+        result = result && regular_s;
+    }
+
+    return result;
+}
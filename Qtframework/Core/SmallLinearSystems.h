@@ -0,0 +1,141 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include "DCoordinates3.h"
+
+namespace cagd
+{
+    //-------------------------------
+    // template class StaticFor<B, E>
+    //-------------------------------
+    // calls f(std::integral_constant<GLuint, i>()) for i = B, B + 1, ..., E - 1; the loop is unrolled at compile
+    // time and the index can be used as a template argument inside generic lambdas
+    template <GLuint B, GLuint E>
+    class StaticFor
+    {
+    public:
+        template <class Function>
+        static inline GLvoid Run(Function&& f)
+        {
+            f(std::integral_constant<GLuint, B>());
+            StaticFor<B + 1, E>::Run(f);
+        }
+    };
+
+    template <GLuint E>
+    class StaticFor<E, E>
+    {
+    public:
+        template <class Function>
+        static inline GLvoid Run(Function&&)
+        {
+        }
+    };
+
+    //------------------------------
+    // template class FixedSizeLU<N>
+    //------------------------------
+    // LU decomposition of N x N matrices with compile-time unrolled loops; the pivoting strategy, the layout of
+    // the factors and the order of the floating point operations coincide with the ones of the (unblocked)
+    // decomposition of RealSquareMatrix, therefore both yield identical factors
+    template <GLuint N>
+    class FixedSizeLU
+    {
+    public:
+        // decomposes the row-major N x N array a in place, row_permutation[k] stores the row interchanged
+        // with row k in step k; fails (without modifying a) if a row of the matrix vanishes
+        static GLboolean Decompose(GLdouble *a, GLuint *row_permutation);
+    };
+
+    template <GLuint N>
+    GLboolean FixedSizeLU<N>::Decompose(GLdouble *a, GLuint *row_permutation)
+    {
+        // implicit scaling of the rows
+        GLdouble  implicit_scaling_of_each_row[N];
+        GLboolean regular = GL_TRUE;
+
+        StaticFor<0, N>::Run([&](auto i)
+        {
+            GLdouble big = 0.0;
+            StaticFor<0, N>::Run([&](auto j)
+            {
+                GLdouble temp = std::abs(a[i * N + j]);
+                if (temp > big)
+                    big = temp;
+            });
+
+            if (big == 0.0)
+                regular = GL_FALSE;
+            else
+                implicit_scaling_of_each_row[i] = 1.0 / big;
+        });
+
+        if (!regular)
+            return GL_FALSE;
+
+        StaticFor<0, N>::Run([&](auto k)
+        {
+            // search for the largest pivot element
+            GLuint   imax = k;
+            GLdouble big  = 0.0;
+            StaticFor<decltype(k)::value, N>::Run([&](auto i)
+            {
+                GLdouble temp = implicit_scaling_of_each_row[i] * std::abs(a[i * N + k]);
+                if (temp > big)
+                {
+                    big  = temp;
+                    imax = i;
+                }
+            });
+
+            // do we need to interchange rows?
+            if (imax != k)
+            {
+                StaticFor<0, N>::Run([&](auto j)
+                {
+                    std::swap(a[k * N + j], a[imax * N + j]);
+                });
+                implicit_scaling_of_each_row[imax] = implicit_scaling_of_each_row[k];
+            }
+
+            row_permutation[k] = imax;
+            if (a[k * N + k] == 0.0)
+                a[k * N + k] = std::numeric_limits<GLdouble>::min();
+
+            StaticFor<decltype(k)::value + 1, N>::Run([&](auto i)
+            {
+                // divide by pivot element
+                GLdouble temp = a[i * N + k] /= a[k * N + k];
+
+                StaticFor<decltype(k)::value + 1, N>::Run([&](auto j)
+                {
+                    a[i * N + j] -= temp * a[k * N + j];
+                });
+            });
+        });
+
+        return GL_TRUE;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // solves the independent 4 x 4 linear systems A_s * x_s = b_s, s = 0, 1, ..., count - 1
+    //
+    // a stores the matrices one after the other (16 doubles each, in row-major order), while
+    // b and x store 4 consecutive coordinates per system; x may coincide with b. If the build
+    // targets AVX, groups of systems are transposed into structure-of-arrays form, such that
+    // every arithmetic operation acts on the same element of several systems at once and can
+    // be vectorized; pivots are selected per system by branch-free blending. Otherwise, and
+    // for the last count % 4 systems, the unrolled kernel FixedSizeLU<4> is used. In both
+    // cases the solutions coincide with the ones of RealSquareMatrix::SolveLinearSystem.
+    //
+    // If regular is not null, regular[s] reports whether A_s is regular (i.e., no row of A_s
+    // vanishes). The solutions of singular systems are set to null vectors. The function
+    // fails if at least one of the systems is singular.
+    //-------------------------------------------------------------------------------------
+    GLboolean SolveLinearSystems4x4(GLuint count, const GLdouble *a, const DCoordinate3 *b, DCoordinate3 *x,
+                                    GLboolean *regular = nullptr);
+}
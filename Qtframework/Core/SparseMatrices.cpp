@@ -0,0 +1,74 @@
+#include "SparseMatrices.h"
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+    #include <immintrin.h>
+    #define CAGD_SPMV_AVX2_FMA
+#endif
+
+using namespace cagd;
+using namespace std;
+
+// sum_{p=first}^{last-1} values[p] * x[columns[p]]
+static inline GLdouble RowProduct(const GLdouble *values, const GLuint *columns, GLuint first, GLuint last, const GLdouble *x)
+{
+    GLuint p = first;
+
+#ifdef CAGD_SPMV_AVX2_FMA
+    // 4 elements of x are gathered at a time
+    __m256d sum4 = _mm256_setzero_pd();
+    for (; p + 4 <= last; p += 4)
+    {
+        __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns + p));
+        sum4 = _mm256_fmadd_pd(_mm256_loadu_pd(values + p), _mm256_i32gather_pd(x, indices, sizeof(GLdouble)), sum4);
+    }
+
+    __m128d sum2 = _mm_add_pd(_mm256_castpd256_pd128(sum4), _mm256_extractf128_pd(sum4, 1));
+    GLdouble sum = _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+#else
+    // independent partial sums hide the latency of the additions
+    GLdouble s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    for (; p + 4 <= last; p += 4)
+    {
+        s0 += values[p    ] * x[columns[p    ]];
+        s1 += values[p + 1] * x[columns[p + 1]];
+        s2 += values[p + 2] * x[columns[p + 2]];
+        s3 += values[p + 3] * x[columns[p + 3]];
+    }
+
+    GLdouble sum = (s0 + s1) + (s2 + s3);
+#endif
+
+    for (; p < last; ++p)
+        sum += values[p] * x[columns[p]];
+
+    return sum;
+}
+
+namespace cagd
+{
+    template <>
+    template <>
+    GLboolean SparseMatrix<GLdouble>::Multiply(const vector<GLdouble>& x, vector<GLdouble>& y) const
+    {
+        if (x.size() != _column_count || &x == &y)
+            return GL_FALSE;
+
+        y.resize(_row_count);
+
+        const GLdouble *values  = _values.data();
+        const GLuint   *columns = _column_indices.data();
+        const GLuint   *offsets = _row_offsets.data();
+        const GLdouble *x_data  = x.data();
+        GLdouble       *y_data  = y.data();
+
+        GLint     thread_count = (GLint)RealSquareMatrix::GetThreadCount();
+        GLboolean parallel = (thread_count > 1 && _values.size() >= PARALLEL_NON_ZERO_THRESHOLD);
+        (void)parallel;
+
+        #pragma omp parallel for num_threads(thread_count) schedule(static) if(parallel)
+        for (GLint r = 0; r < (GLint)_row_count; ++r)
+            y_data[r] = RowProduct(values, columns, offsets[r], offsets[r + 1], x_data);
+
+        return GL_TRUE;
+    }
+}
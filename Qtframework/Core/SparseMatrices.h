@@ -0,0 +1,246 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <vector>
+#include "DCoordinates3.h"
+#include "RealSquareMatrices.h"
+
+namespace cagd
+{
+    //-------------------------------
+    // template class SparseMatrix<T>
+    //-------------------------------
+    // matrices of which only the non-zero elements are stored, in compressed sparse row (CSR) format; they
+    // are assembled from lists of (row, column, value) triplets, like finite element and fairing matrices are
+    template <typename T>
+    class SparseMatrix
+    {
+    public:
+        // element of a matrix under construction, the values of triplets that share a position are summed up
+        class Triplet
+        {
+        public:
+            GLuint  row, column;
+            T       value;
+
+            Triplet(GLuint row = 0, GLuint column = 0, const T& value = T());
+        };
+
+        // rows that contain at least this many non-zero elements in total are multiplied in parallel
+        static const GLuint PARALLEL_NON_ZERO_THRESHOLD = 1u << 15;
+
+    protected:
+        GLuint              _row_count;
+        GLuint              _column_count;
+        std::vector<GLuint> _row_offsets;     // row r occupies the positions [_row_offsets[r], _row_offsets[r + 1])
+        std::vector<GLuint> _column_indices;  // strictly increasing within each row
+        std::vector<T>      _values;
+
+    public:
+        // special/default constructor, creates a null matrix
+        SparseMatrix(GLuint row_count = 0, GLuint column_count = 0);
+
+        // replaces the matrix; fails (without modifying it) if a triplet lies outside of the given size
+        GLboolean SetFromTriplets(GLuint row_count, GLuint column_count, const std::vector<Triplet>& triplets);
+
+        // get properties
+        GLuint GetRowCount() const;
+        GLuint GetColumnCount() const;
+        GLuint GetNonZeroCount() const;
+
+        // raw CSR arrays
+        const GLuint* GetRowOffsets() const;
+        const GLuint* GetColumnIndices() const;
+        const T*      GetValues() const;
+        T*            GetValues();
+
+        // get element by value, elements that are not stored are zero; O(log(row length))
+        T operator ()(GLuint row, GLuint column) const;
+
+        // the main diagonal of a square matrix
+        GLboolean GetDiagonal(std::vector<T>& diagonal) const;
+
+        // y = A * x, where x and y are vectors of scalars or of Descartes coordinates; the rows are shared among
+        // the threads of RealSquareMatrix::GetThreadCount() in case of large matrices
+        template <class V>
+        GLboolean Multiply(const std::vector<V>& x, std::vector<V>& y) const;
+    };
+
+    // the double precision product of scalar vectors is gathered by AVX2 instructions if the build targets them
+    template <>
+    template <>
+    GLboolean SparseMatrix<GLdouble>::Multiply(const std::vector<GLdouble>& x, std::vector<GLdouble>& y) const;
+
+    //-----------------------------------
+    // implementation of SparseMatrix<T>
+    //-----------------------------------
+    template <typename T>
+    SparseMatrix<T>::Triplet::Triplet(GLuint row, GLuint column, const T& value):
+            row(row), column(column), value(value)
+    {
+    }
+
+    template <typename T>
+    SparseMatrix<T>::SparseMatrix(GLuint row_count, GLuint column_count):
+            _row_count(row_count),
+            _column_count(column_count),
+            _row_offsets(row_count + 1, 0)
+    {
+    }
+
+    template <typename T>
+    GLboolean SparseMatrix<T>::SetFromTriplets(GLuint row_count, GLuint column_count, const std::vector<Triplet>& triplets)
+    {
+        for (typename std::vector<Triplet>::const_iterator it = triplets.begin(); it != triplets.end(); ++it)
+            if (it->row >= row_count || it->column >= column_count)
+                return GL_FALSE;
+
+        // counting sort by rows
+        std::vector<GLuint> offsets(row_count + 1, 0);
+        for (typename std::vector<Triplet>::const_iterator it = triplets.begin(); it != triplets.end(); ++it)
+            ++offsets[it->row + 1];
+
+        for (GLuint r = 0; r < row_count; ++r)
+            offsets[r + 1] += offsets[r];
+
+        std::vector<GLuint> positions(offsets.begin(), offsets.end() - 1);
+        std::vector<GLuint> columns(triplets.size());
+        std::vector<T>      values(triplets.size());
+
+        for (typename std::vector<Triplet>::const_iterator it = triplets.begin(); it != triplets.end(); ++it)
+        {
+            GLuint p = positions[it->row]++;
+            columns[p] = it->column;
+            values[p]  = it->value;
+        }
+
+        // sorting the rows by columns and merging the duplicates
+        _row_count    = row_count;
+        _column_count = column_count;
+        _row_offsets.assign(row_count + 1, 0);
+        _column_indices.clear();
+        _values.clear();
+        _column_indices.reserve(triplets.size());
+        _values.reserve(triplets.size());
+
+        std::vector<GLuint> order;
+
+        for (GLuint r = 0; r < row_count; ++r)
+        {
+            order.resize(offsets[r + 1] - offsets[r]);
+            for (GLuint q = 0; q < order.size(); ++q)
+                order[q] = offsets[r] + q;
+
+            std::sort(order.begin(), order.end(),
+                      [&columns](GLuint p, GLuint q) { return columns[p] < columns[q]; });
+
+            for (GLuint q = 0; q < order.size(); ++q)
+            {
+                GLuint p = order[q];
+
+                if (_column_indices.size() > _row_offsets[r] && _column_indices.back() == columns[p])
+                    _values.back() += values[p];
+                else
+                {
+                    _column_indices.push_back(columns[p]);
+                    _values.push_back(values[p]);
+                }
+            }
+
+            _row_offsets[r + 1] = (GLuint)_column_indices.size();
+        }
+
+        return GL_TRUE;
+    }
+
+    template <typename T>
+    inline GLuint SparseMatrix<T>::GetRowCount() const
+    {
+        return _row_count;
+    }
+
+    template <typename T>
+    inline GLuint SparseMatrix<T>::GetColumnCount() const
+    {
+        return _column_count;
+    }
+
+    template <typename T>
+    inline GLuint SparseMatrix<T>::GetNonZeroCount() const
+    {
+        return (GLuint)_values.size();
+    }
+
+    template <typename T>
+    inline const GLuint* SparseMatrix<T>::GetRowOffsets() const
+    {
+        return _row_offsets.data();
+    }
+
+    template <typename T>
+    inline const GLuint* SparseMatrix<T>::GetColumnIndices() const
+    {
+        return _column_indices.data();
+    }
+
+    template <typename T>
+    inline const T* SparseMatrix<T>::GetValues() const
+    {
+        return _values.data();
+    }
+
+    template <typename T>
+    inline T* SparseMatrix<T>::GetValues()
+    {
+        return _values.data();
+    }
+
+    template <typename T>
+    T SparseMatrix<T>::operator ()(GLuint row, GLuint column) const
+    {
+        const GLuint *first = _column_indices.data() + _row_offsets[row];
+        const GLuint *last  = _column_indices.data() + _row_offsets[row + 1];
+        const GLuint *it    = std::lower_bound(first, last, column);
+
+        return (it != last && *it == column) ? _values[it - _column_indices.data()] : T();
+    }
+
+    template <typename T>
+    GLboolean SparseMatrix<T>::GetDiagonal(std::vector<T>& diagonal) const
+    {
+        if (_row_count != _column_count)
+            return GL_FALSE;
+
+        diagonal.resize(_row_count);
+        for (GLuint r = 0; r < _row_count; ++r)
+            diagonal[r] = (*this)(r, r);
+
+        return GL_TRUE;
+    }
+
+    template <typename T>
+    template <class V>
+    GLboolean SparseMatrix<T>::Multiply(const std::vector<V>& x, std::vector<V>& y) const
+    {
+        if (x.size() != _column_count || &x == &y)
+            return GL_FALSE;
+
+        y.resize(_row_count);
+
+        GLint     thread_count = (GLint)RealSquareMatrix::GetThreadCount();
+        GLboolean parallel = (thread_count > 1 && _values.size() >= PARALLEL_NON_ZERO_THRESHOLD);
+        (void)parallel;
+
+        #pragma omp parallel for num_threads(thread_count) schedule(static) if(parallel)
+        for (GLint r = 0; r < (GLint)_row_count; ++r)
+        {
+            V sum = V();
+            for (GLuint p = _row_offsets[r]; p < _row_offsets[r + 1]; ++p)
+                sum += _values[p] * x[_column_indices[p]];
+            y[r] = sum;
+        }
+
+        return GL_TRUE;
+    }
+}
@@ -0,0 +1,637 @@
+#include "SparseSolvers.h"
+#include <algorithm>
+#include <limits>
+
+using namespace cagd;
+using namespace std;
+
+namespace
+{
+    //-------------------------------------------------------------------------------------
+    // nested dissection ordering of the adjacency graph of a symmetric sparse matrix
+    //
+    // A part of the graph is split by the middle level set of a breadth-first search that
+    // starts at a pseudo-peripheral node; the two halves are ordered recursively, followed
+    // by the separator. Disconnected parts are split into their connected components, which
+    // are ordered one after the other.
+    //-------------------------------------------------------------------------------------
+    class NestedDissection
+    {
+    protected:
+        const GLuint         *_offsets;
+        const GLuint         *_adjacency;
+        GLuint                _leaf_size;
+        std::vector<GLuint>   _label;       // the part that contains the node
+        std::vector<GLuint>   _level;       // breadth-first level within the current part
+        GLuint                _next_label;
+        std::vector<GLuint>  &_order;
+
+        static const GLuint ORDERED = numeric_limits<GLuint>::max();
+
+        // breadth-first search within the part of the root, returns the nodes in the order of their visits
+        // and the first position of each level
+        GLvoid _Search(GLuint root, std::vector<GLuint>& visited, std::vector<GLuint>& level_offsets)
+        {
+            GLuint label = _label[root];
+
+            visited.assign(1, root);
+            level_offsets.assign(1, 0);
+
+            // the labels of the visited nodes are temporarily complemented
+            _label[root] = ~label;
+            _level[root] = 0;
+
+            for (GLuint head = 0; head < visited.size(); ++head)
+            {
+                GLuint v = visited[head];
+
+                for (GLuint p = _offsets[v]; p < _offsets[v + 1]; ++p)
+                {
+                    GLuint w = _adjacency[p];
+                    if (_label[w] == label)
+                    {
+                        _label[w] = ~label;
+                        _level[w] = _level[v] + 1;
+                        if (_level[w] == level_offsets.size())
+                            level_offsets.push_back((GLuint)visited.size());
+                        visited.push_back(w);
+                    }
+                }
+            }
+
+            level_offsets.push_back((GLuint)visited.size());
+
+            for (GLuint q = 0; q < visited.size(); ++q)
+                _label[visited[q]] = label;
+        }
+
+        // a part of the graph that still has to be ordered, or a separator that is ordered after the parts
+        // that it separates
+        struct Task
+        {
+            std::vector<GLuint> nodes;
+            GLboolean           is_separator;
+        };
+
+        std::vector<Task> _tasks;
+
+        GLvoid _Push(std::vector<GLuint>& nodes, GLboolean is_separator)
+        {
+            _tasks.push_back(Task());
+            _tasks.back().nodes.swap(nodes);
+            _tasks.back().is_separator = is_separator;
+        }
+
+        // splits a disconnected part into its connected components by a single sweep, every node is visited by
+        // exactly one breadth-first search; the first component, that has already been searched, is passed in
+        GLvoid _PushComponents(const std::vector<GLuint>& nodes, std::vector<GLuint>& first_component)
+        {
+            GLuint part_label = _label[nodes[0]];
+
+            std::vector<std::vector<GLuint>> components(1);
+            components[0].swap(first_component);
+
+            std::vector<GLuint> level_offsets;
+
+            for (GLuint c = 0, q = 0; c < components.size(); ++c)
+            {
+                GLuint component_label = _next_label++;
+                for (GLuint r = 0; r < components[c].size(); ++r)
+                    _label[components[c][r]] = component_label;
+
+                // the next node that has not been reached yet roots the next component
+                while (q < nodes.size() && _label[nodes[q]] != part_label)
+                    ++q;
+
+                if (q < nodes.size())
+                {
+                    components.push_back(std::vector<GLuint>());
+                    _Search(nodes[q], components.back(), level_offsets);
+                }
+            }
+
+            // the components are ordered one after the other, in the order of their discovery
+            for (GLuint c = (GLuint)components.size(); c-- > 0; )
+                _Push(components[c], GL_FALSE);
+        }
+
+        // orders a connected part, or pushes the tasks of its components, resp. of its halves and separator
+        GLvoid _Dissect(std::vector<GLuint>& nodes)
+        {
+            if (nodes.size() <= _leaf_size)
+            {
+                _order.insert(_order.end(), nodes.begin(), nodes.end());
+                return;
+            }
+
+            std::vector<GLuint> visited, level_offsets;
+            _Search(nodes[0], visited, level_offsets);
+
+            if (visited.size() < nodes.size())
+            {
+                _PushComponents(nodes, visited);
+                return;
+            }
+
+            // pseudo-peripheral root: restart from a node of the last level as long as the search gets deeper
+            for (GLuint attempt = 0; attempt < 8; ++attempt)
+            {
+                GLuint depth = (GLuint)level_offsets.size() - 1;
+
+                GLuint root = visited[level_offsets[depth - 1]];
+                for (GLuint q = level_offsets[depth - 1]; q < level_offsets[depth]; ++q)
+                    if (_offsets[visited[q] + 1] - _offsets[visited[q]] < _offsets[root + 1] - _offsets[root])
+                        root = visited[q];
+
+                std::vector<GLuint> next_visited, next_level_offsets;
+                _Search(root, next_visited, next_level_offsets);
+
+                // the eccentricity of the new root is at least the previous depth, i.e., the new search is kept in
+                // either case, since the levels of the nodes have been overwritten
+                GLboolean deeper = (next_level_offsets.size() > level_offsets.size());
+
+                visited.swap(next_visited);
+                level_offsets.swap(next_level_offsets);
+
+                if (!deeper)
+                    break;
+            }
+
+            GLuint depth = (GLuint)level_offsets.size() - 1;
+
+            if (depth < 3)
+            {
+                _order.insert(_order.end(), nodes.begin(), nodes.end());
+                return;
+            }
+
+            // the separator is the level that halves the nodes, both halves have to be non-empty
+            GLuint separator_level = 1;
+            while (separator_level + 2 < depth && level_offsets[separator_level + 1] < visited.size() / 2)
+                ++separator_level;
+
+            GLuint first_label = _next_label++, second_label = _next_label++;
+
+            for (GLuint q = 0; q < visited.size(); ++q)
+            {
+                GLuint v = visited[q];
+                _label[v] = (_level[v] < separator_level) ? first_label :
+                            (_level[v] > separator_level) ? second_label : ORDERED;
+            }
+
+            // separator nodes without neighbors in the second half are moved to the first one
+            std::vector<GLuint> separator;
+            for (GLuint q = level_offsets[separator_level]; q < level_offsets[separator_level + 1]; ++q)
+            {
+                GLuint    v = visited[q];
+                GLboolean separates = GL_FALSE;
+
+                for (GLuint p = _offsets[v]; p < _offsets[v + 1] && !separates; ++p)
+                    separates = (_label[_adjacency[p]] == second_label);
+
+                if (separates)
+                    separator.push_back(v);
+                else
+                    _label[v] = first_label;
+            }
+
+            std::vector<GLuint> first, second;
+            for (GLuint q = 0; q < visited.size(); ++q)
+            {
+                GLuint v = visited[q];
+                if (_label[v] == first_label)
+                    first.push_back(v);
+                else if (_label[v] == second_label)
+                    second.push_back(v);
+            }
+
+            nodes.clear();
+            nodes.shrink_to_fit();
+            visited.clear();
+            visited.shrink_to_fit();
+
+            // the tasks are processed in last in, first out order
+            _Push(separator, GL_TRUE);
+            _Push(second, GL_FALSE);
+            _Push(first, GL_FALSE);
+        }
+
+
+    public:
+        NestedDissection(GLuint size, const GLuint *offsets, const GLuint *adjacency, GLuint leaf_size, std::vector<GLuint>& order):
+                _offsets(offsets), _adjacency(adjacency), _leaf_size(leaf_size),
+                _label(size, 0), _level(size, 0), _next_label(1), _order(order)
+        {
+            order.clear();
+            order.reserve(size);
+
+            std::vector<GLuint> nodes(size);
+            for (GLuint v = 0; v < size; ++v)
+                nodes[v] = v;
+
+            if (size)
+                _Push(nodes, GL_FALSE);
+
+            // an explicit work stack instead of recursion, since the number of parts, e.g., of the connected
+            // components of a diagonal matrix, can be as large as the size of the matrix
+            while (!_tasks.empty())
+            {
+                Task task;
+                task.nodes.swap(_tasks.back().nodes);
+                task.is_separator = _tasks.back().is_separator;
+                _tasks.pop_back();
+
+                if (task.is_separator)
+                    _order.insert(_order.end(), task.nodes.begin(), task.nodes.end());
+                else
+                    _Dissect(task.nodes);
+            }
+        }
+    };
+}
+
+//-----------------------------------------
+// implementation of ConjugateGradientSolver
+//-----------------------------------------
+
+// default constructor
+ConjugateGradientSolver::ConjugateGradientSolver():
+        _matrix(nullptr),
+        _preconditioner(NO_PRECONDITIONER),
+        _tolerance(1.0e-10),
+        _maximum_iteration_count(0),
+        _iteration_count(0),
+        _relative_residual(-1.0)
+{
+}
+
+GLboolean ConjugateGradientSolver::_CalculateIncompleteCholeskyFactors(GLdouble shift)
+{
+    GLuint          n       = _matrix->GetRowCount();
+    const GLuint   *offsets = _matrix->GetRowOffsets();
+    const GLuint   *columns = _matrix->GetColumnIndices();
+    const GLdouble *values  = _matrix->GetValues();
+
+    // the pattern of L is the lower triangle of A, its diagonal is stored last within each row
+    vector<SparseMatrix<GLdouble>::Triplet> triplets;
+    triplets.reserve(_matrix->GetNonZeroCount() / 2 + n);
+
+    for (GLuint i = 0; i < n; ++i)
+        for (GLuint p = offsets[i]; p < offsets[i + 1] && columns[p] <= i; ++p)
+            triplets.push_back(SparseMatrix<GLdouble>::Triplet(i, columns[p], values[p]));
+
+    _lower.SetFromTriplets(n, n, triplets);
+
+    const GLuint *l_offsets = _lower.GetRowOffsets();
+    const GLuint *l_columns = _lower.GetColumnIndices();
+    GLdouble     *l_values  = _lower.GetValues();
+
+    for (GLuint i = 0; i < n; ++i)
+    {
+        GLuint diag = l_offsets[i + 1] - 1;
+        if (l_offsets[i + 1] == l_offsets[i] || l_columns[diag] != i)
+            return GL_FALSE;
+
+        // L(i, k) = (A(i, k) - sum_{j < k} L(i, j) L(k, j)) / L(k, k), the sums run over the common pattern
+        for (GLuint p = l_offsets[i]; p < diag; ++p)
+        {
+            GLuint   k   = l_columns[p];
+            GLdouble sum = l_values[p];
+
+            GLuint q = l_offsets[i], r = l_offsets[k], r_end = l_offsets[k + 1] - 1;
+            while (q < p && r < r_end)
+            {
+                if (l_columns[q] < l_columns[r])
+                    ++q;
+                else if (l_columns[q] > l_columns[r])
+                    ++r;
+                else
+                    sum -= l_values[q++] * l_values[r++];
+            }
+
+            l_values[p] = sum / l_values[r_end];
+        }
+
+        GLdouble pivot = l_values[diag] * (1.0 + shift);
+        for (GLuint p = l_offsets[i]; p < diag; ++p)
+            pivot -= l_values[p] * l_values[p];
+
+        if (!(pivot > 0.0))
+            return GL_FALSE;
+
+        l_values[diag] = sqrt(pivot);
+    }
+
+    // L^T, the diagonal element comes first within each row
+    triplets.clear();
+    for (GLuint i = 0; i < n; ++i)
+        for (GLuint p = l_offsets[i]; p < l_offsets[i + 1]; ++p)
+            triplets.push_back(SparseMatrix<GLdouble>::Triplet(l_columns[p], i, l_values[p]));
+
+    _upper.SetFromTriplets(n, n, triplets);
+
+    return GL_TRUE;
+}
+
+GLboolean ConjugateGradientSolver::SetMatrix(const SparseMatrix<GLdouble>& a, Preconditioner preconditioner)
+{
+    if (a.GetRowCount() != a.GetColumnCount())
+        return GL_FALSE;
+
+    vector<GLdouble> diagonal;
+    a.GetDiagonal(diagonal);
+
+    for (GLuint i = 0; i < diagonal.size(); ++i)
+        if (!(diagonal[i] > 0.0))
+            return GL_FALSE;
+
+    _matrix         = &a;
+    _preconditioner = preconditioner;
+
+    _inverse_diagonal.resize(diagonal.size());
+    for (GLuint i = 0; i < diagonal.size(); ++i)
+        _inverse_diagonal[i] = 1.0 / diagonal[i];
+
+    _lower = _upper = SparseMatrix<GLdouble>();
+
+    if (_preconditioner == INCOMPLETE_CHOLESKY_PRECONDITIONER)
+    {
+        // IC(0) exists for M-matrices, otherwise the diagonal is increased until it does
+        GLdouble shift = 0.0;
+
+        while (!_CalculateIncompleteCholeskyFactors(shift))
+        {
+            shift = (shift == 0.0) ? 1.0e-3 : 2.0 * shift;
+
+            if (shift > 1.0)
+            {
+                _lower = _upper = SparseMatrix<GLdouble>();
+                _preconditioner = JACOBI_PRECONDITIONER;
+                break;
+            }
+        }
+    }
+
+    return GL_TRUE;
+}
+
+ConjugateGradientSolver::Preconditioner ConjugateGradientSolver::GetPreconditioner() const
+{
+    return _preconditioner;
+}
+
+GLvoid ConjugateGradientSolver::SetTolerance(GLdouble tolerance)
+{
+    _tolerance = tolerance;
+}
+
+GLdouble ConjugateGradientSolver::GetTolerance() const
+{
+    return _tolerance;
+}
+
+GLvoid ConjugateGradientSolver::SetMaximumIterationCount(GLuint maximum_iteration_count)
+{
+    _maximum_iteration_count = maximum_iteration_count;
+}
+
+GLuint ConjugateGradientSolver::GetMaximumIterationCount() const
+{
+    return _maximum_iteration_count;
+}
+
+GLuint ConjugateGradientSolver::GetIterationCount() const
+{
+    return _iteration_count;
+}
+
+GLdouble ConjugateGradientSolver::GetRelativeResidual() const
+{
+    return _relative_residual;
+}
+
+//---------------------------------------------
+// implementation of SparseCholeskyDecomposition
+//---------------------------------------------
+
+// default constructor
+SparseCholeskyDecomposition::SparseCholeskyDecomposition():
+        _size(0),
+        _analyzed(GL_FALSE),
+        _factorized(GL_FALSE),
+        _ordering(NESTED_DISSECTION_ORDERING)
+{
+}
+
+GLboolean SparseCholeskyDecomposition::_HasAnalyzedPattern(const SparseMatrix<GLdouble>& a) const
+{
+    if (a.GetRowCount() != _size || a.GetColumnCount() != _size ||
+        a.GetNonZeroCount() != (GLuint)_pattern_columns.size())
+        return GL_FALSE;
+
+    return equal(_pattern_offsets.begin(), _pattern_offsets.end(), a.GetRowOffsets()) &&
+           equal(_pattern_columns.begin(), _pattern_columns.end(), a.GetColumnIndices());
+}
+
+GLuint SparseCholeskyDecomposition::_Reach(GLuint k, vector<GLuint>& stack, vector<GLuint>& flag) const
+{
+    GLuint top = _size;
+
+    flag[k] = k;
+
+    // the paths from the elements of column k of the upper triangle towards k in the elimination tree
+    for (GLuint p = _upper_column_offsets[k]; p < _upper_column_offsets[k + 1]; ++p)
+    {
+        GLuint i = _upper_row_indices[p], length = 0;
+
+        for (; flag[i] != k; i = (GLuint)_parent[i])
+        {
+            stack[length++] = i;
+            flag[i] = k;
+        }
+
+        while (length > 0)
+            stack[--top] = stack[--length];
+    }
+
+    return top;
+}
+
+GLboolean SparseCholeskyDecomposition::Analyze(const SparseMatrix<GLdouble>& a, Ordering ordering)
+{
+    _analyzed = _factorized = GL_FALSE;
+
+    if (a.GetRowCount() != a.GetColumnCount())
+        return GL_FALSE;
+
+    _size     = a.GetRowCount();
+    _ordering = ordering;
+
+    const GLuint *offsets = a.GetRowOffsets();
+    const GLuint *columns = a.GetColumnIndices();
+
+    _pattern_offsets.assign(offsets, offsets + _size + 1);
+    _pattern_columns.assign(columns, columns + a.GetNonZeroCount());
+
+    // fill-reducing ordering
+    if (ordering == NESTED_DISSECTION_ORDERING)
+    {
+        // adjacency graph without loops
+        vector<GLuint> graph_offsets(_size + 1, 0), adjacency;
+        adjacency.reserve(a.GetNonZeroCount());
+
+        for (GLuint i = 0; i < _size; ++i)
+        {
+            for (GLuint p = offsets[i]; p < offsets[i + 1]; ++p)
+                if (columns[p] != i)
+                    adjacency.push_back(columns[p]);
+            graph_offsets[i + 1] = (GLuint)adjacency.size();
+        }
+
+        NestedDissection(_size, graph_offsets.data(), adjacency.data(), DISSECTION_LEAF_SIZE, _permutation);
+    }
+    else
+    {
+        _permutation.resize(_size);
+        for (GLuint k = 0; k < _size; ++k)
+            _permutation[k] = k;
+    }
+
+    _inverse_permutation.resize(_size);
+    for (GLuint k = 0; k < _size; ++k)
+        _inverse_permutation[_permutation[k]] = k;
+
+    // upper triangle of P A P^T in compressed column format, built from the lower triangle of A
+    _upper_column_offsets.assign(_size + 1, 0);
+
+    for (GLuint i = 0; i < _size; ++i)
+        for (GLuint p = offsets[i]; p < offsets[i + 1] && columns[p] <= i; ++p)
+            ++_upper_column_offsets[max(_inverse_permutation[i], _inverse_permutation[columns[p]]) + 1];
+
+    for (GLuint k = 0; k < _size; ++k)
+        _upper_column_offsets[k + 1] += _upper_column_offsets[k];
+
+    _upper_row_indices.resize(_upper_column_offsets[_size]);
+    _upper_source.resize(_upper_column_offsets[_size]);
+
+    vector<GLuint> next(_upper_column_offsets.begin(), _upper_column_offsets.end() - 1);
+
+    for (GLuint i = 0; i < _size; ++i)
+    {
+        for (GLuint p = offsets[i]; p < offsets[i + 1] && columns[p] <= i; ++p)
+        {
+            GLuint pi = _inverse_permutation[i], pj = _inverse_permutation[columns[p]];
+            GLuint q  = next[max(pi, pj)]++;
+
+            _upper_row_indices[q] = min(pi, pj);
+            _upper_source[q]      = p;
+        }
+    }
+
+    // elimination tree, with path compression through the ancestors
+    _parent.assign(_size, -1);
+    vector<GLint> ancestor(_size, -1);
+
+    for (GLuint k = 0; k < _size; ++k)
+    {
+        for (GLuint p = _upper_column_offsets[k]; p < _upper_column_offsets[k + 1]; ++p)
+        {
+            GLint i = (GLint)_upper_row_indices[p];
+
+            while (i != -1 && i < (GLint)k)
+            {
+                GLint i_next = ancestor[i];
+                ancestor[i] = (GLint)k;
+                if (i_next == -1)
+                    _parent[i] = (GLint)k;
+                i = i_next;
+            }
+        }
+    }
+
+    // column counts of L, row k of L consists of the row subtree of k
+    vector<GLuint> counts(_size, 1), stack(_size), flag(_size, _size);
+
+    for (GLuint k = 0; k < _size; ++k)
+        for (GLuint t = _Reach(k, stack, flag); t < _size; ++t)
+            ++counts[stack[t]];
+
+    _column_offsets.assign(_size + 1, 0);
+    for (GLuint k = 0; k < _size; ++k)
+    {
+        if (_column_offsets[k] > numeric_limits<GLuint>::max() - counts[k])
+            return GL_FALSE;
+        _column_offsets[k + 1] = _column_offsets[k] + counts[k];
+    }
+
+    _row_indices.resize(_column_offsets[_size]);
+    _values.resize(_column_offsets[_size]);
+
+    _analyzed = GL_TRUE;
+
+    return GL_TRUE;
+}
+
+GLboolean SparseCholeskyDecomposition::Factorize(const SparseMatrix<GLdouble>& a)
+{
+    _factorized = GL_FALSE;
+
+    // the positions of the elements of the analyzed pattern are stored by _upper_source
+    if (!_analyzed || !_HasAnalyzedPattern(a))
+        if (!Analyze(a, _ordering))
+            return GL_FALSE;
+
+    const GLdouble *a_values = a.GetValues();
+
+    //-------------------------------------------------------------------------------------
+    // up-looking factorization: row k of L solves the triangular system L[0:k, 0:k] l = a,
+    // where a is column k of the upper triangle; the non-zeros of l are visited in the
+    // topological order given by the elimination tree, while the dense work vector x holds
+    // the partial results
+    //-------------------------------------------------------------------------------------
+    vector<GLdouble> x(_size, 0.0);
+    vector<GLuint>   next(_column_offsets.begin(), _column_offsets.end() - 1), stack(_size), flag(_size, _size);
+
+    for (GLuint k = 0; k < _size; ++k)
+    {
+        GLuint top = _Reach(k, stack, flag);
+
+        for (GLuint p = _upper_column_offsets[k]; p < _upper_column_offsets[k + 1]; ++p)
+            x[_upper_row_indices[p]] = a_values[_upper_source[p]];
+
+        GLdouble d = x[k];
+        x[k] = 0.0;
+
+        for (; top < _size; ++top)
+        {
+            GLuint   i    = stack[top];
+            GLdouble l_ki = x[i] / _values[_column_offsets[i]];
+            x[i] = 0.0;
+
+            for (GLuint p = _column_offsets[i] + 1; p < next[i]; ++p)
+                x[_row_indices[p]] -= _values[p] * l_ki;
+
+            d -= l_ki * l_ki;
+
+            GLuint p = next[i]++;
+            _row_indices[p] = k;
+            _values[p]      = l_ki;
+        }
+
+        if (!(d > 0.0))
+            return GL_FALSE;
+
+        GLuint p = next[k]++;
+        _row_indices[p] = k;
+        _values[p]      = sqrt(d);
+    }
+
+    _factorized = GL_TRUE;
+
+    return GL_TRUE;
+}
+
+GLuint SparseCholeskyDecomposition::GetFactorNonZeroCount() const
+{
+    return (GLuint)_values.size();
+}
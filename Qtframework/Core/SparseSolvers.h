@@ -0,0 +1,368 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "DCoordinates3.h"
+#include "SparseMatrices.h"
+
+namespace cagd
+{
+    //------------------------------
+    // class ConjugateGradientSolver
+    //------------------------------
+    // preconditioned conjugate gradient method for sparse symmetric positive definite systems A * x = b,
+    // where b and x are vectors of scalars or of Descartes coordinates; in the latter case the 3 coordinate
+    // systems are iterated simultaneously (with their own step lengths), such that every iteration reads the
+    // matrix only once
+    class ConjugateGradientSolver
+    {
+    public:
+        // JACOBI_PRECONDITIONER scales by the inverse diagonal, INCOMPLETE_CHOLESKY_PRECONDITIONER applies the
+        // incomplete Cholesky factorization without fill-in, i.e., IC(0)
+        enum Preconditioner {NO_PRECONDITIONER, JACOBI_PRECONDITIONER, INCOMPLETE_CHOLESKY_PRECONDITIONER};
+
+        // length of the chunks of the (deterministic) parallel inner products
+        static const GLuint REDUCTION_CHUNK_SIZE = 4096;
+
+    protected:
+        const SparseMatrix<GLdouble> *_matrix;  // not owned, it has to outlive the solver
+        Preconditioner                _preconditioner;
+        std::vector<GLdouble>         _inverse_diagonal;
+        SparseMatrix<GLdouble>        _lower, _upper;  // IC(0) factors L and L^T, their diagonals are stored last,
+                                                       // resp. first within the rows
+        GLdouble                      _tolerance;
+        GLuint                        _maximum_iteration_count;
+        GLuint                        _iteration_count;
+        GLdouble                      _relative_residual;
+
+        // IC(0) factorization of the lower triangle of A + shift * diag(A), fails on a non-positive pivot
+        GLboolean _CalculateIncompleteCholeskyFactors(GLdouble shift);
+
+        // z = M^{-1} r
+        template <class V>
+        GLvoid _Precondition(const std::vector<V>& r, std::vector<V>& z) const;
+
+        // coordinate-wise inner product sum_i a_i .* b_i
+        template <class V>
+        static V _Dot(const std::vector<V>& a, const std::vector<V>& b);
+
+        // coordinate-wise arithmetic of step lengths, quotients by zero are zero
+        static GLdouble     _Multiply(GLdouble a, GLdouble b);
+        static DCoordinate3 _Multiply(const DCoordinate3& a, const DCoordinate3& b);
+        static GLdouble     _Divide(GLdouble a, GLdouble b);
+        static DCoordinate3 _Divide(const DCoordinate3& a, const DCoordinate3& b);
+
+        // largest coordinate-wise sqrt(rr / bb), coordinates with bb = 0 are skipped
+        static GLdouble _RelativeResidual(GLdouble rr, GLdouble bb);
+        static GLdouble _RelativeResidual(const DCoordinate3& rr, const DCoordinate3& bb);
+
+    public:
+        // default constructor
+        ConjugateGradientSolver();
+
+        // prepares the preconditioner of the square matrix a; fails if a is not square or if its diagonal is not
+        // positive; if the incomplete Cholesky factorization breaks down even for diagonally shifted matrices,
+        // the Jacobi preconditioner is used instead
+        GLboolean SetMatrix(const SparseMatrix<GLdouble>& a, Preconditioner preconditioner = INCOMPLETE_CHOLESKY_PRECONDITIONER);
+
+        // the preconditioner actually in use
+        Preconditioner GetPreconditioner() const;
+
+        // the iteration stops when ||b - A * x|| <= tolerance * ||b|| holds for every coordinate
+        GLvoid   SetTolerance(GLdouble tolerance);
+        GLdouble GetTolerance() const;
+
+        // 0 (default) stands for the size of the system
+        GLvoid   SetMaximumIterationCount(GLuint maximum_iteration_count);
+        GLuint   GetMaximumIterationCount() const;
+
+        // statistics of the latest Solve call
+        GLuint   GetIterationCount() const;
+        GLdouble GetRelativeResidual() const;
+
+        // x is used as initial guess if its size matches the system, otherwise the iteration starts from the
+        // null vector; fails if the tolerance is not reached within the maximum number of iterations
+        template <class V>
+        GLboolean Solve(const std::vector<V>& b, std::vector<V>& x);
+    };
+
+    //----------------------------------
+    // class SparseCholeskyDecomposition
+    //----------------------------------
+    // sparse direct solver of symmetric positive definite systems: P A P^T = L L^T, where the permutation P
+    // reduces the fill-in of the (simplicial) factor L
+    //
+    // Analyze() determines P, the elimination tree and the sparsity pattern of L; Factorize() determines
+    // the values of L by the up-looking algorithm and can be repeated for matrices of the same pattern, e.g.,
+    // during an iterative fairing process.
+    class SparseCholeskyDecomposition
+    {
+    public:
+        // NESTED_DISSECTION_ORDERING recursively splits the adjacency graph of A by breadth-first level sets
+        // and eliminates the separators last, which keeps the fill-in of mesh and grid-like matrices low
+        enum Ordering {NATURAL_ORDERING, NESTED_DISSECTION_ORDERING};
+
+        // parts of the graph with at most this many nodes are not dissected further
+        static const GLuint DISSECTION_LEAF_SIZE = 64;
+
+    protected:
+        GLuint                _size;
+        GLboolean             _analyzed, _factorized;
+        Ordering              _ordering;
+        std::vector<GLuint>   _pattern_offsets;      // sparsity pattern of the analyzed matrix, i.e., its row
+        std::vector<GLuint>   _pattern_columns;      // offsets and column indices
+        std::vector<GLuint>   _permutation;          // row k of P A P^T is row _permutation[k] of A
+        std::vector<GLuint>   _inverse_permutation;
+        std::vector<GLint>    _parent;               // elimination tree, -1 marks the roots
+        std::vector<GLuint>   _upper_column_offsets; // upper triangle of P A P^T, in compressed column format
+        std::vector<GLuint>   _upper_row_indices;
+        std::vector<GLuint>   _upper_source;         // position of each element of the upper triangle in A
+        std::vector<GLuint>   _column_offsets;       // L in compressed column format, the diagonal element comes
+        std::vector<GLuint>   _row_indices;          // first in each column
+        std::vector<GLdouble> _values;
+
+        // pattern of row k of L, i.e., the nodes of the row subtree of k, stored by stack[top:_size) in
+        // topological order; flag has to differ from k at all nodes before the call
+        GLuint _Reach(GLuint k, std::vector<GLuint>& stack, std::vector<GLuint>& flag) const;
+
+        // set, if the sparsity pattern of a coincides with the analyzed one
+        GLboolean _HasAnalyzedPattern(const SparseMatrix<GLdouble>& a) const;
+
+    public:
+        // default constructor
+        SparseCholeskyDecomposition();
+
+        // symbolic analysis of the symmetric matrix a (only its lower triangle is read); fails if a is not square
+        GLboolean Analyze(const SparseMatrix<GLdouble>& a, Ordering ordering = NESTED_DISSECTION_ORDERING);
+
+        // numeric factorization of a matrix with the analyzed sparsity pattern; a is analyzed first (by the
+        // ordering of the latest analysis) if no matrix or one of another pattern has been analyzed; fails if
+        // a is not positive definite
+        GLboolean Factorize(const SparseMatrix<GLdouble>& a);
+
+        // number of the stored elements of L
+        GLuint GetFactorNonZeroCount() const;
+
+        // solves A * x = b by permuted forward and back substitutions
+        template <class V>
+        GLboolean Solve(const std::vector<V>& b, std::vector<V>& x) const;
+    };
+
+    //-----------------------------------------
+    // implementation of ConjugateGradientSolver
+    //-----------------------------------------
+    inline GLdouble ConjugateGradientSolver::_Multiply(GLdouble a, GLdouble b)
+    {
+        return a * b;
+    }
+
+    inline DCoordinate3 ConjugateGradientSolver::_Multiply(const DCoordinate3& a, const DCoordinate3& b)
+    {
+        return DCoordinate3(a[0] * b[0], a[1] * b[1], a[2] * b[2]);
+    }
+
+    inline GLdouble ConjugateGradientSolver::_Divide(GLdouble a, GLdouble b)
+    {
+        return b != 0.0 ? a / b : 0.0;
+    }
+
+    inline DCoordinate3 ConjugateGradientSolver::_Divide(const DCoordinate3& a, const DCoordinate3& b)
+    {
+        return DCoordinate3(_Divide(a[0], b[0]), _Divide(a[1], b[1]), _Divide(a[2], b[2]));
+    }
+
+    inline GLdouble ConjugateGradientSolver::_RelativeResidual(GLdouble rr, GLdouble bb)
+    {
+        return bb > 0.0 ? std::sqrt(rr / bb) : 0.0;
+    }
+
+    inline GLdouble ConjugateGradientSolver::_RelativeResidual(const DCoordinate3& rr, const DCoordinate3& bb)
+    {
+        return std::max(_RelativeResidual(rr[0], bb[0]),
+                        std::max(_RelativeResidual(rr[1], bb[1]), _RelativeResidual(rr[2], bb[2])));
+    }
+
+    template <class V>
+    V ConjugateGradientSolver::_Dot(const std::vector<V>& a, const std::vector<V>& b)
+    {
+        // the partial sums of the chunks are added in a fixed order, hence the result does not depend on the
+        // number of threads
+        GLint chunk_count = (GLint)((a.size() + REDUCTION_CHUNK_SIZE - 1) / REDUCTION_CHUNK_SIZE);
+        std::vector<V> partial_sums(chunk_count, V());
+
+        GLint thread_count = (GLint)RealSquareMatrix::GetThreadCount();
+
+        #pragma omp parallel for num_threads(thread_count) schedule(static) if(thread_count > 1 && chunk_count > 1)
+        for (GLint c = 0; c < chunk_count; ++c)
+        {
+            GLuint first = (GLuint)c * REDUCTION_CHUNK_SIZE;
+            GLuint last  = std::min(first + REDUCTION_CHUNK_SIZE, (GLuint)a.size());
+
+            V sum = V();
+            for (GLuint i = first; i < last; ++i)
+                sum += _Multiply(a[i], b[i]);
+            partial_sums[c] = sum;
+        }
+
+        V result = V();
+        for (GLint c = 0; c < chunk_count; ++c)
+            result += partial_sums[c];
+
+        return result;
+    }
+
+    template <class V>
+    GLvoid ConjugateGradientSolver::_Precondition(const std::vector<V>& r, std::vector<V>& z) const
+    {
+        GLuint n = (GLuint)r.size();
+        z.resize(n);
+
+        switch (_preconditioner)
+        {
+        case NO_PRECONDITIONER:
+            z = r;
+            break;
+
+        case JACOBI_PRECONDITIONER:
+            for (GLuint i = 0; i < n; ++i)
+                z[i] = _inverse_diagonal[i] * r[i];
+            break;
+
+        case INCOMPLETE_CHOLESKY_PRECONDITIONER:
+            {
+                // L y = r
+                const GLuint   *offsets = _lower.GetRowOffsets();
+                const GLuint   *columns = _lower.GetColumnIndices();
+                const GLdouble *values  = _lower.GetValues();
+
+                for (GLuint i = 0; i < n; ++i)
+                {
+                    V      sum  = r[i];
+                    GLuint diag = offsets[i + 1] - 1;
+                    for (GLuint p = offsets[i]; p < diag; ++p)
+                        sum -= values[p] * z[columns[p]];
+                    z[i] = sum / values[diag];
+                }
+
+                // L^T z = y
+                offsets = _upper.GetRowOffsets();
+                columns = _upper.GetColumnIndices();
+                values  = _upper.GetValues();
+
+                for (GLuint i = n; i-- > 0; )
+                {
+                    V      sum  = z[i];
+                    GLuint diag = offsets[i];
+                    for (GLuint p = diag + 1; p < offsets[i + 1]; ++p)
+                        sum -= values[p] * z[columns[p]];
+                    z[i] = sum / values[diag];
+                }
+            }
+            break;
+        }
+    }
+
+    template <class V>
+    GLboolean ConjugateGradientSolver::Solve(const std::vector<V>& b, std::vector<V>& x)
+    {
+        _iteration_count   = 0;
+        _relative_residual = -1.0;
+
+        if (!_matrix || b.size() != _matrix->GetRowCount())
+            return GL_FALSE;
+
+        GLuint n = (GLuint)b.size();
+
+        if (x.size() != n)
+            x.assign(n, V());
+
+        std::vector<V> r(n), z, p, q;
+
+        // r = b - A * x
+        _matrix->Multiply(x, q);
+        for (GLuint i = 0; i < n; ++i)
+            r[i] = b[i] - q[i];
+
+        V bb = _Dot(b, b);
+
+        _Precondition(r, z);
+        p = z;
+
+        V rz = _Dot(r, z);
+
+        GLuint maximum_iteration_count = _maximum_iteration_count ? _maximum_iteration_count : n;
+
+        for (;;)
+        {
+            _relative_residual = _RelativeResidual(_Dot(r, r), bb);
+
+            if (_relative_residual <= _tolerance)
+                return GL_TRUE;
+
+            if (_iteration_count == maximum_iteration_count || !std::isfinite(_relative_residual))
+                return GL_FALSE;
+
+            ++_iteration_count;
+
+            _matrix->Multiply(p, q);
+
+            V alpha = _Divide(rz, _Dot(p, q));
+
+            for (GLuint i = 0; i < n; ++i)
+            {
+                x[i] += _Multiply(alpha, p[i]);
+                r[i] -= _Multiply(alpha, q[i]);
+            }
+
+            _Precondition(r, z);
+
+            V rz_next = _Dot(r, z);
+            V beta    = _Divide(rz_next, rz);
+            rz        = rz_next;
+
+            for (GLuint i = 0; i < n; ++i)
+                p[i] = z[i] + _Multiply(beta, p[i]);
+        }
+    }
+
+    //---------------------------------------------
+    // implementation of SparseCholeskyDecomposition
+    //---------------------------------------------
+    template <class V>
+    GLboolean SparseCholeskyDecomposition::Solve(const std::vector<V>& b, std::vector<V>& x) const
+    {
+        if (!_factorized || b.size() != _size)
+            return GL_FALSE;
+
+        std::vector<V> y(_size);
+        for (GLuint k = 0; k < _size; ++k)
+            y[k] = b[_permutation[k]];
+
+        // L y = P b
+        for (GLuint j = 0; j < _size; ++j)
+        {
+            V y_j = y[j] / _values[_column_offsets[j]];
+            y[j] = y_j;
+
+            for (GLuint p = _column_offsets[j] + 1; p < _column_offsets[j + 1]; ++p)
+                y[_row_indices[p]] -= _values[p] * y_j;
+        }
+
+        // L^T z = y
+        for (GLuint j = _size; j-- > 0; )
+        {
+            V sum = y[j];
+            for (GLuint p = _column_offsets[j] + 1; p < _column_offsets[j + 1]; ++p)
+                sum -= _values[p] * y[_row_indices[p]];
+            y[j] = sum / _values[_column_offsets[j]];
+        }
+
+        x.resize(_size);
+        for (GLuint k = 0; k < _size; ++k)
+            x[_permutation[k]] = y[k];
+
+        return GL_TRUE;
+    }
+}
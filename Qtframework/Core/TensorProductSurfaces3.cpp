@@ -1,5 +1,9 @@
 #include "TensorProductSurfaces3.h"
 #include "RealSquareMatrices.h"
+#include "RealRectangularMatrices.h"
+#include "MatrixAlgebra.h"
+#include "Arenas.h"
+#include "DCoordinate3Arrays.h"
 #include <algorithm>
 
 using namespace cagd;
@@ -11,8 +15,121 @@ TensorProductSurface3::PartialDerivatives::PartialDerivatives(GLuint maximum_ord
 {
 }
 
+// samples the blending functions and their first order derivatives along the grid lines of one direction
+static GLboolean TabulateBlendingFunctions(
+        const TensorProductSurface3& surface, GLboolean u_direction,
+        GLdouble t_min, GLdouble t_max, GLuint div_point_count, GLuint function_count,
+        Matrix<GLdouble>& derivatives, ArenaMatrix<GLdouble>& values, ArenaMatrix<GLdouble>& d1_values)
+{
+    values.ResizeRows(div_point_count);
+    values.ResizeColumns(function_count);
+    d1_values.ResizeRows(div_point_count);
+    d1_values.ResizeColumns(function_count);
+
+    GLdouble dt = (t_max - t_min) / (div_point_count - 1);
+
+    for (GLuint i = 0; i < div_point_count; ++i)
+    {
+        GLdouble t = min(t_min + i * dt, t_max);
+
+        GLboolean available = u_direction ?
+                              surface.UBlendingFunctionDerivatives(1, t, derivatives) :
+                              surface.VBlendingFunctionDerivatives(1, t, derivatives);
+
+        if (!available || derivatives.GetRowCount() < 2 || derivatives.GetColumnCount() != function_count)
+            return GL_FALSE;
+
+        values.SetRow(i, derivatives.Row(0));
+        d1_values.SetRow(i, derivatives.Row(1));
+    }
+
+    return GL_TRUE;
+}
+
+// the elements of a double precision table in the scalar type T: double precision tables are used in place,
+// while the others are rounded into the given storage
+static const GLdouble* ScalarData(const ArenaMatrix<GLdouble>& table, ArenaMatrix<GLdouble>&)
+{
+    return table.GetData();
+}
+
+template <typename T>
+static const T* ScalarData(const ArenaMatrix<GLdouble>& table, ArenaMatrix<T>& storage)
+{
+    storage.ResizeRows(table.GetRowCount());
+    storage.ResizeColumns(table.GetColumnCount());
+
+    const GLdouble *source = table.GetData();
+    T              *target = storage.GetData();
+
+    for (GLuint i = 0, n = table.GetRowCount() * table.GetColumnCount(); i < n; ++i)
+        target[i] = (T)source[i];
+
+    return target;
+}
+
+// evaluates the grid points S = F W and the partial derivatives S_u = F' W, S_v = F W_v component-wise, where
+// the rows of F and F' store the u-directional blending function values and derivatives, while the component
+// c of W and W_v occupies the rows [c * row_count, (c + 1) * row_count); the matrix products, the cross products
+// and the normalization run in the scalar type T, i.e., single precision evaluation processes twice as many
+// elements per vector instruction, while the blending functions are always sampled in double precision
+template <typename T>
+static GLvoid EvaluateGrid(
+        const ArenaMatrix<GLdouble>& u_values, const ArenaMatrix<GLdouble>& d1_u_values,
+        const ArenaMatrix<GLdouble>& w_components, const ArenaMatrix<GLdouble>& w_v_components,
+        Coordinate3Array<T>& vertices, Coordinate3Array<T>& normals)
+{
+    GLuint u_div_point_count = u_values.GetRowCount(), row_count = u_values.GetColumnCount();
+    GLuint v_div_point_count = w_components.GetColumnCount();
+
+    ArenaMatrix<T> u_storage, d1_u_storage, w_storage, w_v_storage;
+
+    const T *f   = ScalarData(u_values, u_storage);
+    const T *d1f = ScalarData(d1_u_values, d1_u_storage);
+    const T *w   = ScalarData(w_components, w_storage);
+    const T *w_v = ScalarData(w_v_components, w_v_storage);
+
+    // the element type of the cross products is fixed to Coordinate3Array<T>, hence the partial derivatives S_v
+    // are kept in a per-thread array that only reallocates when a larger grid is tessellated
+    static thread_local Coordinate3Array<T> partial_v;
+    partial_v.Resize(u_div_point_count * v_div_point_count);
+
+    for (GLuint c = 0; c < 3; ++c)
+    {
+        const T *w_c   = w + c * row_count * v_div_point_count;
+        const T *w_v_c = w_v + c * row_count * v_div_point_count;
+
+        GEMM(u_div_point_count, v_div_point_count, row_count,
+             f, row_count, w_c, v_div_point_count,
+             vertices.GetData(c), v_div_point_count);
+
+        GEMM(u_div_point_count, v_div_point_count, row_count,
+             d1f, row_count, w_c, v_div_point_count,
+             normals.GetData(c), v_div_point_count);
+
+        GEMM(u_div_point_count, v_div_point_count, row_count,
+             f, row_count, w_v_c, v_div_point_count,
+             partial_v.GetData(c), v_div_point_count);
+    }
+
+    // unit surface normals
+    normals.CrossProduct(normals, partial_v);
+    normals.Normalize();
+}
+
+// by default the blending function derivatives are not available
+GLboolean TensorProductSurface3::UBlendingFunctionDerivatives(GLuint, GLdouble, Matrix<GLdouble>&) const
+{
+    return GL_FALSE;
+}
+
+GLboolean TensorProductSurface3::VBlendingFunctionDerivatives(GLuint, GLdouble, Matrix<GLdouble>&) const
+{
+    return GL_FALSE;
+}
+
 // generates the image (i.e., the approximating triangulated mesh) of the tensor product surface
-TriangulatedMesh3* TensorProductSurface3::GenerateImage(GLuint u_div_point_count, GLuint v_div_point_count, GLenum usage_flag) const
+TriangulatedMesh3* TensorProductSurface3::GenerateImage(GLuint u_div_point_count, GLuint v_div_point_count, GLenum usage_flag, TriangulatedMesh3::Precision precision) const
 {
     if (u_div_point_count <= 1 || v_div_point_count <= 1)
         return GL_FALSE;
@@ -24,7 +141,7 @@ TriangulatedMesh3* TensorProductSurface3::GenerateImage(GLuint u_div_point_count
     GLuint face_count = 2 * (u_div_point_count - 1) * (v_div_point_count - 1);
 
     TriangulatedMesh3 *result = nullptr;
-    result = new TriangulatedMesh3(vertex_count, face_count, usage_flag);
+    result = new TriangulatedMesh3(vertex_count, face_count, usage_flag, precision);
 
     if (!result)
         return nullptr;
@@ -40,16 +157,106 @@ TriangulatedMesh3* TensorProductSurface3::GenerateImage(GLuint u_div_point_count
     // for face indexing
     GLuint current_face = 0;
 
-    // partial derivatives of order 0, 1, 2, and 3
-    PartialDerivatives pd;
+    GLuint row_count = _data.GetRowCount(), column_count = _data.GetColumnCount();
+
+    // all temporaries below draw from the arena of the calling thread, which is rewound at the end of the job
+    ArenaScope scope;
+
+    // the u- and v-directional blending function tables: row i stores F(u_i), F'(u_i), resp. G(v_j), G'(v_j)
+    ArenaMatrix<GLdouble> u_values, d1_u_values, v_values, d1_v_values;
+
+    // reused by every sample of one direction; the virtual derivative interfaces fix their type to
+    // Matrix<GLdouble>, hence they are kept per thread instead of in the arena, and they keep their storage as
+    // long as the number of blending functions does not change
+    static thread_local Matrix<GLdouble> u_derivatives, v_derivatives;
+
+    GLboolean batched =
+            TabulateBlendingFunctions(*this, GL_TRUE, _u_min, _u_max, u_div_point_count, row_count,
+                                      u_derivatives, u_values, d1_u_values) &&
+            TabulateBlendingFunctions(*this, GL_FALSE, _v_min, _v_max, v_div_point_count, column_count,
+                                      v_derivatives, v_values, d1_v_values);
+
+    if (batched)
+    {
+        // since s(u_i, v_j) = sum_k F_k(u_i) w_{k,j}, where w_{k,j} = sum_l p_{k,l} G_l(v_j), the whole grid is
+        // given by the matrix products S = F W, S_u = F' W and S_v = F W_v, where W = P G^T and W_v = P G'^T;
+        // the rows of W are obtained by transposing G P^T, in order to keep the scalar factor on the left
+        ArenaMatrix<DCoordinate3> transposed_data, transposed_w, w, w_v;
+        Transpose(_data, transposed_data);
+
+        Multiply(v_values, transposed_data, transposed_w);
+        Transpose(transposed_w, w);
+
+        Multiply(d1_v_values, transposed_data, transposed_w);
+        Transpose(transposed_w, w_v);
+
+        // the mesh stores the x, y and z components of its vertices and normals in separate row-major
+        // u_div_point_count x v_div_point_count arrays, hence the products are evaluated component-wise, by
+        // splitting W and W_v into the row_count x v_div_point_count matrices of their components
+        ArenaMatrix<GLdouble> w_components(3 * row_count, v_div_point_count);
+        ArenaMatrix<GLdouble> w_v_components(3 * row_count, v_div_point_count);
+
+        for (GLuint k = 0; k < row_count; ++k)
+        {
+            for (GLuint j = 0; j < v_div_point_count; ++j)
+            {
+                for (GLuint c = 0; c < 3; ++c)
+                {
+                    w_components(c * row_count + k, j)   = w(k, j)[c];
+                    w_v_components(c * row_count + k, j) = w_v(k, j)[c];
+                }
+            }
+        }
+
+        if (precision == TriangulatedMesh3::SINGLE_PRECISION)
+            EvaluateGrid(u_values, d1_u_values, w_components, w_v_components,
+                         (*result)._single_precision_vertex, (*result)._single_precision_normal);
+        else
+            EvaluateGrid(u_values, d1_u_values, w_components, w_v_components,
+                         (*result)._vertex, (*result)._normal);
+    }
+    else
+    {
+        // partial derivatives of order 0, 1, 2, and 3
+        PartialDerivatives pd;
+
+        for (GLuint i = 0; i < u_div_point_count; ++i)
+        {
+            GLdouble u = min(_u_min + i * du, _u_max);
+
+            for (GLuint j = 0; j < v_div_point_count; ++j)
+            {
+                GLdouble v = min(_v_min + j * dv, _v_max);
+                GLuint   index = i * v_div_point_count + j;
+
+                // calculating all needed surface data
+                CalculatePartialDerivatives(1, u, v, pd);
+
+                // unit surface normal
+                DCoordinate3 normal = pd(1, 0);
+                normal ^= pd(1, 1);
+                normal.normalize();
+
+                // surface point and unit normal, rounded to the precision of the mesh
+                if (precision == TriangulatedMesh3::SINGLE_PRECISION)
+                {
+                    (*result)._single_precision_vertex.Set(index, pd(0, 0));
+                    (*result)._single_precision_normal.Set(index, normal);
+                }
+                else
+                {
+                    (*result)._vertex.Set(index, pd(0, 0));
+                    (*result)._normal.Set(index, normal);
+                }
+            }
+        }
+    }
 
     for (GLuint i = 0; i < u_div_point_count; ++i)
     {
-		GLdouble u = min(_u_min + i * du, _u_max);
 		GLfloat  s = min(i * sdu, 1.0f);
         for (GLuint j = 0; j < v_div_point_count; ++j)
         {
-			GLdouble v = min(_v_min + j * dv, _v_max);
 			GLfloat  t = min(j * tdv, 1.0f);
 
             /*
@@ -64,17 +271,6 @@ TriangulatedMesh3* TensorProductSurface3::GenerateImage(GLuint u_div_point_count
             index[2] = index[1] + v_div_point_count;
             index[3] = index[2] - 1;
 
-            // calculating all needed surface data
-            CalculatePartialDerivatives(1, u, v, pd);
-
-            // surface point
-            (*result)._vertex[index[0]] = pd(0, 0);
-
-            // unit surface normal
-            (*result)._normal[index[0]] = pd(1, 0);
-            (*result)._normal[index[0]] ^= pd(1, 1);
-            (*result)._normal[index[0]].normalize();
-
             // texture coordinates
             (*result)._tex[index[0]].s() = s;
             (*result)._tex[index[0]].t() = t;
@@ -169,13 +365,62 @@ GLboolean TensorProductSurface3::UpdateDataForInterpolation(const RowMatrix<GLdo
 
     return GL_TRUE;
 }
+
+// least squares fitting, i.e. sum_{k,l} ||s(u_k, v_l) - d_{k,l}||^2 is minimal
+GLboolean TensorProductSurface3::UpdateDataForLeastSquaresFitting(const RowMatrix<GLdouble>& u_parameter_values, const ColumnMatrix<GLdouble>& v_parameter_values, const Matrix<DCoordinate3>& sample_points)
+{
+    GLuint row_count = _data.GetRowCount();
+    if (!row_count)
+        return GL_FALSE;
+
+    GLuint column_count = _data.GetColumnCount();
+    if (!column_count)
+        return GL_FALSE;
+
+    GLuint u_sample_count = u_parameter_values.GetColumnCount();
+    GLuint v_sample_count = v_parameter_values.GetRowCount();
+
+    if (u_sample_count < row_count || v_sample_count < column_count || sample_points.GetRowCount() != u_sample_count || sample_points.GetColumnCount() != v_sample_count)
+        return GL_FALSE;
+
+    // 1: calculate the u- and v-collocation matrices
+    RowMatrix<GLdouble> u_blending_values;
+
+    RealRectangularMatrix u_collocation_matrix(u_sample_count, row_count);
+
+    for (GLuint k = 0; k < u_sample_count; ++k)
+    {
+        if (!UBlendingFunctionValues(u_parameter_values(k), u_blending_values))
+            return GL_FALSE;
+        u_collocation_matrix.SetRow(k, u_blending_values);
+    }
+
+    RowMatrix<GLdouble> v_blending_values;
+
+    RealRectangularMatrix v_collocation_matrix(v_sample_count, column_count);
+
+    for (GLuint l = 0; l < v_sample_count; ++l)
+    {
+        if (!VBlendingFunctionValues(v_parameter_values(l), v_blending_values))
+            return GL_FALSE;
+        v_collocation_matrix.SetRow(l, v_blending_values);
+    }
+
+    // 2:   the objective equals ||U P V^T - D||_F^2, where U and V denote the collocation matrices, therefore its
+    //      minimizer is P = U^+ D (V^+)^T; first the columns of the row_count x v_sample_count matrix a = U^+ D,
+    //      then the rows of P = a (V^+)^T are determined in the least squares sense
+    Matrix<DCoordinate3> a(row_count, v_sample_count);
+    if (!u_collocation_matrix.SolveLeastSquares(sample_points, a))
+        return GL_FALSE;
+
+    if (!v_collocation_matrix.SolveLeastSquares(a, _data, GL_FALSE))
+        return GL_FALSE;
+
+    return GL_TRUE;
+}
 //mine
 GLvoid TensorProductSurface3::PartialDerivatives::LoadNullVectors(){
-  for (GLuint i=0;i<_row_count;i++) {
-      for (GLuint j=0;j<=i;j++) {
-          _data[i][j]=DCoordinate3(0,0,0);
-        }
-  }
+  fill(_data.begin(), _data.end(), DCoordinate3(0,0,0));
 }
 TensorProductSurface3::TensorProductSurface3( GLdouble u_min, GLdouble u_max, GLdouble v_min, GLdouble v_max,
         GLuint row_count, GLuint column_count,GLboolean u_closed, GLboolean v_closed):_data(row_count,column_count){
@@ -214,6 +459,32 @@ TensorProductSurface3& TensorProductSurface3::operator =(const TensorProductSurf
     }
   return *this;
 }
+TensorProductSurface3::TensorProductSurface3(TensorProductSurface3&& surface) noexcept:_data(std::move(surface._data)){
+  _u_min = surface._u_min;
+  _u_max = surface._u_max;
+  _v_min = surface._v_min;
+  _v_max = surface._v_max;
+  _u_closed = surface._u_closed;
+  _v_closed = surface._v_closed;
+  _vbo_data = surface._vbo_data;
+  surface._vbo_data = 0;
+}
+
+TensorProductSurface3& TensorProductSurface3::operator =(TensorProductSurface3&& surface) noexcept{
+  if(&surface != this){
+      DeleteVertexBufferObjectsOfData();
+      _data = std::move(surface._data);
+      _u_min = surface._u_min;
+      _u_max = surface._u_max;
+      _v_min = surface._v_min;
+      _v_max = surface._v_max;
+      _u_closed = surface._u_closed;
+      _v_closed = surface._v_closed;
+      _vbo_data = surface._vbo_data;
+      surface._vbo_data = 0;
+    }
+  return *this;
+}
 GLvoid TensorProductSurface3::SetUInterval(GLdouble u_min, GLdouble u_max){
   _u_min = u_min;
   _u_max = u_max;
@@ -383,12 +654,13 @@ RowMatrix<GenericCurve3*>* TensorProductSurface3::GenerateUIsoparametricLines(GL
   GLdouble v_step = (_v_max - _v_min) / (div_point_count - 1);
 
   RowMatrix<GenericCurve3*>* result = new RowMatrix<GenericCurve3*>(iso_line_count);
+  // reused by every sample, its packed storage is allocated only once
+  PartialDerivatives pderivs(maximum_order_of_derivatives);
   for(int i=0;i<iso_line_count;i++){
       GLdouble u = _u_min + i*(_u_max-_u_min)/(GLdouble)(iso_line_count-1);
       (*result)[i]=new GenericCurve3(maximum_order_of_derivatives,div_point_count);
       GLdouble v = _v_min;
       for(int k=0;k<div_point_count;++k){
-          PartialDerivatives pderivs(maximum_order_of_derivatives);
           CalculatePartialDerivatives(maximum_order_of_derivatives,u,v,pderivs);
           for (GLuint order = 0; order < maximum_order_of_derivatives+1; ++order)
           {
@@ -398,7 +670,6 @@ RowMatrix<GenericCurve3*>* TensorProductSurface3::GenerateUIsoparametricLines(GL
       }
       for (GLuint order = 0; order < maximum_order_of_derivatives+1; ++order)
       {
-          PartialDerivatives pderivs(maximum_order_of_derivatives);
           CalculatePartialDerivatives(maximum_order_of_derivatives,u,_v_max,pderivs);
         (*((*result)[i]))(order, div_point_count-1) = pderivs(order,order);
       }
@@ -414,12 +685,13 @@ RowMatrix<GenericCurve3*>* TensorProductSurface3::GenerateVIsoparametricLines(GL
   if(maximum_order_of_derivatives > 2)return nullptr;
   GLdouble u_step = (_u_max - _u_min) / (div_point_count - 1);
   RowMatrix<GenericCurve3*>* result = new RowMatrix<GenericCurve3*>(iso_line_count);
+  // reused by every sample, its packed storage is allocated only once
+  PartialDerivatives pderivs(maximum_order_of_derivatives);
   for(int i=0;i<iso_line_count;i++){
       GLdouble v = _v_min + i*(_v_max-_v_min)/(GLdouble)(iso_line_count-1);
       (*result)[i]=new GenericCurve3(maximum_order_of_derivatives,div_point_count);
       GLdouble u = _u_min;
       for(int k=0;k<div_point_count;++k){
-          PartialDerivatives pderivs(maximum_order_of_derivatives);
           CalculatePartialDerivatives(maximum_order_of_derivatives,u,v,pderivs);
           for (GLuint order = 0; order < maximum_order_of_derivatives+1; ++order)
           {
@@ -429,7 +701,6 @@ RowMatrix<GenericCurve3*>* TensorProductSurface3::GenerateVIsoparametricLines(GL
       }
       for (GLuint order = 0; order < maximum_order_of_derivatives+1; ++order)
       {
-          PartialDerivatives pderivs(maximum_order_of_derivatives);
           CalculatePartialDerivatives(maximum_order_of_derivatives,_u_max,v,pderivs);
         (*((*result)[i]))(order, div_point_count-1) = pderivs(order,order);
       }
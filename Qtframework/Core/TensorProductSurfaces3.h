@@ -46,6 +46,12 @@ namespace cagd
         // homework: assignment operator
         TensorProductSurface3& operator =(const TensorProductSurface3& surface);
 
+        // move constructor: takes over the vertex buffer object of the control net
+        TensorProductSurface3(TensorProductSurface3&& surface) noexcept;
+
+        // move assignment operator
+        TensorProductSurface3& operator =(TensorProductSurface3&& surface) noexcept;
+
         // homework: set/get the definition domain of the surface
         GLvoid SetUInterval(GLdouble u_min, GLdouble u_max);
         GLvoid SetVInterval(GLdouble v_min, GLdouble v_max);
@@ -75,6 +81,15 @@ namespace cagd
         virtual GLboolean VBlendingFunctionValues(
                 GLdouble v_knot, RowMatrix<GLdouble>& blending_values) const = 0;
 
+        // blending function values (row 0) and their derivatives up to the given order (row r) in u- and
+        // v-direction; surfaces that provide them at least up to order 1 are tessellated by GenerateImage
+        // as the batched matrix products F(u) * P * G(v)^T, the default implementations return GL_FALSE
+        virtual GLboolean UBlendingFunctionDerivatives(
+                GLuint maximum_order_of_derivatives, GLdouble u_knot, Matrix<GLdouble>& derivatives) const;
+
+        virtual GLboolean VBlendingFunctionDerivatives(
+                GLuint maximum_order_of_derivatives, GLdouble v_knot, Matrix<GLdouble>& derivatives) const;
+
         // calculates the point and higher order (mixed) partial derivatives of the
         // tensor product surface
         //
@@ -86,10 +101,14 @@ namespace cagd
                 GLuint maximum_order_of_partial_derivatives,
                 GLdouble u, GLdouble v, PartialDerivatives& pd) const = 0;
 
-        // generates a triangulated mesh that approximates the shape of the surface above
+        // generates a triangulated mesh that approximates the shape of the surface above; display-only images
+        // may be evaluated and stored in single precision, while the blending functions are always sampled in
+        // double precision; once the calling thread has tessellated a grid of the same size, the only heap
+        // allocations made are those of the returned mesh
         virtual TriangulatedMesh3* GenerateImage(
                 GLuint u_div_point_count, GLuint v_div_point_count,
-                GLenum usage_flag = GL_STATIC_DRAW) const;
+                GLenum usage_flag = GL_STATIC_DRAW,
+                TriangulatedMesh3::Precision precision = TriangulatedMesh3::DOUBLE_PRECISION) const;
 
         // ensures interpolation, i.e., updates the control net $\left[\mathbf{p}_{i,j}\right]_{i=0,j=0}^{n,m}$ stored by
         // the matrix _data such that interpolation conditions $\mathbf{s}(u_k, v_l) = \mathbf{d}_{k,l}$ hold for
@@ -98,6 +117,13 @@ namespace cagd
                 const RowMatrix<GLdouble>& u_knot_vector, const ColumnMatrix<GLdouble>& v_knot_vector,
                 Matrix<DCoordinate3>& data_points_to_interpolate);
 
+        // least squares fitting, i.e., updates the control net such that sum_{k,l} ||s(u_k, v_l) - d_{k,l}||^2 is
+        // minimal, where the sample grid has to have at least as many rows and columns as the control net; the
+        // problem separates into a u- and a v-directional least squares problem, like interpolation does
+        GLboolean UpdateDataForLeastSquaresFitting(
+                const RowMatrix<GLdouble>& u_parameter_values, const ColumnMatrix<GLdouble>& v_parameter_values,
+                const Matrix<DCoordinate3>& sample_points);
+
         // homework: VBO handling methods
         virtual GLvoid    DeleteVertexBufferObjectsOfData();
         virtual GLboolean RenderData(GLenum render_mode = GL_LINE_STRIP) const;
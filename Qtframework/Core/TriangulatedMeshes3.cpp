@@ -8,12 +8,46 @@
 
 using namespace cagd;
 using namespace std;
-TriangulatedMesh3::TriangulatedMesh3(GLuint vertex_count, GLuint face_count, GLenum usage_flag):
+TriangulatedMesh3::TriangulatedMesh3(GLuint vertex_count, GLuint face_count, GLenum usage_flag, Precision precision):
 	_usage_flag(usage_flag),
 	_vbo_vertices(0), _vbo_normals(0), _vbo_tex_coordinates(0), _vbo_indices(0),
-	_vertex(vertex_count), _normal(vertex_count), _tex(vertex_count),
-	_face(face_count)
+	_precision(precision),
+	_tex(vertex_count),
+	_face(face_count),
+	texture(0), height(0), width(0)
 {
+    if (precision == SINGLE_PRECISION)
+    {
+        _single_precision_vertex.Resize(vertex_count);
+        _single_precision_normal.Resize(vertex_count);
+    }
+    else
+    {
+        _vertex.Resize(vertex_count);
+        _normal.Resize(vertex_count);
+    }
+}
+
+GLvoid TriangulatedMesh3::_SetPrecision(Precision precision)
+{
+    GLuint vertex_count = VertexCount();
+
+    _precision = precision;
+
+    if (precision == SINGLE_PRECISION)
+    {
+        _vertex = DCoordinate3Array();
+        _normal = DCoordinate3Array();
+        _single_precision_vertex.Resize(vertex_count);
+        _single_precision_normal.Resize(vertex_count);
+    }
+    else
+    {
+        _single_precision_vertex = FCoordinate3Array();
+        _single_precision_normal = FCoordinate3Array();
+        _vertex.Resize(vertex_count);
+        _normal.Resize(vertex_count);
+    }
 }
 
 GLboolean TriangulatedMesh3::bindTextureImage(FIBITMAP * content,BYTE * data){
@@ -43,8 +77,11 @@ TriangulatedMesh3::TriangulatedMesh3(const TriangulatedMesh3 &mesh):
         _usage_flag(mesh._usage_flag),
         _vbo_vertices(0), _vbo_normals(0), _vbo_tex_coordinates(0), _vbo_indices(0),
 		_leftmost_vertex(mesh._leftmost_vertex), _rightmost_vertex(mesh._rightmost_vertex),
+        _precision(mesh._precision),
         _vertex(mesh._vertex),
         _normal(mesh._normal),
+        _single_precision_vertex(mesh._single_precision_vertex),
+        _single_precision_normal(mesh._single_precision_normal),
         _tex(mesh._tex),
         _face(mesh._face)
 {
@@ -61,8 +98,11 @@ TriangulatedMesh3& TriangulatedMesh3::operator =(const TriangulatedMesh3& rhs)
         _usage_flag       = rhs._usage_flag;
 		_leftmost_vertex  = rhs._leftmost_vertex;
         _rightmost_vertex = rhs._rightmost_vertex;
+        _precision        = rhs._precision;
         _vertex			  = rhs._vertex;
         _normal		      = rhs._normal;
+        _single_precision_vertex = rhs._single_precision_vertex;
+        _single_precision_normal = rhs._single_precision_normal;
         _tex              = rhs._tex;
         _face             = rhs._face;
 
@@ -73,6 +113,55 @@ TriangulatedMesh3& TriangulatedMesh3::operator =(const TriangulatedMesh3& rhs)
     return *this;
 }
 
+TriangulatedMesh3::TriangulatedMesh3(TriangulatedMesh3&& mesh) noexcept:
+        _usage_flag(mesh._usage_flag),
+        _vbo_vertices(mesh._vbo_vertices), _vbo_normals(mesh._vbo_normals),
+        _vbo_tex_coordinates(mesh._vbo_tex_coordinates), _vbo_indices(mesh._vbo_indices),
+        _leftmost_vertex(mesh._leftmost_vertex), _rightmost_vertex(mesh._rightmost_vertex),
+        _precision(mesh._precision),
+        _vertex(std::move(mesh._vertex)),
+        _normal(std::move(mesh._normal)),
+        _single_precision_vertex(std::move(mesh._single_precision_vertex)),
+        _single_precision_normal(std::move(mesh._single_precision_normal)),
+        _tex(std::move(mesh._tex)),
+        _face(std::move(mesh._face)),
+        texture(mesh.texture), height(mesh.height), width(mesh.width)
+{
+    mesh._vbo_vertices = mesh._vbo_normals = mesh._vbo_tex_coordinates = mesh._vbo_indices = 0;
+    mesh.texture = 0;
+}
+
+TriangulatedMesh3& TriangulatedMesh3::operator =(TriangulatedMesh3&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        DeleteVertexBufferObjects();
+
+        _usage_flag          = rhs._usage_flag;
+        _vbo_vertices        = rhs._vbo_vertices;
+        _vbo_normals         = rhs._vbo_normals;
+        _vbo_tex_coordinates = rhs._vbo_tex_coordinates;
+        _vbo_indices         = rhs._vbo_indices;
+        _leftmost_vertex     = rhs._leftmost_vertex;
+        _rightmost_vertex    = rhs._rightmost_vertex;
+        _precision           = rhs._precision;
+        _vertex              = std::move(rhs._vertex);
+        _normal              = std::move(rhs._normal);
+        _single_precision_vertex = std::move(rhs._single_precision_vertex);
+        _single_precision_normal = std::move(rhs._single_precision_normal);
+        _tex                 = std::move(rhs._tex);
+        _face                = std::move(rhs._face);
+        texture              = rhs.texture;
+        height               = rhs.height;
+        width                = rhs.width;
+
+        rhs._vbo_vertices = rhs._vbo_normals = rhs._vbo_tex_coordinates = rhs._vbo_indices = 0;
+        rhs.texture = 0;
+    }
+
+    return *this;
+}
+
 GLvoid TriangulatedMesh3::DeleteVertexBufferObjects()
 {
     if (_vbo_vertices)
@@ -216,7 +305,7 @@ GLboolean TriangulatedMesh3::UpdateVertexBufferObjects(GLenum usage_flag)
 
     // Notice that multiple buffers can be mapped simultaneously.
 
-    GLuint vertex_byte_size = 3 * (GLuint)_vertex.size() * sizeof(GLfloat);
+    GLuint vertex_byte_size = 3 * VertexCount() * sizeof(GLfloat);
 
     glBindBuffer(GL_ARRAY_BUFFER, _vbo_vertices);
     glBufferData(GL_ARRAY_BUFFER, vertex_byte_size, 0, _usage_flag);
@@ -228,18 +317,16 @@ GLboolean TriangulatedMesh3::UpdateVertexBufferObjects(GLenum usage_flag)
 
     GLfloat *normal_coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
 
-    for (vector<DCoordinate3>::const_iterator
-         vit = _vertex.begin(),
-         nit = _normal.begin(); vit != _vertex.end(); ++vit, ++nit)
+    // single precision geometry is only interleaved
+    if (_precision == SINGLE_PRECISION)
     {
-        for (GLint component = 0; component < 3; ++component)
-        {
-            *vertex_coordinate = (GLfloat)(*vit)[component];
-            ++vertex_coordinate;
-
-            *normal_coordinate = (GLfloat)(*nit)[component];
-            ++normal_coordinate;
-        }
+        _single_precision_vertex.PackToFloats(vertex_coordinate);
+        _single_precision_normal.PackToFloats(normal_coordinate);
+    }
+    else
+    {
+        _vertex.PackToFloats(vertex_coordinate);
+        _normal.PackToFloats(normal_coordinate);
     }
 
     GLuint tex_byte_size = 4 * (GLuint)_tex.size() * sizeof(GLfloat);
@@ -296,9 +383,9 @@ GLboolean TriangulatedMesh3::SaveToOFF(const std::string& file_name) const{
       return GL_FALSE;
   f<<"OFF"<<endl;
   f<<VertexCount()<<" "<<FaceCount()<<" "<<edgeCount()<<endl;
-  for (vector<DCoordinate3>::const_iterator vit = _vertex.begin(); vit != _vertex.end(); ++vit)
+  for (GLuint i = 0; i < VertexCount(); ++i)
   {
-      f << *vit<<endl;
+      f << _Vertex(i)<<endl;
   }
   // saving faces
   for (vector<TriangularFace>::const_iterator fit = _face.begin(); fit != _face.end(); ++fit){
@@ -308,6 +395,98 @@ GLboolean TriangulatedMesh3::SaveToOFF(const std::string& file_name) const{
   return GL_TRUE;
 }
 //eof mine
+
+GLboolean TriangulatedMesh3::CalculateCotangentLaplacian(SparseMatrix<GLdouble>& laplacian) const
+{
+    GLuint vertex_count = VertexCount();
+
+    vector<SparseMatrix<GLdouble>::Triplet> triplets;
+    triplets.reserve(12 * _face.size());
+
+    for (vector<TriangularFace>::const_iterator fit = _face.begin(); fit != _face.end(); ++fit)
+    {
+        for (GLuint corner = 0; corner < 3; ++corner)
+        {
+            // the angle at node k is opposite to the edge (i, j)
+            GLuint k = (*fit)[corner], i = (*fit)[(corner + 1) % 3], j = (*fit)[(corner + 2) % 3];
+
+            if (i >= vertex_count || j >= vertex_count || k >= vertex_count)
+                return GL_FALSE;
+
+            DCoordinate3 a = _Vertex(i) - _Vertex(k);
+            DCoordinate3 b = _Vertex(j) - _Vertex(k);
+
+            GLdouble sine = (a ^ b).length();
+            if (sine == 0.0)
+                continue;
+
+            GLdouble weight = 0.5 * (a * b) / sine;
+
+            triplets.push_back(SparseMatrix<GLdouble>::Triplet(i, i,  weight));
+            triplets.push_back(SparseMatrix<GLdouble>::Triplet(j, j,  weight));
+            triplets.push_back(SparseMatrix<GLdouble>::Triplet(i, j, -weight));
+            triplets.push_back(SparseMatrix<GLdouble>::Triplet(j, i, -weight));
+        }
+    }
+
+    return laplacian.SetFromTriplets(vertex_count, vertex_count, triplets);
+}
+// the normals are accumulated in the precision of the mesh
+template <typename T>
+static GLvoid AccumulateFaceNormals(const vector<TriangularFace>& faces,
+                                    const Coordinate3Array<T>& vertices, Coordinate3Array<T>& normals)
+{
+    normals.Resize(vertices.GetSize());
+    normals.LoadNullVectors();
+
+    const T *x = vertices.GetData(0), *y = vertices.GetData(1), *z = vertices.GetData(2);
+    T       *nx = normals.GetData(0), *ny = normals.GetData(1), *nz = normals.GetData(2);
+
+    // the face normals are accumulated at the nodes in the same pass in which they are determined, since the
+    // indexed loads and stores dominate the cost of the cross products
+    for (vector<TriangularFace>::const_iterator fit = faces.begin(); fit != faces.end(); ++fit)
+    {
+        GLuint i = (*fit)[0], j = (*fit)[1], k = (*fit)[2];
+
+        T ax = x[j] - x[i], ay = y[j] - y[i], az = z[j] - z[i];
+        T bx = x[k] - x[i], by = y[k] - y[i], bz = z[k] - z[i];
+
+        T cx = ay * bz - az * by;
+        T cy = az * bx - ax * bz;
+        T cz = ax * by - ay * bx;
+
+        nx[i] += cx; ny[i] += cy; nz[i] += cz;
+        nx[j] += cx; ny[j] += cy; nz[j] += cz;
+        nx[k] += cx; ny[k] += cy; nz[k] += cz;
+    }
+
+    normals.Normalize();
+}
+
+GLboolean TriangulatedMesh3::UpdateVertexNormals()
+{
+    GLuint vertex_count = VertexCount();
+
+    for (vector<TriangularFace>::const_iterator fit = _face.begin(); fit != _face.end(); ++fit)
+        if ((*fit)[0] >= vertex_count || (*fit)[1] >= vertex_count || (*fit)[2] >= vertex_count)
+            return GL_FALSE;
+
+    if (_precision == SINGLE_PRECISION)
+        AccumulateFaceNormals(_face, _single_precision_vertex, _single_precision_normal);
+    else
+        AccumulateFaceNormals(_face, _vertex, _normal);
+
+    return GL_TRUE;
+}
+
+GLboolean TriangulatedMesh3::UpdateBoundingBox()
+{
+    if (_precision == SINGLE_PRECISION)
+        return _single_precision_vertex.CalculateBounds(_leftmost_vertex, _rightmost_vertex);
+
+    return _vertex.CalculateBounds(_leftmost_vertex, _rightmost_vertex);
+}
+
 GLboolean TriangulatedMesh3::LoadFromOFF(
         const string &file_name, GLboolean translate_and_scale_to_unit_cube)
 {
@@ -331,35 +510,23 @@ GLboolean TriangulatedMesh3::LoadFromOFF(
     f >> vertex_count >> face_count >> edge_count;
 
     // allocating memory for vertices, unit normal vectors, texture coordinates, and faces
-    _vertex.resize(vertex_count);
-    _normal.resize(vertex_count);
+    _SetPrecision(DOUBLE_PRECISION);
+    _vertex.Resize(vertex_count);
+    _normal.Resize(vertex_count);
     _tex.resize(vertex_count);
     _face.resize(face_count);
 
-    // initializing the leftmost and rightmost corners of the bounding box
-    _leftmost_vertex.x() = _leftmost_vertex.y() = _leftmost_vertex.z() = numeric_limits<GLdouble>::max();
-    _rightmost_vertex.x() = _rightmost_vertex.y() = _rightmost_vertex.z() = -numeric_limits<GLdouble>::max();
-
-    // loading vertices and correcting the leftmost and rightmost corners of the bounding box
-    for (vector<DCoordinate3>::iterator vit = _vertex.begin(); vit != _vertex.end(); ++vit)
+    // loading vertices
+    DCoordinate3 vertex;
+    for (GLuint i = 0; i < vertex_count; ++i)
     {
-        f >> *vit;
-
-        if (vit->x() < _leftmost_vertex.x())
-            _leftmost_vertex.x() = vit->x();
-        if (vit->y() < _leftmost_vertex.y())
-            _leftmost_vertex.y() = vit->y();
-        if (vit->z() < _leftmost_vertex.z())
-            _leftmost_vertex.z() = vit->z();
-
-        if (vit->x() > _rightmost_vertex.x())
-            _rightmost_vertex.x() = vit->x();
-        if (vit->y() > _rightmost_vertex.y())
-            _rightmost_vertex.y() = vit->y();
-        if (vit->z() > _rightmost_vertex.z())
-            _rightmost_vertex.z() = vit->z();
+        f >> vertex;
+        _vertex.Set(i, vertex);
     }
 
+    // determining the leftmost and rightmost corners of the bounding box
+    UpdateBoundingBox();
+
     // if we do not want to preserve the original positions and coordinates of vertices
     if (translate_and_scale_to_unit_cube)
     {
@@ -370,10 +537,11 @@ GLboolean TriangulatedMesh3::LoadFromOFF(
         DCoordinate3 middle(_leftmost_vertex);
         middle += _rightmost_vertex;
         middle *= 0.5;
-        for (vector<DCoordinate3>::iterator vit = _vertex.begin(); vit != _vertex.end(); ++vit)
+        for (GLuint c = 0; c < 3; ++c)
         {
-            *vit -= middle;
-            *vit *= scale;
+            GLdouble *component = _vertex.GetData(c);
+            for (GLuint i = 0; i < vertex_count; ++i)
+                component[i] = (component[i] - middle[c]) * scale;
         }
     }
 
@@ -382,22 +550,8 @@ GLboolean TriangulatedMesh3::LoadFromOFF(
         f >> *fit;
 
     // calculating average unit normal vectors associated with vertices
-    for (vector<TriangularFace>::const_iterator fit = _face.begin(); fit != _face.end(); ++fit)
-    {
-        DCoordinate3 n = _vertex[(*fit)[1]];
-        n -= _vertex[(*fit)[0]];
-
-        DCoordinate3 p = _vertex[(*fit)[2]];
-        p -= _vertex[(*fit)[0]];
-
-        n ^= p;
-
-        for (GLint node = 0; node < 3; ++node)
-            _normal[(*fit)[node]] += n;
-    }
-
-    for (vector<DCoordinate3>::iterator nit = _normal.begin(); nit != _normal.end(); ++nit)
-        nit->normalize();
+    if (!UpdateVertexNormals())
+        return GL_FALSE;
 
     f.close();
 
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "DCoordinates3.h"
+#include "DCoordinate3Arrays.h"
 #include <GL/glew.h>
 #include <iostream>
 #include <string>
 #include "TriangularFaces.h"
+#include "SparseMatrices.h"
 #include "TCoordinates4.h"
 #include <vector>
 #include "Texture/FreeImage.h"
@@ -13,6 +15,11 @@ namespace cagd
 {    
     class TriangulatedMesh3
     {
+    public:
+        // display-only meshes, e.g., preview-quality tessellations, may store their vertices and unit normal
+        // vectors in single precision, since UpdateVertexBufferObjects truncates them to floats anyway
+        enum Precision {DOUBLE_PRECISION, SINGLE_PRECISION};
+
         friend class ParametricSurface3;
         friend class TensorProductSurface3;
 
@@ -24,13 +31,13 @@ namespace cagd
         // list of faces
         friend std::ostream& operator <<(std::ostream& lhs, const TriangulatedMesh3& rhs){
           lhs<<rhs.VertexCount()<<" "<<rhs.FaceCount()<<std::endl;
-          for (std::vector<DCoordinate3>::const_iterator vit = rhs._vertex.begin(); vit != rhs._vertex.end(); ++vit)
+          for (GLuint i = 0; i < rhs.VertexCount(); ++i)
           {
-              lhs << *vit<<std::endl;
+              lhs << rhs._Vertex(i)<<std::endl;
           }
-          for (std::vector<DCoordinate3>::const_iterator vit = rhs._normal.begin(); vit != rhs._normal.end(); ++vit)
+          for (GLuint i = 0; i < rhs.VertexCount(); ++i)
           {
-              lhs << *vit<<std::endl;
+              lhs << rhs._Normal(i)<<std::endl;
           }
           for (std::vector<TCoordinate4>::const_iterator vit = rhs._tex.begin(); vit != rhs._tex.end(); ++vit)
           {
@@ -47,18 +54,22 @@ namespace cagd
         friend std::istream& operator >>(std::istream& lhs, TriangulatedMesh3& rhs){
           GLuint num;
           lhs>>num;//vertex count
-          rhs._vertex.resize(num);
-          rhs._normal.resize(num);
+          rhs._SetPrecision(DOUBLE_PRECISION);
+          rhs._vertex.Resize(num);
+          rhs._normal.Resize(num);
           rhs._tex.resize(num);
           lhs>>num;rhs._face.resize(num);
 
-          for (std::vector<DCoordinate3>::iterator vit = rhs._vertex.begin(); vit != rhs._vertex.end(); ++vit)
+          DCoordinate3 coordinate;
+          for (GLuint i = 0; i < rhs._vertex.GetSize(); ++i)
           {
-              lhs>>(*vit);
+              lhs >> coordinate;
+              rhs._vertex.Set(i, coordinate);
           }
-          for (std::vector<DCoordinate3>::iterator vit = rhs._normal.begin(); vit != rhs._normal.end(); ++vit)
+          for (GLuint i = 0; i < rhs._normal.GetSize(); ++i)
           {
-              lhs >> *vit;
+              lhs >> coordinate;
+              rhs._normal.Set(i, coordinate);
           }
           for (std::vector<TCoordinate4>::iterator vit = rhs._tex.begin(); vit != rhs._tex.end(); ++vit)
           {
@@ -83,18 +94,31 @@ namespace cagd
         DCoordinate3                 _leftmost_vertex;
         DCoordinate3                 _rightmost_vertex;
 
-        // geometry
-        std::vector<DCoordinate3>    _vertex;
-        std::vector<DCoordinate3>    _normal;
+        // geometry, the vertices and unit normal vectors are stored in structure-of-arrays form, either by
+        // _vertex and _normal, or by their single precision counterparts (the others are empty)
+        Precision                    _precision;
+        DCoordinate3Array            _vertex;
+        DCoordinate3Array            _normal;
+        FCoordinate3Array            _single_precision_vertex;
+        FCoordinate3Array            _single_precision_normal;
         std::vector<TCoordinate4>    _tex;
         std::vector<TriangularFace>  _face;
         // My texture stuff
         unsigned texture;
         int height;
         int width;
+
+        // vertices and unit normal vectors by value, independently of the precision
+        DCoordinate3 _Vertex(GLuint index) const;
+        DCoordinate3 _Normal(GLuint index) const;
+
+        // releases the arrays of the other precision and resizes the arrays of the given one to VertexCount()
+        GLvoid _SetPrecision(Precision precision);
+
     public:
         // special and default constructor
-        TriangulatedMesh3(GLuint vertex_count = 0, GLuint face_count = 0, GLenum usage_flag = GL_STATIC_DRAW);
+        TriangulatedMesh3(GLuint vertex_count = 0, GLuint face_count = 0, GLenum usage_flag = GL_STATIC_DRAW,
+                          Precision precision = DOUBLE_PRECISION);
 
         // copy constructor
         TriangulatedMesh3(const TriangulatedMesh3& mesh);
@@ -102,6 +126,12 @@ namespace cagd
         // assignment operator
         TriangulatedMesh3& operator =(const TriangulatedMesh3& rhs);
 
+        // move constructor: takes over the vertex buffer objects and the texture instead of re-uploading them
+        TriangulatedMesh3(TriangulatedMesh3&& mesh) noexcept;
+
+        // move assignment operator
+        TriangulatedMesh3& operator =(TriangulatedMesh3&& rhs) noexcept;
+
         // deletes all vertex buffer objects
         GLvoid DeleteVertexBufferObjects();
 
@@ -116,9 +146,21 @@ namespace cagd
         // at the same time calculates the unit normal vectors associated with vertices
         GLboolean LoadFromOFF(const std::string& file_name, GLboolean translate_and_scale_to_unit_cube = GL_FALSE);
 
+        // recalculates the unit normal vectors associated with vertices, as the normalized sums of the
+        // (area weighted) normals of the adjacent faces; fails if a face refers to a non-existing vertex
+        GLboolean UpdateVertexNormals();
+
+        // recalculates the leftmost and rightmost corners of the bounding box, fails if there are no vertices
+        GLboolean UpdateBoundingBox();
+
         // homework: saves the geometry into an OFF file
         GLboolean SaveToOFF(const std::string& file_name) const;
 
+        // assembles the symmetric positive semi-definite cotangent Laplacian L of the mesh, i.e.,
+        // L(i, j) = -(cot(alpha_ij) + cot(beta_ij)) / 2 for edges (i, j) and L(i, i) = -sum_{j != i} L(i, j),
+        // where alpha_ij and beta_ij denote the angles opposite to the edge; degenerate faces are skipped
+        GLboolean CalculateCotangentLaplacian(SparseMatrix<GLdouble>& laplacian) const;
+
         // mapping vertex buffer objects
         GLfloat* MapVertexBuffer(GLenum access_flag = GL_READ_ONLY) const;
         GLfloat* MapNormalBuffer(GLenum access_flag = GL_READ_ONLY) const;  // homework
@@ -130,7 +172,8 @@ namespace cagd
         GLvoid UnmapTextureBuffer() const;  // homework
 
         // get properties of geometry
-        GLuint VertexCount() const{return _vertex.size();} // homework
+        Precision GetPrecision() const{return _precision;}
+        GLuint VertexCount() const{return _precision == SINGLE_PRECISION ? _single_precision_vertex.GetSize() : _vertex.GetSize();} // homework
         GLuint FaceCount() const{return _face.size();} // homework
         //mine
         GLuint edgeCount() const{return 0;}
@@ -138,4 +181,14 @@ namespace cagd
         // destructor
         virtual ~TriangulatedMesh3();
     };
+
+    inline DCoordinate3 TriangulatedMesh3::_Vertex(GLuint index) const
+    {
+        return _precision == SINGLE_PRECISION ? _single_precision_vertex[index] : _vertex[index];
+    }
+
+    inline DCoordinate3 TriangulatedMesh3::_Normal(GLuint index) const
+    {
+        return _precision == SINGLE_PRECISION ? _single_precision_normal[index] : _normal[index];
+    }
 }
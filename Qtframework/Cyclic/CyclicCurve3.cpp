@@ -1,6 +1,6 @@
 #include "CyclicCurves3.h"
 #include "../Core/Constants.h"
-#include "../Core/RealSquareMatrices.h"
+#include <limits>
 
 using namespace  std;
 namespace   cagd {
@@ -33,7 +33,8 @@ namespace   cagd {
     LinearCombination3 (0.0, TWO_PI, 2*n + 1, data_usage_flag),
     _n(n),
     _c_n(_CalculateNormalizingCoefficient(n)),
-    _lambda_n(TWO_PI / (2 * n +1)){
+    _lambda_n(TWO_PI / (2 * n +1)),
+    _fft(2 * n + 1){
     _CalculateBinomialCoefficient(2*_n, _bc);
   }
 
@@ -46,6 +47,40 @@ namespace   cagd {
     return GL_TRUE;
   }
 
+  GLboolean CyclicCurve3::BlendingFunctionDerivatives(
+      GLuint max_order_of_derivatives, GLdouble u, Matrix<GLdouble> &derivatives) const{
+    GLuint data_count = 2 * _n + 1;
+
+    derivatives.ResizeRows(max_order_of_derivatives + 1);
+    derivatives.ResizeColumns(data_count);
+
+    // cos(x + r pi/2) = cosine_sign[r % 4] trig[r % 2](x), where trig[0] = cos and trig[1] = sin
+    const GLdouble cosine_sign[4] = {1.0, -1.0, -1.0, 1.0};
+
+    for (GLuint i = 0; i < data_count; ++i) {
+      for (GLuint r = 0; r <= max_order_of_derivatives; ++r) {
+        derivatives(r, i) = r ? 0.0 : 1.0 / data_count;
+      }
+
+      GLdouble x = u - i * _lambda_n;
+      GLdouble cos_x = cos(x), sin_x = sin(x);
+      GLdouble trig[2] = {cos_x, sin_x};            // cos(m x), sin(m x)
+
+      for (GLuint m = 1; m <= _n; ++m) {
+        GLdouble a_m_times_m_power_r = 2.0 * _bc(2 * _n, _n - m) / (data_count * _bc(2 * _n, _n));
+        for (GLuint r = 0; r <= max_order_of_derivatives; ++r, a_m_times_m_power_r *= m) {
+          derivatives(r, i) += a_m_times_m_power_r * cosine_sign[r % 4] * trig[r % 2];
+        }
+
+        // rotation by x
+        GLdouble next_cos = trig[0] * cos_x - trig[1] * sin_x;
+        trig[1] = trig[1] * cos_x + trig[0] * sin_x;
+        trig[0] = next_cos;
+      }
+    }
+    return GL_TRUE;
+  }
+
   GLboolean CyclicCurve3::CalculateDerivatives(GLuint max_order_of_derivatives, GLdouble u, Derivatives &d) const{
     d.ResizeRows(max_order_of_derivatives + 1);
     d.LoadNullVectors();
@@ -73,23 +108,143 @@ namespace   cagd {
     return GL_TRUE;
   }
 
-  GLboolean CyclicCurve3::UpdateDataForInterpolation(const ColumnMatrix<GLdouble>& knot_vector, const ColumnMatrix<DCoordinate3>& data_points_to_interpolate){
-    GLuint row_count = knot_vector.GetRowCount();
-    RowMatrix<GLdouble> u_blending_values;
-    RealSquareMatrix collocation_matrix(row_count);
+  GLboolean CyclicCurve3::CalculateDerivativesBatch(
+      GLuint max_order_of_derivatives, const GLdouble *u, GLuint count, Matrix<DCoordinate3> &derivatives) const{
+    if (derivatives.GetRowCount() <= max_order_of_derivatives || derivatives.GetColumnCount() < count) {
+      return GL_FALSE;
+    }
+
+    GLuint data_count = 2 * _n + 1;
 
-    for (GLuint i = 0; i < row_count; ++i)
-    {
-        if (!BlendingFunctionValues(knot_vector(i), u_blending_values))
-            return GL_FALSE;
-        collocation_matrix.SetRow(i, u_blending_values);
+    DCoordinate3 centroid;
+    for (GLuint i = 0; i < data_count; ++i) {
+        centroid += _data[i];
     }
+    centroid /= (GLdouble)data_count;
 
-    if (!collocation_matrix.PerformLUDecomposition())
-        return GL_FALSE;
+    // weighted Fourier coefficients a_m C_m and a_m S_m, where a_m = 2 binom(2n, n - m) / ((2n + 1) binom(2n, n))
+    vector<DCoordinate3> cosine_coefficients(_n + 1), sine_coefficients(_n + 1);
+    for (GLuint m = 1; m <= _n; ++m) {
+      GLdouble a_m = 2.0 * _bc(2 * _n, _n - m) / (data_count * _bc(2 * _n, _n));
+      for (GLuint i = 0; i < data_count; ++i) {
+        GLdouble angle = (GLdouble)((m * i) % data_count) * _lambda_n;
+        cosine_coefficients[m] += (a_m * cos(angle)) * _data[i];
+        sine_coefficients[m]   += (a_m * sin(angle)) * _data[i];
+      }
+    }
+
+    // the r-th derivative of cos(m u) C_m + sin(m u) S_m is m^r (cos(m u + r pi/2) C_m + sin(m u + r pi/2) S_m),
+    // where cos(x + r pi/2) = cosine_sign[r % 4] trig[r % 2](x) and sin(x + r pi/2) = sine_sign[r % 4] trig[1 - r % 2](x),
+    // with trig[0] = cos and trig[1] = sin
+    const GLdouble cosine_sign[4] = {1.0, -1.0, -1.0,  1.0};
+    const GLdouble sine_sign[4]   = {1.0,  1.0, -1.0, -1.0};
+
+    for (GLuint k = 0; k < count; ++k) {
+      for (GLuint r = 0; r <= max_order_of_derivatives; ++r) {
+        derivatives(r, k) = r ? DCoordinate3() : centroid;
+      }
+
+      GLdouble cos_u = cos(u[k]), sin_u = sin(u[k]);
+      GLdouble trig[2] = {cos_u, sin_u};            // cos(m u), sin(m u)
+
+      for (GLuint m = 1; m <= _n; ++m) {
+        GLdouble m_power_r = 1.0;
+        for (GLuint r = 0; r <= max_order_of_derivatives; ++r, m_power_r *= m) {
+          GLdouble cosine_factor = m_power_r * cosine_sign[r % 4] * trig[r % 2];
+          GLdouble sine_factor   = m_power_r * sine_sign[r % 4] * trig[1 - r % 2];
+
+          DCoordinate3 &d = derivatives(r, k);
+          for (GLuint l = 0; l < 3; ++l) {
+            d[l] += cosine_factor * cosine_coefficients[m][l] + sine_factor * sine_coefficients[m][l];
+          }
+        }
+
+        // rotation by u
+        GLdouble next_cos = trig[0] * cos_u - trig[1] * sin_u;
+        trig[1] = trig[1] * cos_u + trig[0] * sin_u;
+        trig[0] = next_cos;
+      }
+    }
+    return GL_TRUE;
+  }
+
+  GLboolean CyclicCurve3::CollocationShapeParameters(std::vector<GLdouble>& shape_parameters) const{
+    shape_parameters.assign(1, (GLdouble)_n);
+    return GL_TRUE;
+  }
 
-    if (!collocation_matrix.SolveLinearSystem(data_points_to_interpolate, _data))
+  GLboolean CyclicCurve3::_IsUniformKnotVector(const ColumnMatrix<GLdouble> &knot_vector) const{
+    GLdouble tolerance = 16.0 * numeric_limits<GLdouble>::epsilon() * (fabs(knot_vector[0]) + TWO_PI);
+
+    for (GLuint r = 1; r < knot_vector.GetRowCount(); ++r) {
+      if (fabs(knot_vector[r] - knot_vector[0] - r * _lambda_n) > tolerance) {
         return GL_FALSE;
+      }
+    }
+    return GL_TRUE;
+  }
+
+  GLboolean CyclicCurve3::UpdateDataForInterpolation(
+      const ColumnMatrix<GLdouble>& knot_vector, const ColumnMatrix<DCoordinate3>& data_points_to_interpolate){
+    GLuint data_count = 2 * _n + 1;
+
+    if (knot_vector.GetRowCount() != data_count || data_points_to_interpolate.GetRowCount() != data_count) {
+      return GL_FALSE;
+    }
+
+    if (!_IsUniformKnotVector(knot_vector)) {
+      return LinearCombination3::UpdateDataForInterpolation(knot_vector, data_points_to_interpolate);
+    }
+
+    typedef FastFourierTransform::Complex Complex;
+
+    // the first column of the circulant matrix consists of the values F_0(u_r), where
+    // F_0(u) = c_n (1 + cos u)^n = 1 / (2n + 1) sum_{k=-n}^{n} binom(2n, n - |k|) / binom(2n, n) exp(iku),
+    // therefore its eigenvalues (i.e., the discrete Fourier coefficients of the column) are known in closed form:
+    // the m-th one equals binom(2n, n - |k|) / binom(2n, n) exp(iku_0), where k = m if m <= n and k = m - (2n + 1)
+    // otherwise
+    //
+    // The eigenvalues decay like 4^{-|k|}, for n >= 25 the smallest ones fall below (2n + 1) eps, i.e., the
+    // highest frequencies of the solution are not determined in double precision. Such systems are handed over to the LU decomposition of LinearCombination3
+    // instead of truncating these modes, since the truncated solution would not interpolate the data points.
+    vector<Complex> eigenvalues(data_count);
+    GLdouble tolerance = data_count * numeric_limits<GLdouble>::epsilon();
+    GLdouble ratio = 1.0;
+    for (GLuint k = 0; k <= _n; ++k) {
+      if (ratio < tolerance) {
+        return LinearCombination3::UpdateDataForInterpolation(knot_vector, data_points_to_interpolate);
+      }
+      eigenvalues[k] = polar(ratio, k * knot_vector[0]);
+      if (k) {
+        eigenvalues[data_count - k] = conj(eigenvalues[k]);
+      }
+      ratio *= (GLdouble)(_n - k) / (GLdouble)(_n + k + 1);
+    }
+
+    // the matrix is real, so the x and y coordinates can be solved together as the real and imaginary parts
+    // of one complex right-hand side
+    vector<Complex> xy(data_count), z(data_count);
+    for (GLuint r = 0; r < data_count; ++r) {
+      DCoordinate3 p = data_points_to_interpolate[r];
+      xy[r] = Complex(p.x(), p.y());
+      z[r]  = Complex(p.z(), 0.0);
+    }
+
+    _fft.Transform(xy);
+    _fft.Transform(z);
+
+    for (GLuint k = 0; k < data_count; ++k) {
+      xy[k] /= eigenvalues[k];
+      z[k]  /= eigenvalues[k];
+    }
+
+    _fft.Transform(xy, GL_TRUE);
+    _fft.Transform(z, GL_TRUE);
+
+    for (GLuint i = 0; i < data_count; ++i) {
+      _data[i] = DCoordinate3(xy[i].real(), xy[i].imag(), z[i].real());
+    }
+
     return GL_TRUE;
   }
 }
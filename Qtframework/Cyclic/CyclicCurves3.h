@@ -2,6 +2,7 @@
 #define CYCLICCURVES3_H
 #include "../Core/LinearCombination3.h"
 #include "../Core/Matrices.h"
+#include "../Core/FastFourierTransforms.h"
 
 namespace cagd {
   class CyclicCurve3 : public LinearCombination3{
@@ -12,18 +13,42 @@ namespace cagd {
 
       TriangularMatrix<GLdouble> _bc;
 
+      // discrete Fourier transform of length 2n + 1
+      FastFourierTransform _fft;
+
       GLdouble _CalculateNormalizingCoefficient(GLuint n);
 
       GLvoid   _CalculateBinomialCoefficient(GLuint m, TriangularMatrix<GLdouble> &bc);
 
+      // checks whether u_r = u_0 + r * lambda_n holds up to rounding errors for all knots
+      GLboolean _IsUniformKnotVector(const ColumnMatrix<GLdouble> &knot_vector) const;
+
   public:
 
       CyclicCurve3(GLuint n, GLenum data_usage_flag = GL_STATIC_DRAW);
 
       GLboolean BlendingFunctionValues(GLdouble u, RowMatrix<GLdouble> &values) const;
+      // F_i^(r)(u) = delta_{r,0} / (2n + 1) + sum_{m=1}^{n} a_m m^r cos(m (u - i lambda_n) + r pi/2), where
+      // a_m = 2 binom(2n, n - m) / ((2n + 1) binom(2n, n))
+      GLboolean BlendingFunctionDerivatives(
+          GLuint max_order_of_derivatives, GLdouble u, Matrix<GLdouble> &derivatives) const;
       GLboolean CalculateDerivatives(
           GLuint max_order_of_derivatives, GLdouble u, Derivatives &d)const;
-      GLboolean UpdateDataForInterpolation(const ColumnMatrix<GLdouble>& knot_vector, const ColumnMatrix<DCoordinate3>& data_points_to_interpolate);
+      // since sum_i p_i cos(m (u - i lambda_n)) = cos(m u) C_m + sin(m u) S_m, where C_m = sum_i p_i cos(m i lambda_n)
+      // and S_m = sum_i p_i sin(m i lambda_n), the Fourier coefficients C_m, S_m (m = 1,...,n) are calculated
+      // once per batch, while cos(m u) and sin(m u) are obtained by rotations from cos(u) and sin(u); i.e.,
+      // a sample costs O(n) operations instead of the O(n^2) cosine evaluations of CalculateDerivatives
+      GLboolean CalculateDerivativesBatch(
+          GLuint max_order_of_derivatives, const GLdouble *u, GLuint count, Matrix<DCoordinate3> &derivatives) const;
+      // the collocation matrix depends only on the order n and on the knot vector
+      GLboolean CollocationShapeParameters(std::vector<GLdouble>& shape_parameters) const;
+
+      // since F_i(u) = F_0(u - i * lambda_n), the collocation matrix of uniform knots u_r = u_0 + r * lambda_n is
+      // circulant; it is diagonalized by the discrete Fourier transform and the system is solved in O(n log n)
+      // operations, other knot vectors and orders whose eigenvalues are not resolved in double precision (n >= 25)
+      // are handled by the LU decomposition of LinearCombination3
+      GLboolean UpdateDataForInterpolation(
+          const ColumnMatrix<GLdouble>& knot_vector, const ColumnMatrix<DCoordinate3>& data_points_to_interpolate);
   };
 }
 #endif // CYCLICCURVES3_H
@@ -222,7 +222,12 @@ namespace cagd
                 derivatives(1,1)=surface1::d01;
 
                 ParametricSurface3 surface(derivatives,surface1::u_min,surface1::u_max,surface1::v_min,surface1::v_max);
-                _surface = *(surface.GenerateImage(200,200,true));
+                TriangulatedMesh3 *surface_image = surface.GenerateImage(200,200,true);
+                if (surface_image){
+                    // take over the generated geometry instead of copying it
+                    _surface = std::move(*surface_image);
+                    delete surface_image;
+                }
                               if(_surface.UpdateVertexBufferObjects((GL_DYNAMIC_DRAW))){
     //                              _angle=0.0;
     //                              _timer->start();
@@ -314,7 +319,7 @@ namespace cagd
               }
 
               tensorSurface3DataGrid->UpdateVertexBufferObjectsOfData();
-              hyperbolicPatch3Image = tensorSurface3DataGrid->GenerateImage(200,200);
+              hyperbolicPatch3Image = tensorSurface3DataGrid->GenerateImage(200,200,GL_STATIC_DRAW,TriangulatedMesh3::SINGLE_PRECISION);
               hyperbolicPatch3Image->UpdateVertexBufferObjects();
                 //Interpolation example
               RowMatrix<GLdouble> u_knot_vector(4);
@@ -335,7 +340,7 @@ namespace cagd
                     }
               }
               if(tensorSurface3DataGrid->UpdateDataForInterpolation(u_knot_vector,v_knot_vector,data_points_to_interpolate)){
-                  hyperbolicPatch3InterpolationImage = tensorSurface3DataGrid->GenerateImage(200,200);
+                  hyperbolicPatch3InterpolationImage = tensorSurface3DataGrid->GenerateImage(200,200,GL_STATIC_DRAW,TriangulatedMesh3::SINGLE_PRECISION);
                   if(hyperbolicPatch3InterpolationImage){
                      hyperbolicPatch3InterpolationImage->UpdateVertexBufferObjects();
                   }
@@ -788,7 +793,12 @@ namespace cagd
     }
     void GLWidget::change_surface(int index){
         currentHomework = ParametricSurface;
-        _surface=*(surfaces[index]);
+        // exchange meshes with the cache instead of copying them: first return the currently shown
+        // mesh to its slot, then take over the selected one
+        if (_shown_surface_index >= 0)
+            swap(_surface, *(surfaces[_shown_surface_index]));
+        swap(_surface, *(surfaces[index]));
+        _shown_surface_index = index;
         _surface.UpdateVertexBufferObjects((GL_DYNAMIC_DRAW));
          updateGL();
     }
@@ -48,6 +48,7 @@ namespace cagd
       RowMatrix<TriangulatedMesh3*> surfaces;
       TriangulatedMesh3 _mouse;
       TriangulatedMesh3 _surface;
+      int _shown_surface_index = -1;    // slot of surfaces whose mesh is currently moved into _surface
       //mine
       //ParametricCurves
       RowMatrix<GenericCurve3*> curves;
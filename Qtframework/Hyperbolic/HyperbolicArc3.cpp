@@ -20,14 +20,22 @@ GLboolean HyperbolicArc3::BlendingFunctionValues(GLdouble u, RowMatrix<GLdouble>
   if(u< _u_min || u> _u_max ){
       return GL_FALSE;
   }
+  FixedMatrix<GLdouble, 1, 4> fvals;
+  blendingFunctionValues(u,fvals);
   values.ResizeColumns(4);
+  for (GLuint i=0;i<4;i++) {
+    values[i] = fvals[i];
+  }
+  return GL_TRUE;
+}
+
+void HyperbolicArc3::blendingFunctionValues(GLdouble u, FixedMatrix<GLdouble, 1, 4>& values)const{
   values[3] = pow(sinh(u/2.0),4)/constants[1];
   values[0] = pow(sinh((_alpha - u)/2.0),4)/constants[1];
   values[2] = (constants[0]/constants[1])*sinh((_alpha - u)/2.0)*pow(sinh(u/2.0),3)
               + (constants[2]/constants[1])*pow(sinh((_alpha-u)/2.0),2)*pow(sinh(u/2.0),2);
   values[1] = (constants[0]/constants[1])*sinh((u)/2.0)*pow(sinh((_alpha-u)/2.0),3)
       + (constants[2]/constants[1])*pow(sinh((u)/2.0),2)*pow(sinh((_alpha-u)/2.0),2);
-  return GL_TRUE;
 }
 GLdouble HyperbolicArc3::F3firstDerivative(GLdouble t)const{
   return (2.0/constants[1])*pow(sinh(t/2.0),3)*cosh(t/2.0);
@@ -77,15 +85,17 @@ GLboolean HyperbolicArc3::CalculateDerivatives(GLuint max_order_of_derivatives,
    }
   d.ResizeRows(max_order_of_derivatives+1);
   d.LoadNullVectors();
-  RowMatrix<GLdouble> fvals;
-  BlendingFunctionValues(u,fvals);
+  FixedMatrix<GLdouble, 1, 4> fvals;
+  blendingFunctionValues(u,fvals);
   for (int i=0;i<4;i++) {//calculate curve points, 0-th order derivatives
     d[0]+=_data[i]*fvals[i];
   }
-  d[1]+=_data[0]*F0firstDerivative(u);
-  d[1]+=_data[1]*F1firstDerivative(u);
-  d[1]+=_data[2]*F2firstDerivative(u);
-  d[1]+=_data[3]*F3firstDerivative(u);
+  if(max_order_of_derivatives>=1){
+    d[1]+=_data[0]*F0firstDerivative(u);
+    d[1]+=_data[1]*F1firstDerivative(u);
+    d[1]+=_data[2]*F2firstDerivative(u);
+    d[1]+=_data[3]*F3firstDerivative(u);
+  }
 
   if(max_order_of_derivatives>=2){
     d[2]+=_data[0]*F0secondDerivative(u);
@@ -95,6 +105,78 @@ GLboolean HyperbolicArc3::CalculateDerivatives(GLuint max_order_of_derivatives,
   }
   return GL_TRUE;
 }
+void HyperbolicArc3::blendingFunctionDerivatives(GLuint max_order_of_derivatives, GLdouble u, GLdouble half_exp_alpha,
+                                                 FixedMatrix<GLdouble, 3, 4>& F)const{
+  // F3 = s^4/K, F0 = S^4/K, F2 = A S s^3 + B S^2 s^2, F1 = A s S^3 + B s^2 S^2, where s, c denote sinh, cosh of
+  // u/2, S, C denote sinh, cosh of (alpha-u)/2, K = sinh^4(alpha/2), A = 4 cosh(alpha/2)/K, B = (1+2cosh^2(alpha/2))/K
+  GLdouble K = constants[1], A = constants[0]/K, B = constants[2]/K;
+  GLdouble e_u = exp(0.5*u), e_v = half_exp_alpha/e_u;
+  GLdouble s = 0.5*(e_u - 1.0/e_u), c = 0.5*(e_u + 1.0/e_u);
+  GLdouble S = 0.5*(e_v - 1.0/e_v), C = 0.5*(e_v + 1.0/e_v);
+  GLdouble s2 = s*s, S2 = S*S, c2 = c*c, C2 = C*C;
+
+  F(0,3) = s2*s2/K;
+  F(0,0) = S2*S2/K;
+  F(0,2) = A*S*s2*s + B*S2*s2;
+  F(0,1) = A*s*S2*S + B*s2*S2;
+  if(max_order_of_derivatives>=1){
+    F(1,3) = 2.0*s2*s*c/K;
+    F(1,0) = -2.0*S2*S*C/K;
+    F(1,2) = A*(-0.5*C*s2*s + 1.5*S*s2*c) + B*(-S*C*s2 + S2*s*c);
+    F(1,1) = A*(0.5*c*S2*S - 1.5*s*S2*C) + B*(s*c*S2 - s2*S*C);
+  }
+  if(max_order_of_derivatives>=2){
+    F(2,3) = (s2*s2 + 3.0*s2*c2)/K;
+    F(2,0) = (S2*S2 + 3.0*S2*C2)/K;
+    F(2,2) = A*(S*s2*s - 1.5*C*s2*c + 1.5*S*s*c2) + B*(0.5*C2*s2 + S2*s2 - 2.0*S*C*s*c + 0.5*S2*c2);
+    F(2,1) = A*(s*S2*S - 1.5*c*S2*C + 1.5*s*S*C2) + B*(0.5*c2*S2 + s2*S2 - 2.0*s*c*S*C + 0.5*s2*C2);
+  }
+}
+
+GLboolean HyperbolicArc3::BlendingFunctionDerivatives(GLuint max_order_of_derivatives, GLdouble u, Matrix<GLdouble>& derivatives)const{
+  if(u< _u_min || u> _u_max || max_order_of_derivatives >2){
+    return GL_FALSE;
+  }
+  FixedMatrix<GLdouble, 3, 4> F;
+  blendingFunctionDerivatives(max_order_of_derivatives, u, exp(0.5*_alpha), F);
+  derivatives.ResizeRows(max_order_of_derivatives+1);
+  derivatives.ResizeColumns(4);
+  for (GLuint r=0;r<=max_order_of_derivatives;r++) {
+    for (GLuint i=0;i<4;i++) {
+      derivatives(r,i) = F(r,i);
+    }
+  }
+  return GL_TRUE;
+}
+
+GLboolean HyperbolicArc3::CalculateDerivativesBatch(GLuint max_order_of_derivatives, const GLdouble *u, GLuint count,
+                                                    Matrix<DCoordinate3>& derivatives)const{
+  if(max_order_of_derivatives >2 || derivatives.GetRowCount() <= max_order_of_derivatives || derivatives.GetColumnCount() < count){
+    return GL_FALSE;
+  }
+  for (GLuint k=0;k<count;k++) {
+    if(u[k]< _u_min || u[k]> _u_max){
+      return GL_FALSE;
+    }
+  }
+  GLdouble half_exp_alpha = exp(0.5*_alpha);
+  FixedMatrix<GLdouble, 3, 4> F;
+  for (GLuint k=0;k<count;k++) {
+    blendingFunctionDerivatives(max_order_of_derivatives, u[k], half_exp_alpha, F);
+    for (GLuint r=0;r<=max_order_of_derivatives;r++) {
+      DCoordinate3 &d = derivatives(r,k);
+      for (GLuint l=0;l<3;l++) {
+        d[l] = F(r,0)*_data[0][l] + F(r,1)*_data[1][l] + F(r,2)*_data[2][l] + F(r,3)*_data[3][l];
+      }
+    }
+  }
+  return GL_TRUE;
+}
+GLboolean HyperbolicArc3::CollocationShapeParameters(std::vector<GLdouble>& shape_parameters)const{
+  shape_parameters.assign(1,_alpha);
+  return GL_TRUE;
+}
+
 void HyperbolicArc3::setAlpha(GLdouble alpha){
   _alpha=alpha;
   _u_max=_alpha;
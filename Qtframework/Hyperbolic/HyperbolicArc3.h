@@ -2,6 +2,7 @@
 #define HYPERBOLICARC3_H
 #include "../Core/LinearCombination3.h"
 #include "../Core/Matrices.h"
+#include "../Core/FixedMatrices.h"
 
 using namespace cagd;
 using namespace  std;
@@ -10,8 +11,13 @@ private:
     GLdouble _alpha;
     GLdouble sinh(GLdouble x)const;
     GLdouble cosh(GLdouble x)const;
-    RowMatrix<GLdouble> constants;
+    FixedMatrix<GLdouble, 1, 3> constants;
     void updateConstants();
+    // the four blending function values without range check, stored inline
+    void blendingFunctionValues(GLdouble u, FixedMatrix<GLdouble, 1, 4>& values)const;
+    // rows 0,...,max_order_of_derivatives of the blending function derivatives at u, where half_exp_alpha = e^(alpha/2)
+    void blendingFunctionDerivatives(GLuint max_order_of_derivatives, GLdouble u, GLdouble half_exp_alpha,
+                                     FixedMatrix<GLdouble, 3, 4>& F)const;
     GLdouble F3firstDerivative(GLdouble t)const;
     GLdouble F2firstDerivative(GLdouble t)const;
     GLdouble F1firstDerivative(GLdouble t)const;
@@ -22,13 +28,22 @@ private:
     GLdouble F1secondDerivative(GLdouble t)const;
     GLdouble F0secondDerivative(GLdouble t)const;
 public :
-    HyperbolicArc3(GLdouble alpha):LinearCombination3(0,alpha,4),_alpha(alpha),constants(3){
+    HyperbolicArc3(GLdouble alpha):LinearCombination3(0,alpha,4),_alpha(alpha){
       updateConstants();
     }
-    HyperbolicArc3(const HyperbolicArc3& other):LinearCombination3(other),_alpha(other._alpha),constants(3){
+    HyperbolicArc3(const HyperbolicArc3& other):LinearCombination3(other),_alpha(other._alpha),constants(other.constants){
+    }
+    HyperbolicArc3(HyperbolicArc3&& other) noexcept:LinearCombination3(std::move(other)),_alpha(other._alpha),constants(other.constants){
     }
     virtual GLboolean BlendingFunctionValues(GLdouble u, RowMatrix<GLdouble>& values)const;
+    virtual GLboolean BlendingFunctionDerivatives(GLuint max_order_of_derivatives, GLdouble u, Matrix<GLdouble>& derivatives)const;
     virtual GLboolean CalculateDerivatives(GLuint max_order_of_derivatives, GLdouble u, Derivatives& d)const;
+    // all blending functions and their derivatives are polynomials of sinh and cosh of u/2 and (alpha-u)/2,
+    // which are obtained from a single exponential per sample
+    virtual GLboolean CalculateDerivativesBatch(GLuint max_order_of_derivatives, const GLdouble *u, GLuint count,
+                                                Matrix<DCoordinate3>& derivatives)const;
+    // the collocation matrix depends only on alpha and on the knot vector
+    virtual GLboolean CollocationShapeParameters(std::vector<GLdouble>& shape_parameters)const;
     void setAlpha(GLdouble);
     GLdouble getAlpha(){return _alpha;}
 };
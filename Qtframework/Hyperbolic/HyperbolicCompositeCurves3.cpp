@@ -1,5 +1,6 @@
 #include "HyperbolicCompositeCurves3.h"
 #include "../Core/Materials.h"
+#include <algorithm>
 using namespace std;
 namespace cagd{
 
@@ -14,6 +15,8 @@ namespace cagd{
     img = new GenericCurve3(*other.img);
     next = other.next;
     previous = other.previous;
+    img_order = other.img_order;
+    img_scale = other.img_scale;
   }
  HyperbolicCompositeCurve3::~HyperbolicCompositeCurve3(){
     for(int i=0;i<_arc_count;++i){
@@ -33,25 +36,55 @@ namespace cagd{
     img = new GenericCurve3(*other.img);
     next = other.next;
     previous = other.previous;
+    img_order = other.img_order;
+    img_scale = other.img_scale;
     return *this;
   }
 
-  GLboolean HyperbolicCompositeCurve3::insert(GLdouble alpha,GLuint max_order_of_derivatives,const ColumnMatrix<DCoordinate3>& _data,GLdouble scale,Color4 color){
-    if(_arc_count == _arcs.size()) return GL_FALSE;
+  HyperbolicCompositeCurve3::ArcAttributes* HyperbolicCompositeCurve3::appendArc(GLdouble alpha,const ColumnMatrix<DCoordinate3>& _data,Color4 color){
+    if(_arc_count == _arcs.size()) return 0;
     ArcAttributes* arcattr = new ArcAttributes();
     arcattr->arc = new HyperbolicArc3(alpha);
     for(int i=0;i<4;i++){
       (*(arcattr->arc))[i] =_data[i];
-    }        
-    if(!arcattr->arc->UpdateVertexBufferObjectsOfData())return GL_FALSE;    
-    if(!arcattr->generateImage(max_order_of_derivatives))return GL_FALSE;    
-    if(!arcattr->updateVBO(scale))return GL_FALSE;
-    cout<<"1"<<endl;
+    }
     arcattr->color=new Color4(color);
     arcattr->derivatives_color=new Color4(0.0,0.5,0.0);
-     _arcs[_arc_count]=arcattr;     
-     _arc_count++;     
-     return GL_TRUE;
+    if(!arcattr->arc->UpdateVertexBufferObjectsOfData()){
+      delete arcattr;
+      return 0;
+    }
+    _arcs[_arc_count]=arcattr;
+    _arc_count++;
+    return arcattr;
+  }
+
+  GLboolean HyperbolicCompositeCurve3::insert(GLdouble alpha,GLuint max_order_of_derivatives,const ColumnMatrix<DCoordinate3>& _data,GLdouble scale,Color4 color){
+    ArcAttributes* arcattr = appendArc(alpha,_data,color);
+    if(!arcattr)return GL_FALSE;
+    if(!arcattr->generateImage(max_order_of_derivatives))return GL_FALSE;
+    if(!arcattr->updateVBO(scale))return GL_FALSE;
+    return GL_TRUE;
+  }
+
+  GLboolean HyperbolicCompositeCurve3::generateImages(GLuint first,GLuint last,GLuint max_order_of_derivatives,GLdouble scale){
+    if(first > last || last >= _arc_count)return GL_FALSE;
+    vector<const LinearCombination3*> curves;
+    for(GLuint i=first;i<=last;++i){
+      curves.push_back(_arcs[i]->arc);
+    }
+    // the images are evaluated in parallel, while the vertex buffer objects have to be updated by the thread
+    // that owns the rendering context
+    vector<GenericCurve3*> images;
+    GLboolean result = LinearCombination3::GenerateImages(curves,max_order_of_derivatives,div_point_count,images);
+    for(GLuint i=first;i<=last;++i){
+      ArcAttributes* arcattr = _arcs[i];
+      if(arcattr->img)delete arcattr->img;
+      arcattr->img = images[i-first];
+      arcattr->img_order = max_order_of_derivatives;
+      if(arcattr->img && !arcattr->updateVBO(scale))result = GL_FALSE;
+    }
+    return result;
   }
 
   GLboolean HyperbolicCompositeCurve3::continueExisting(GLuint id,Direction direction,GLdouble alpha, GLuint max_order_derivative,GLdouble scale ){
@@ -127,71 +160,229 @@ namespace cagd{
   GLboolean HyperbolicCompositeCurve3::updateArcForRendering( ArcAttributes* attr){
     attr->arc->DeleteVertexBufferObjectsOfData();
     if(!attr->arc->UpdateVertexBufferObjectsOfData())return GL_FALSE;
-    if(!attr->generateImage(2))return GL_FALSE;
+    if(!attr->generateImage(derivative_order))return GL_FALSE;
     if(!attr->updateVBO(derivative_scale))return GL_FALSE;
     return GL_TRUE;
   }
 
+  GLboolean HyperbolicCompositeCurve3::calculateInterpolatingControlPoints(const vector<DCoordinate3>& points,GLdouble alpha,ColumnMatrix<DCoordinate3>& control_points){
+    if(points.size() < 2 || alpha <= 0.0)return GL_FALSE;
+    GLuint n = (GLuint)points.size();
+
+    //--------------------------------------------------------------------------------------------------
+    // With s = sinh(alpha/2) and c = cosh(alpha/2), an arc d_0, ..., d_3 has the end derivatives
+    //   c'(0)     = k (d_1 - d_0),                   c'(alpha)  = k (d_3 - d_2),                 k = 2c/s,
+    //   c''(0)    = A d_0 + B d_1 + C d_2,           c''(alpha) = C d_1 + B d_2 + A d_3,
+    // where A = 1 + 3c^2/s^2, C = (1 + 2c^2)/(2s^2) and B = -(A + C). Setting d_1 = p_i + t_i/k and
+    // d_2 = p_{i+1} - t_{i+1}/k for the tangents t_i at the points p_i, the equality of the second
+    // derivatives at the inner points reads
+    //   t_{i-1} + beta t_i + t_{i+1} = k (p_{i+1} - p_{i-1}),                   beta = -2B/C = 2 + 2A/C,
+    // while vanishing second derivatives at the ends give (beta/2) t_0 + t_1 = k (p_1 - p_0) and
+    // t_{n-2} + (beta/2) t_{n-1} = k (p_{n-1} - p_{n-2}). The system is strictly diagonally dominant.
+    //--------------------------------------------------------------------------------------------------
+    GLdouble s = std::sinh(alpha/2.0), c = std::cosh(alpha/2.0);
+    GLdouble k = 2.0*c/s;
+    GLdouble A = 1.0 + 3.0*c*c/(s*s);
+    GLdouble C = (1.0 + 2.0*c*c)/(2.0*s*s);
+    GLdouble beta = 2.0 + 2.0*A/C;
+
+    RealBandedMatrix system(n,1,1);
+    ColumnMatrix<DCoordinate3> rhs(n);
+    for(GLuint i=0;i<n;++i){
+      GLuint previous = (i > 0) ? i-1 : i;
+      GLuint next = (i < n-1) ? i+1 : i;
+      GLboolean end = (i == 0 || i == n-1);
+      system(i,i) = end ? beta/2.0 : beta;
+      if(i > 0)system(i,i-1) = 1.0;
+      if(i < n-1)system(i,i+1) = 1.0;
+      rhs[i] = (points[next] - points[previous])*k;
+    }
+
+    ColumnMatrix<DCoordinate3> tangents;
+    if(!system.SolveLinearSystem(rhs,tangents))return GL_FALSE;
+
+    control_points.ResizeRows(3*(n-1)+1);
+    for(GLuint i=0;i<n-1;++i){
+      control_points[3*i] = points[i];
+      control_points[3*i+1] = points[i] + tangents[i]/k;
+      control_points[3*i+2] = points[i+1] - tangents[i+1]/k;
+    }
+    control_points[3*(n-1)] = points[n-1];
+    return GL_TRUE;
+  }
+
+  GLboolean HyperbolicCompositeCurve3::interpolate(const vector<DCoordinate3>& points,GLdouble alpha,GLuint max_order_of_derivatives,GLdouble scale,Color4 color){
+    if(points.size() < 2 || _arc_count + points.size() - 1 > _arcs.size())return GL_FALSE;
+    ColumnMatrix<DCoordinate3> control_points;
+    if(!calculateInterpolatingControlPoints(points,alpha,control_points))return GL_FALSE;
+
+    GLuint first = _arc_count;
+    for(GLuint i=0;i+1<points.size();++i){
+      ColumnMatrix<DCoordinate3> arc_points(4);
+      for(GLuint j=0;j<4;++j){
+        arc_points[j] = control_points[3*i+j];
+      }
+      ArcAttributes* arcattr = appendArc(alpha,arc_points,color);
+      if(!arcattr){
+        removeArcsFrom(first);
+        return GL_FALSE;
+      }
+      if(_arc_count-1 > first){
+        _arcs[_arc_count-2]->next = arcattr;
+        arcattr->previous = _arcs[_arc_count-2];
+      }
+    }
+    if(!generateImages(first,_arc_count-1,max_order_of_derivatives,scale)){
+      removeArcsFrom(first);
+      return GL_FALSE;
+    }
+    return GL_TRUE;
+  }
+
+  void HyperbolicCompositeCurve3::removeArcsFrom(GLuint first){
+    while(_arc_count > first){
+      --_arc_count;
+      delete _arcs[_arc_count];
+      _arcs[_arc_count] = 0;
+    }
+  }
+
+  GLboolean HyperbolicCompositeCurve3::displaceArcPoints(ArcAttributes* attr,GLuint count,const int* pointindices,const DCoordinate3* deltas){
+    for(GLuint i=0;i<count;++i){
+      (*(attr->arc))[pointindices[i]]+=deltas[i];
+    }
+    if(!attr->img || attr->img_order != derivative_order || attr->img_scale != derivative_scale)return updateArcForRendering(attr);
+
+    GLuint first = attr->img->GetPointCount(), last = 0;
+    for(GLuint i=0;i<count;++i){
+      GLuint f,l;
+      if(!attr->arc->UpdateImageForDataChange(pointindices[i],deltas[i],*(attr->img),f,l))return updateArcForRendering(attr);
+      if(f <= l){
+        first = min(first,f);
+        last = max(last,l);
+      }
+      if(!attr->arc->UpdateVertexBufferObjectsOfDataPoint(pointindices[i]))return updateArcForRendering(attr);
+    }
+    if(first > last)return GL_TRUE;
+    if(!attr->img->UpdateVertexBufferObjectsOfRange(first,last,attr->img_scale))return updateArcForRendering(attr);
+    return GL_TRUE;
+  }
+
+  // the end (0 or 3) of the arc neighbour, that is joined to the end fromend of the arc from
+  static int joinedEnd(HyperbolicCompositeCurve3::ArcAttributes* neighbour,HyperbolicCompositeCurve3::ArcAttributes* from,int fromend){
+    GLboolean vianext = (neighbour->next == from), viaprevious = (neighbour->previous == from);
+    if(vianext && viaprevious){
+      // two arcs that form a closed chain, the joined ends share their points
+      DCoordinate3 point = (*(from->arc))[fromend];
+      return ((*(neighbour->arc))[3] == point) ? 3 : 0;
+    }
+    return vianext ? 3 : 0;
+  }
+
+  GLboolean HyperbolicCompositeCurve3::buildChainArcLength(int arcindex,ChainArcLength& chain,GLuint segment_count){
+    chain = ChainArcLength();
+    if(arcindex < 0 || arcindex >= (int)_arc_count)return GL_FALSE;
+
+    // walks backwards through the end 0 of the given arc until a free end is found, a closed chain starts at the
+    // given arc itself
+    ArcAttributes* start = _arcs[arcindex];
+    int startend = 0;
+    ArcAttributes* current = start;
+    int exitend = 0;
+    for(GLuint visited=0;visited<_arc_count;++visited){
+      ArcAttributes* neighbour = (exitend == 0) ? current->previous : current->next;
+      if(!neighbour){
+        start = current;
+        startend = exitend;
+        break;
+      }
+      if(neighbour == _arcs[arcindex])break;
+      exitend = 3 - joinedEnd(neighbour,current,exitend);
+      current = neighbour;
+    }
+
+    // traverses the chain forwards, each arc is entered through the end entryend
+    current = start;
+    int entryend = startend;
+    GLdouble length = 0.0;
+    for(GLuint visited=0;visited<_arc_count;++visited){
+      ArcLengthTable table;
+      if(!current->arc->BuildArcLengthTable(table,segment_count)){
+        chain = ChainArcLength();
+        return GL_FALSE;
+      }
+      chain.arcs.push_back(current);
+      chain.reversed.push_back(entryend == 3);
+      chain.offsets.push_back(length);
+      chain.tables.push_back(table);
+      length += table.GetLength();
+
+      exitend = 3 - entryend;
+      ArcAttributes* neighbour = (exitend == 0) ? current->previous : current->next;
+      if(!neighbour || neighbour == start)break;
+      entryend = joinedEnd(neighbour,current,exitend);
+      current = neighbour;
+    }
+    chain.offsets.push_back(length);
+    return GL_TRUE;
+  }
+
+  GLboolean HyperbolicCompositeCurve3::ChainArcLength::derivativesAt(GLdouble s,GLuint max_order_of_derivatives,LinearCombination3::Derivatives& d,GLuint newton_iterations) const{
+    if(arcs.empty())return GL_FALSE;
+    s = min(max(s,0.0),getLength());
+
+    // offsets[i] <= s < offsets[i+1], the last arc also contains the end of the chain
+    GLuint i = (GLuint)(upper_bound(offsets.begin(),offsets.end()-1,s) - offsets.begin());
+    i = min(max(i,1u),(GLuint)arcs.size()) - 1;
+
+    GLdouble local = s - offsets[i];
+    if(reversed[i])local = tables[i].GetLength() - local;
+    if(!arcs[i]->arc->CalculateDerivativesAtArcLength(tables[i],max_order_of_derivatives,local,d,newton_iterations))return GL_FALSE;
+
+    // the odd order derivatives change their signs along reversed arcs
+    if(reversed[i]){
+      for(GLuint r=1;r<=max_order_of_derivatives;r+=2){
+        d[r] = -d[r];
+      }
+    }
+    return GL_TRUE;
+  }
+
   GLboolean HyperbolicCompositeCurve3::updatePosition(int arcindex,int pointindex,DCoordinate3 newcoord){
     if(arcindex < 0 || arcindex>=_arc_count)return GL_FALSE;
     if(pointindex < 0 || pointindex>3)return GL_FALSE;
-    DCoordinate3 diff = newcoord - (*(_arcs[arcindex]->arc))[pointindex];
+    ArcAttributes* attr = _arcs[arcindex];
+    DCoordinate3 diff = newcoord - (*(attr->arc))[pointindex];
+    // the end points are dragged together with their inner neighbours, in order to keep the tangents of the
+    // joints, while moving an inner point mirrors the inner point of the neighbouring arc at the joint
     switch (pointindex) {
-      case 0:{
-          if(_arcs[arcindex]->previous){
-            if((*((_arcs[arcindex]->previous)->arc))[3]==(*((_arcs[arcindex])->arc))[0]){
-              (*((_arcs[arcindex]->previous)->arc))[3]=newcoord;
-              (*((_arcs[arcindex]->previous)->arc))[2]+=diff;
-            }else{
-               (*((_arcs[arcindex]->previous)->arc))[0]=newcoord;
-               (*((_arcs[arcindex]->previous)->arc))[1]+=diff;
-            }
-            (*((_arcs[arcindex])->arc))[1]+=diff;
-            if(!updateArcForRendering(_arcs[arcindex]->previous))return GL_FALSE;
-          }
-          (*((_arcs[arcindex])->arc))[0]=newcoord;
-          if(!updateArcForRendering(_arcs[arcindex]))return GL_FALSE;
-        }  break;
+      case 0:
       case 3:{
-          if(_arcs[arcindex]->next){
-            if((*((_arcs[arcindex]->next)->arc))[3]==(*((_arcs[arcindex])->arc))[3]){
-              (*((_arcs[arcindex]->next)->arc))[3]=newcoord;
-              (*((_arcs[arcindex]->next)->arc))[2]+=diff;
-            }else{
-               (*((_arcs[arcindex]->next)->arc))[0]=newcoord;
-               (*((_arcs[arcindex]->next)->arc))[1]+=diff;
-            }
-            (*((_arcs[arcindex])->arc))[2]+=diff;
-            if(!updateArcForRendering(_arcs[arcindex]->next))return GL_FALSE;
+          ArcAttributes* neighbour = (pointindex == 0) ? attr->previous : attr->next;
+          int inner = (pointindex == 0) ? 1 : 2;
+          if(neighbour){
+            int end = ((*(neighbour->arc))[3]==(*(attr->arc))[pointindex]) ? 3 : 0;
+            int indices[2] = {end, (end == 3) ? 2 : 1};
+            DCoordinate3 deltas[2] = {newcoord - (*(neighbour->arc))[end], diff};
+            if(!displaceArcPoints(neighbour,2,indices,deltas))return GL_FALSE;
+            int ownindices[2] = {pointindex, inner};
+            DCoordinate3 owndeltas[2] = {diff, diff};
+            if(!displaceArcPoints(attr,2,ownindices,owndeltas))return GL_FALSE;
+          }else{
+            if(!displaceArcPoints(attr,1,&pointindex,&diff))return GL_FALSE;
           }
-          (*((_arcs[arcindex])->arc))[3]=newcoord;
-          if(!updateArcForRendering(_arcs[arcindex]))return GL_FALSE;
         }  break;
+      case 1:
       case 2:{
-          if(_arcs[arcindex]->next){
-            if((*((_arcs[arcindex]->next)->arc))[3]==(*((_arcs[arcindex])->arc))[3]){
-              (*((_arcs[arcindex]->next)->arc))[2]-=diff;
-            }else{
-               (*((_arcs[arcindex]->next)->arc))[1]-=diff;
-            }
-            if(!updateArcForRendering(_arcs[arcindex]->next))return GL_FALSE;
-          }
-          (*((_arcs[arcindex])->arc))[2]=newcoord;
-          if(!updateArcForRendering(_arcs[arcindex]))return GL_FALSE;
-        }  break;
-      case 1:{
-          if(_arcs[arcindex]->previous){
-            if((*((_arcs[arcindex]->previous)->arc))[3]==(*((_arcs[arcindex])->arc))[0]){
-              (*((_arcs[arcindex]->previous)->arc))[2]-=diff;
-            }else{
-               (*((_arcs[arcindex]->previous)->arc))[1]-=diff;
-            }
-            if(!updateArcForRendering(_arcs[arcindex]->previous))return GL_FALSE;
+          ArcAttributes* neighbour = (pointindex == 1) ? attr->previous : attr->next;
+          int end = (pointindex == 1) ? 0 : 3;
+          if(neighbour){
+            int index = ((*(neighbour->arc))[3]==(*(attr->arc))[end]) ? 2 : 1;
+            DCoordinate3 delta = -diff;
+            if(!displaceArcPoints(neighbour,1,&index,&delta))return GL_FALSE;
           }
-          (*((_arcs[arcindex])->arc))[1]=newcoord;
-          if(!updateArcForRendering(_arcs[arcindex]))return GL_FALSE;
+          if(!displaceArcPoints(attr,1,&pointindex,&diff))return GL_FALSE;
         }  break;
-
     }
     return GL_TRUE;
   }
@@ -3,6 +3,7 @@
 #include "HyperbolicArc3.h"
 #include "../Core/GenericCurves3.h"
 #include "../Core/Colors4.h"
+#include "../Core/RealBandedMatrices.h"
 #include "./IndicatingSphere.h"
 #include <vector>
 #include <fstream>
@@ -15,6 +16,8 @@ namespace cagd {
     enum Direction{Left=-1,Right=1};
     static const GLuint div_point_count = 100;
     constexpr static const GLdouble derivative_scale = 0.3;
+    // the order of derivatives and their scale in the images of the arcs that are updated for rendering
+    static const GLuint derivative_order = 2;
     IndicatingSphere* leftSphere;
     IndicatingSphere* rightSphere;
 
@@ -26,7 +29,10 @@ namespace cagd {
         Color4 * derivatives_color;
         ArcAttributes * next;
         ArcAttributes * previous;
-        ArcAttributes():arc(0),img(0),color(0),next(0),previous(0){
+        // the maximum order of derivatives of img and the scale of the derivatives in its vertex buffer objects
+        GLuint img_order;
+        GLdouble img_scale;
+        ArcAttributes():arc(0),img(0),color(0),next(0),previous(0),img_order(0),img_scale(1.0){
         }
         ArcAttributes(const ArcAttributes & other);
         ArcAttributes& operator=(const ArcAttributes & other);
@@ -35,17 +41,40 @@ namespace cagd {
         GLboolean generateImage(GLuint max_order_of_derivatives){
           if(img)delete img;
           img = arc->GenerateImage(max_order_of_derivatives,div_point_count);
+          img_order = max_order_of_derivatives;
           return img != 0;
         }
         GLboolean updateVBO(GLdouble scale){
            if(!img)return GL_FALSE;
+           img_scale = scale;
            return img->UpdateVertexBufferObjects(scale);
         }
     };
 
+    // Arc-length parametrization of a chain of joined arcs by one global parameter s in [0, getLength()]. The
+    // arcs are traversed from one free end of the chain to the other one (or around a closed chain), arcs that are
+    // joined end to end or start to start are traversed backwards. A global value is located by a binary search of
+    // the offsets, then the arc-length table of its arc is inverted. The tables refer to the arcs, hence the chain
+    // has to be rebuilt after the arcs or their links have been modified.
+    class ChainArcLength{
+    public:
+      vector<ArcAttributes*> arcs;
+      vector<GLboolean> reversed;
+      vector<ArcLengthTable> tables;
+      vector<GLdouble> offsets;   // offsets[i] is the length of the chain before arcs[i], offsets.back() is the length
+
+      GLdouble getLength() const{return offsets.empty() ? 0.0 : offsets.back();}
+
+      // the point and its derivatives at the global arc length s; the derivatives are taken with respect to the
+      // parameter of the arc, but their signs follow the direction of the chain
+      GLboolean derivativesAt(GLdouble s,GLuint max_order_of_derivatives,LinearCombination3::Derivatives& d,GLuint newton_iterations=2) const;
+    };
+
   protected:
     vector<ArcAttributes*> _arcs;
     GLuint _arc_count;
+    // deletes the last arcs first, ..., _arc_count - 1, none of the other arcs may be linked to them
+    void removeArcsFrom(GLuint first);
   public:
     int getSize(){return _arc_count;}
     ArcAttributes* getArc(int index){return _arcs[index];}
@@ -55,12 +84,38 @@ namespace cagd {
       rightSphere = new IndicatingSphere(0.01);
     }
 
+    // appends an arc without image, returns 0 if the curve is full or the data could not be uploaded
+    ArcAttributes* appendArc(GLdouble alpha,const ColumnMatrix<DCoordinate3>& _data,Color4 color=Color4(0.5,0.5,0.5,0));
     GLboolean insert(GLdouble alpha,GLuint max_order_of_derivatives,const ColumnMatrix<DCoordinate3>& _data,GLdouble scale,Color4 color=Color4(0.5,0.5,0.5,0));
+    // (re)generates the images of the arcs first, ..., last in parallel (see LinearCombination3::GenerateImages)
+    // and updates their vertex buffer objects
+    GLboolean generateImages(GLuint first,GLuint last,GLuint max_order_of_derivatives,GLdouble scale);
     GLboolean continueExisting(GLuint id,Direction direction,GLdouble alpha, GLuint max_order_derivative,GLdouble scale );
     GLuint join(GLuint firstId, GLuint SecondID,Direction firstDirection,Direction secondDirection,GLdouble scale);
     GLuint merge(GLuint firstId, GLuint SecondID,Direction firstDirection,Direction secondDirection);
     GLboolean updatePosition(int arcindex,int pointindex,DCoordinate3 newcoord);
     GLboolean updateArcForRendering( ArcAttributes*);
+    // Incremental counterpart of updateArcForRendering: displaces the control points pointindices[i] of the arc by
+    // deltas[i], adds deltas[i] * F_i(u_k) to every derivative of the existing image and pushes only the changed
+    // samples into the existing vertex buffer objects, i.e., no blending function is evaluated while dragging.
+    // Falls back to updateArcForRendering, if the arc has no image or vertex buffer objects yet, or if its image
+    // differs in the order or the scale of the derivatives from the ones of updateArcForRendering.
+    GLboolean displaceArcPoints(ArcAttributes*,GLuint count,const int* pointindices,const DCoordinate3* deltas);
+
+    // collects the chain of the arc arcindex and tabulates the arc length of each of its arcs; an open chain starts
+    // at the free end that is reached by leaving the given arc through its end 0, a closed one at the given arc
+    GLboolean buildChainArcLength(int arcindex,ChainArcLength& chain,GLuint segment_count=ArcLengthTable::DEFAULT_SEGMENT_COUNT);
+
+    // Control points of the chain of point_count - 1 arcs of shape parameter alpha that interpolates the given
+    // points; arc i is defined by control_points[3i], ..., control_points[3i+3]. The tangents at the points are
+    // the unknowns of a tridiagonal system that makes the chain C2 continuous at the inner points (hence C1 in
+    // particular), while the second derivatives vanish at the two ends. The system is solved by a banded LU
+    // decomposition in O(point_count) time.
+    static GLboolean calculateInterpolatingControlPoints(const vector<DCoordinate3>& points,GLdouble alpha,ColumnMatrix<DCoordinate3>& control_points);
+
+    // appends the interpolating chain of the given points as point_count - 1 linked arcs; if an arc cannot be
+    // appended or imaged, the arcs appended so far are removed again, i.e., the curve is left unchanged
+    GLboolean interpolate(const vector<DCoordinate3>& points,GLdouble alpha,GLuint max_order_of_derivatives,GLdouble scale,Color4 color=Color4(0.5,0.5,0.5,0));
 
     // Sphere stuff
     void updateSpheresLocationByindex(GLuint index);
@@ -120,8 +175,9 @@ namespace cagd {
           file>>points[j];
           cout<<points[j]<<endl;
           }
-          insert(5, 1, points,0.6,Color4(0,0,1));
+          appendArc(5, points,Color4(0,0,1));
       }
+      if(_arc_count)generateImages(0,_arc_count-1,1,0.6);
       int index,neighboureIndex;
       for (int i = 0; i < num_of_arcs; ++i) {
         file>>index>>neighboureIndex;
@@ -64,21 +64,62 @@ GLboolean HyperbolicPatch3::UBlendingFunctionValues(
   if(u< _u_min || u > _u_max ){
       return GL_FALSE;
   }
+  FixedMatrix<GLdouble, 1, 4> values;
+  blendingFunctionValues(u,values);
   blending_values.ResizeColumns(4);
-  blending_values[3] = pow(sinh(u/2.0),4)/constants[1];
-  blending_values[0] = pow(sinh((_alpha - u)/2.0),4)/constants[1];
-  blending_values[2] = (constants[0]/constants[1])*sinh((_alpha - u)/2.0)*pow(sinh(u/2.0),3)
-              + (constants[2]/constants[1])*pow(sinh((_alpha-u)/2.0),2)*pow(sinh(u/2.0),2);
-  blending_values[1] = (constants[0]/constants[1])*sinh((u)/2.0)*pow(sinh((_alpha-u)/2.0),3)
-      + (constants[2]/constants[1])*pow(sinh((u)/2.0),2)*pow(sinh((_alpha-u)/2.0),2);
+  for (GLuint i=0;i<4;i++) {
+    blending_values[i] = values[i];
+  }
   return GL_TRUE;
 }
 
+void HyperbolicPatch3::blendingFunctionValues(GLdouble t, FixedMatrix<GLdouble, 1, 4>& values)const{
+  values[3] = pow(sinh(t/2.0),4)/constants[1];
+  values[0] = pow(sinh((_alpha - t)/2.0),4)/constants[1];
+  values[2] = (constants[0]/constants[1])*sinh((_alpha - t)/2.0)*pow(sinh(t/2.0),3)
+              + (constants[2]/constants[1])*pow(sinh((_alpha-t)/2.0),2)*pow(sinh(t/2.0),2);
+  values[1] = (constants[0]/constants[1])*sinh((t)/2.0)*pow(sinh((_alpha-t)/2.0),3)
+      + (constants[2]/constants[1])*pow(sinh((t)/2.0),2)*pow(sinh((_alpha-t)/2.0),2);
+}
+
 GLboolean HyperbolicPatch3::VBlendingFunctionValues(
     GLdouble v_knot, RowMatrix<GLdouble>& blending_values) const{
   return UBlendingFunctionValues(v_knot,blending_values);
 }
 
+GLboolean HyperbolicPatch3::UBlendingFunctionDerivatives(
+    GLuint maximum_order_of_derivatives, GLdouble u, Matrix<GLdouble>& derivatives) const{
+  if(maximum_order_of_derivatives > 2 || u < _u_min || u > _u_max){
+      return GL_FALSE;
+  }
+  derivatives.ResizeRows(maximum_order_of_derivatives + 1);
+  derivatives.ResizeColumns(4);
+
+  FixedMatrix<GLdouble, 1, 4> values;
+  blendingFunctionValues(u,values);
+  for (GLuint i=0;i<4;i++) {
+    derivatives(0,i) = values[i];
+  }
+  if(maximum_order_of_derivatives >= 1){
+      derivatives(1,0) = F0firstDerivative(u);
+      derivatives(1,1) = F1firstDerivative(u);
+      derivatives(1,2) = F2firstDerivative(u);
+      derivatives(1,3) = F3firstDerivative(u);
+  }
+  if(maximum_order_of_derivatives >= 2){
+      derivatives(2,0) = F0secondDerivative(u);
+      derivatives(2,1) = F1secondDerivative(u);
+      derivatives(2,2) = F2secondDerivative(u);
+      derivatives(2,3) = F3secondDerivative(u);
+  }
+  return GL_TRUE;
+}
+
+GLboolean HyperbolicPatch3::VBlendingFunctionDerivatives(
+    GLuint maximum_order_of_derivatives, GLdouble v, Matrix<GLdouble>& derivatives) const{
+  return UBlendingFunctionDerivatives(maximum_order_of_derivatives,v,derivatives);
+}
+
 GLdouble  HyperbolicPatch3::G3firstDerivative(GLdouble t)const{
   return F3firstDerivative(t);
 }
@@ -112,15 +153,16 @@ GLboolean HyperbolicPatch3::CalculatePartialDerivatives(
   if(u < 0 || u > _alpha || v < 0 || v > _alpha ){
       return GL_FALSE;
   }
-  RowMatrix<GLdouble> u_blending_values(4),d1_u_blending_values(4);
-  UBlendingFunctionValues(u,u_blending_values);
+  // 4 x 4 control net, all blending values live on the stack
+  FixedMatrix<GLdouble, 1, 4> u_blending_values,d1_u_blending_values;
+  blendingFunctionValues(u,u_blending_values);
   d1_u_blending_values[0] =F0firstDerivative(u);
   d1_u_blending_values[1] =F1firstDerivative(u);
   d1_u_blending_values[2] =F2firstDerivative(u);
   d1_u_blending_values[3] =F3firstDerivative(u);
 
-  RowMatrix<GLdouble> v_blending_values(4),d1_v_blending_values(4);
-  VBlendingFunctionValues(v,v_blending_values);
+  FixedMatrix<GLdouble, 1, 4> v_blending_values,d1_v_blending_values;
+  blendingFunctionValues(v,v_blending_values);
   d1_v_blending_values[0] =G0firstDerivative(v);
   d1_v_blending_values[1] =G1firstDerivative(v);
   d1_v_blending_values[2] =G2firstDerivative(v);
@@ -131,12 +173,12 @@ GLboolean HyperbolicPatch3::CalculatePartialDerivatives(
   for (GLuint row=0;row < 4;++row) {
       DCoordinate3 aux_d0_v,aux_d1_v;
       for (GLuint column=0;column< 4;++column) {
-        aux_d0_v += _data(row,column) * v_blending_values(column);
-        aux_d1_v += _data(row,column) * d1_v_blending_values(column);
+        aux_d0_v += _data(row,column) * v_blending_values[column];
+        aux_d1_v += _data(row,column) * d1_v_blending_values[column];
       }
-      pd(0,0) += aux_d0_v * u_blending_values(row);
-      pd(1,0) += aux_d0_v * d1_u_blending_values(row);
-      pd(1,1) += aux_d1_v * u_blending_values(row);
+      pd(0,0) += aux_d0_v * u_blending_values[row];
+      pd(1,0) += aux_d0_v * d1_u_blending_values[row];
+      pd(1,1) += aux_d1_v * u_blending_values[row];
   }
   return GL_TRUE;
 }
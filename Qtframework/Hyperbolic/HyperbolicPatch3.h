@@ -1,14 +1,17 @@
 #ifndef HYPERBOLICPATCH3_H
 #define HYPERBOLICPATCH3_H
 #include "../Core/TensorProductSurfaces3.h"
+#include "../Core/FixedMatrices.h"
 using namespace  cagd;
 class HyperbolicPatch3:public TensorProductSurface3{
 private:
   GLdouble _alpha;
   GLdouble sinh(GLdouble x)const;
   GLdouble cosh(GLdouble x)const;
-  RowMatrix<GLdouble> constants;
+  FixedMatrix<GLdouble, 1, 3> constants;
   void updateConstants();
+  // the four blending function values without range check, stored inline
+  void blendingFunctionValues(GLdouble t, FixedMatrix<GLdouble, 1, 4>& values)const;
 
   GLdouble F3firstDerivative(GLdouble t)const;
   GLdouble F2firstDerivative(GLdouble t)const;
@@ -33,13 +36,21 @@ public:
   HyperbolicPatch3(GLdouble alpha):TensorProductSurface3(0, alpha,0,alpha),_alpha(alpha){
     updateConstants();
   }
-  HyperbolicPatch3(const HyperbolicPatch3& other):TensorProductSurface3(other),_alpha(other._alpha){}
+  HyperbolicPatch3(const HyperbolicPatch3& other):TensorProductSurface3(other),_alpha(other._alpha),constants(other.constants){}
+  HyperbolicPatch3(HyperbolicPatch3&& other) noexcept:TensorProductSurface3(std::move(other)),_alpha(other._alpha),constants(other.constants){}
   virtual GLboolean UBlendingFunctionValues(
           GLdouble u_knot, RowMatrix<GLdouble>& blending_values) const;
 
   virtual GLboolean VBlendingFunctionValues(
           GLdouble v_knot, RowMatrix<GLdouble>& blending_values) const;
 
+  // values, first and second order derivatives of the blending functions
+  virtual GLboolean UBlendingFunctionDerivatives(
+          GLuint maximum_order_of_derivatives, GLdouble u_knot, Matrix<GLdouble>& derivatives) const;
+
+  virtual GLboolean VBlendingFunctionDerivatives(
+          GLuint maximum_order_of_derivatives, GLdouble v_knot, Matrix<GLdouble>& derivatives) const;
+
   // calculates the point and higher order (mixed) partial derivatives of the
   // tensor product surface
   //
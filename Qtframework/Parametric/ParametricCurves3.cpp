@@ -1,4 +1,7 @@
 #include "ParametricCurves3.h"
+#include "../Core/AdaptiveCurveSamplers.h"
+#include "../Core/RealSquareMatrices.h"
+#include <algorithm>
 
 using namespace cagd;
 using namespace std;
@@ -42,13 +45,19 @@ GenericCurve3* ParametricCurve3::GenerateImage(GLuint div_point_count, GLenum us
         (*result)(order, div_point_count - 1) = _derivatives[order](_u_max);
     }
 
-    // calculate derivatives at inner curve points
+    // calculate derivatives at inner curve points; every parameter value is computed directly from its index,
+    // hence the samples are independent and the result does not depend on the number of threads
     GLdouble u_step = (_u_max - _u_min) / (div_point_count - 1);
-    GLdouble u = _u_min;
 
-    for (GLuint i = 1; i < div_point_count - 1; i++)
+    GLint     inner_count  = (GLint)div_point_count - 2;
+    GLint     thread_count = (GLint)RealSquareMatrix::GetThreadCount();
+    GLboolean parallel     = (thread_count > 1 && inner_count >= (GLint)PARALLEL_SAMPLE_THRESHOLD);
+    (void)parallel;
+
+    #pragma omp parallel for num_threads(thread_count) schedule(static) if(parallel)
+    for (GLint i = 1; i <= inner_count; i++)
     {
-        u += u_step;
+        GLdouble u = min(_u_min + i * u_step, _u_max);
 
         for (GLuint order = 0; order < _derivatives.GetColumnCount(); ++order)
         {
@@ -59,6 +68,29 @@ GenericCurve3* ParametricCurve3::GenerateImage(GLuint div_point_count, GLenum us
     return result;
 }
 
+// generate curvature-adaptive image of the parametric curve
+GenericCurve3* ParametricCurve3::GenerateAdaptiveImage(GLdouble tolerance, GLenum usage_flag) const
+{
+    AdaptiveCurveSampler sampler;
+
+    if (!_derivatives.GetColumnCount() || !sampler.SetTolerance(tolerance))
+        return nullptr;
+
+    AdaptiveCurveSampler::Evaluator evaluator =
+            [this](GLuint max_order, GLdouble u, DCoordinate3 *derivatives) -> GLboolean
+    {
+        for (GLuint order = 0; order <= max_order; ++order)
+            derivatives[order] = _derivatives[order](u);
+
+        return GL_TRUE;
+    };
+
+    GLuint max_order_of_derivatives = _derivatives.GetColumnCount() - 1;
+
+    return sampler.GenerateImage(evaluator, max_order_of_derivatives, max_order_of_derivatives,
+                                 _u_min, _u_max, usage_flag);
+}
+
 // set/get definition domain
 GLvoid ParametricCurve3::SetDefinitionDomain(GLdouble u_min, GLdouble u_max)
 {
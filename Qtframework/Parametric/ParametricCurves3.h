@@ -15,6 +15,9 @@ namespace cagd
         typedef DCoordinate3 (*Derivative)(GLdouble);
 
     private:
+        // images with fewer inner samples are always generated by a single thread
+        static const GLuint PARALLEL_SAMPLE_THRESHOLD = 1024;
+
         // definition domain
         GLdouble _u_min, _u_max;
 
@@ -28,9 +31,14 @@ namespace cagd
         // calculate derivative at the parameter value u
         DCoordinate3 operator ()(GLuint order, GLdouble u) const;
 
-        // generate image/arc
+        // generate image/arc; long sample ranges are evaluated in parallel by RealSquareMatrix::GetThreadCount()
+        // threads, hence the derivatives have to be thread-safe functions
         GenericCurve3* GenerateImage(GLuint div_point_count, GLenum usage_flag = GL_STATIC_DRAW) const;
 
+        // curvature-adaptive image, whose chordal deviation is at most the given tolerance (see
+        // AdaptiveCurveSampler); the sag estimate uses the second derivatives, if they are provided
+        GenericCurve3* GenerateAdaptiveImage(GLdouble tolerance, GLenum usage_flag = GL_STATIC_DRAW) const;
+
         // set/get definition domain
         GLvoid SetDefinitionDomain(GLdouble u_min, GLdouble u_max);
         GLvoid GetDefinitionDomain(GLdouble& u_min, GLdouble& u_max) const;
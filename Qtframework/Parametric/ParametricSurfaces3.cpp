@@ -81,12 +81,13 @@ namespace cagd
                 index[3] = index[2] - 1;
 
                 // surface point
-                (*result)._vertex[index[0]] =  offset +scale*(_pd(0, 0)(u, v));
+                (*result)._vertex.Set(index[0], offset +scale*(_pd(0, 0)(u, v)));
 
                 // the surface normal is obtained as the cross product of the first order partial derivatives
-                (*result)._normal[index[0]] =  _pd(1, 0)(u, v);
-                (*result)._normal[index[0]] ^= _pd(1, 1)(u, v);
-                (*result)._normal[index[0]].normalize();
+                DCoordinate3 normal = _pd(1, 0)(u, v);
+                normal ^= _pd(1, 1)(u, v);
+                normal.normalize();
+                (*result)._normal.Set(index[0], normal);
 
                 // texture coordinates
                 (*result)._tex[index[0]].s() = s;
@@ -1,5 +1,11 @@
 QT += core gui widgets opengl
 
+# the unrolled kernels of Core/SmallLinearSystems.h use generic lambdas
+CONFIG += c++14
+
+# the GEMM, SpMV and coordinate array kernels are vectorized by AVX2 and FMA instructions only if they are
+# targeted explicitly, e.g., by 'qmake "CONFIG += avx2"'; the default build runs on any x86_64 processor
+
 
 
 win32 {
@@ -29,8 +35,11 @@ win32 {
     }
 
     msvc {
-      QMAKE_CXXFLAGS += -openmp -arch:AVX -D "_CRT_SECURE_NO_WARNINGS"
+      QMAKE_CXXFLAGS += -openmp -D "_CRT_SECURE_NO_WARNINGS"
       QMAKE_CXXFLAGS_RELEASE *= -O2
+
+      # MSVC emits FMA instructions under AVX2 as well
+      avx2: QMAKE_CXXFLAGS += -arch:AVX2
     }
 }
 
@@ -39,6 +48,13 @@ unix: !mac {
 
     # for GLEW installed into /usr/lib/libGLEW.so or /usr/lib/glew.lib
     LIBS += -lGLEW -lGLU -lfreeimage
+
+    # multithreaded LU decomposition and linear system solving
+    QMAKE_CXXFLAGS += -fopenmp
+    LIBS += -fopenmp
+
+    # AVX2 and FMA kernels of the GEMM, SpMV and coordinate array routines
+    avx2: QMAKE_CXXFLAGS += -mavx2 -mfma
 }
 
 mac {
@@ -66,9 +82,26 @@ HEADERS += \
     GUI/SideWidget.h \
     Core/Exceptions.h \
     Core/Matrices.h \
+    Core/FixedMatrices.h \
+    Core/MappedFiles.h \
+    Core/MatrixSerialization.h \
+    Core/MatrixAlgebra.h \
+    Core/Arenas.h \
+    Core/LruCaches.h \
+    Core/FactorizationCaches.h \
+    Core/BasisTableCaches.h \
+    Core/AdaptiveCurveSamplers.h \
+    Core/ArcLengthTables.h \
     Core/DCoordinates3.h \
+    Core/DCoordinate3Arrays.h \
     Core/TCoordinates4.h \
     Core/RealSquareMatrices.h \
+    Core/RealRectangularMatrices.h \
+    Core/RealBandedMatrices.h \
+    Core/SparseMatrices.h \
+    Core/SparseSolvers.h \
+    Core/SmallLinearSystems.h \
+    Core/FastFourierTransforms.h \
     Core/GenericCurves3.h \
     Core/Constants.h \                        
     Dependencies/Include/GL/glew.h \   
@@ -99,6 +132,20 @@ SOURCES += \
     GUI/SideWidget.cpp \
     main.cpp \
     Core/RealSquareMatrices.cpp \
+    Core/RealRectangularMatrices.cpp \
+    Core/RealBandedMatrices.cpp \
+    Core/SparseMatrices.cpp \
+    Core/SparseSolvers.cpp \
+    Core/SmallLinearSystems.cpp \
+    Core/FastFourierTransforms.cpp \
+    Core/MappedFiles.cpp \
+    Core/MatrixAlgebra.cpp \
+    Core/Arenas.cpp \
+    Core/FactorizationCaches.cpp \
+    Core/BasisTableCaches.cpp \
+    Core/AdaptiveCurveSamplers.cpp \
+    Core/ArcLengthTables.cpp \
+    Core/DCoordinate3Arrays.cpp \
     Core/GenericCurves3.cpp \                    
     Parametric/ParametricCurves3.cpp \                            
     Test/TestFunctions.cpp \    
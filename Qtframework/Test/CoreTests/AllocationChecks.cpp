@@ -0,0 +1,130 @@
+#include "CoreTests.h"
+#include "Core/TriangulatedMeshes3.h"
+#include "Hyperbolic/HyperbolicPatch3.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace cagd;
+using namespace std;
+
+// the replaced global allocation functions below count the calls made while counting is switched on
+static atomic<bool>        counting(false);
+static atomic<std::size_t> allocation_count(0);
+
+void* operator new(std::size_t size)
+{
+    if (counting)
+        ++allocation_count;
+
+    if (void *memory = malloc(size ? size : 1))
+        return memory;
+
+    throw bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const nothrow_t&) noexcept
+{
+    try
+    {
+        return operator new(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const nothrow_t&) noexcept
+{
+    return operator new(size, nothrow);
+}
+
+void operator delete(void *memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept
+{
+    free(memory);
+}
+
+// the number of heap allocations made by the given job
+template <typename Job>
+static std::size_t CountAllocations(Job job)
+{
+    allocation_count = 0;
+    counting = true;
+    job();
+    counting = false;
+    return allocation_count;
+}
+
+GLboolean tests::CheckTessellationAllocations()
+{
+    const GLuint div_point_count = 200;
+
+    HyperbolicPatch3 patch(2.0);
+
+    for (GLuint i = 0; i < 4; ++i)
+        for (GLuint j = 0; j < 4; ++j)
+            patch.SetData(i, j, i, j, (i + j) % 3 * 0.5);
+
+    GLboolean passed = GL_TRUE;
+
+    const TriangulatedMesh3::Precision precisions[] =
+            {TriangulatedMesh3::DOUBLE_PRECISION, TriangulatedMesh3::SINGLE_PRECISION};
+
+    for (TriangulatedMesh3::Precision precision: precisions)
+    {
+        // the first job grows the arena and the per-thread buffers of the calling thread
+        delete patch.GenerateImage(div_point_count, div_point_count, GL_STATIC_DRAW, precision);
+
+        // the returned mesh is owned by the caller, hence the allocation of the object itself and those of its
+        // buffers cannot be avoided
+        std::size_t mesh_allocations = 1 + CountAllocations([&]()
+        {
+            TriangulatedMesh3 mesh(div_point_count * div_point_count,
+                                   2 * (div_point_count - 1) * (div_point_count - 1),
+                                   GL_STATIC_DRAW, precision);
+        });
+
+        TriangulatedMesh3 *image = nullptr;
+
+        std::size_t tessellation_allocations = CountAllocations([&]()
+        {
+            image = patch.GenerateImage(div_point_count, div_point_count, GL_STATIC_DRAW, precision);
+        });
+
+        GLboolean succeeded = image && tessellation_allocations == mesh_allocations;
+
+        cout << "tessellation allocations ("
+             << (precision == TriangulatedMesh3::SINGLE_PRECISION ? "single" : "double") << " precision): "
+             << tessellation_allocations << ", of which " << mesh_allocations << " belong to the mesh"
+             << (succeeded ? "" : " -- FAILED") << endl;
+
+        delete image;
+
+        passed = passed && succeeded;
+    }
+
+    return passed;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <chrono>
+
+namespace cagd
+{
+    namespace tests
+    {
+        // every check reports its outcome on the standard output and returns GL_FALSE on failure
+
+        // after a warm-up, tessellating a 200x200 grid of a tensor product surface allocates only the returned mesh
+        GLboolean CheckTessellationAllocations();
+
+        // LinearCombination3::GenerateImages produces the same bits by 1 and by several threads, both for curves
+        // imaged by cached basis tables and for curves evaluated in chunks of samples
+        GLboolean CheckParallelCurveImages();
+
+        // LoadBinary rejects truncated data and headers whose counts exceed the data or overflow, both when
+        // reading from a stream and from a mapped file, instead of resizing the matrix accordingly; valid dense and
+        // triangular matrices are loaded bit-exactly
+        GLboolean CheckCorruptBinaryMatrices();
+
+        // SparseCholeskyDecomposition factorizes matrices of very many connected components, and analyzes again
+        // when Factorize is given a matrix of another sparsity pattern
+        GLboolean CheckSparseCholeskyStructure();
+
+        // the discrete Fourier transform of CyclicCurve3::UpdateDataForInterpolation yields the control points of
+        // the LU decomposition on uniform knots, also for orders whose eigenvalues are not resolved in double
+        // precision (where the LU decomposition is taken)
+        GLboolean CheckCyclicInterpolation();
+
+        // mixed precision LU decompositions refine the solutions of well-conditioned systems to double precision
+        // with single precision factors, while ill-conditioned ones fall back to double precision factors
+        GLboolean CheckMixedPrecisionRefinement();
+
+        // FactorizationCache counts a miss for every new pair of alpha and knot vector of HyperbolicArc3 and a hit
+        // for every repeated one, while the cached factors interpolate the data points
+        GLboolean CheckFactorizationCache();
+
+        // the unrolled FixedSizeLU<N> kernels of RealSquareMatrix (N = 2, ..., 8) yield the same factors and
+        // solutions as the generic decomposition of the same matrix embedded into a larger block diagonal one
+        GLboolean CheckFixedSizeLUDecompositions();
+
+        // SolveLinearSystems4x4 reproduces the solutions of RealSquareMatrix::SolveLinearSystem both in its
+        // vectorized groups and for the remaining systems, and reports singular systems
+        GLboolean CheckBatched4x4Solver();
+
+        // the blocked Householder QR decomposition of RealRectangularMatrix solves a well-conditioned least
+        // squares fit spanning several panels as the normal equations do
+        GLboolean CheckBlockedLeastSquares();
+
+        // ConjugateGradientSolver (Jacobi and IC(0) preconditioners) and SparseCholeskyDecomposition solve the
+        // 5-point Laplacian of a grid to the requested, resp. rounding error level residuals
+        GLboolean CheckSparseSolvers();
+
+        // the arcs of HyperbolicCompositeCurve3::calculateInterpolatingControlPoints interpolate the points,
+        // join C2 continuously at the inner ones and have vanishing second derivatives at the ends
+        GLboolean CheckHyperbolicInterpolatingChain();
+
+        // the chords of the images of AdaptiveCurveSampler stay within the tolerance of the curve, while a straight
+        // segment is not refined at all
+        GLboolean CheckAdaptiveCurveSampling();
+
+        // ArcLengthTable reproduces the length of a circle of non-uniform speed and maps arc lengths to parameters
+        // and back to the same arc lengths
+        GLboolean CheckArcLengthRoundTrip();
+
+        // every benchmark prints a table of its timings on the standard output
+
+        // PerformLUDecomposition and GenericCurve3::UpdateVertexBufferObjects compared to the same algorithms
+        // running on the former row-by-row (std::vector<std::vector<T>>) storage; the latter is skipped if no
+        // OpenGL context can be created
+        GLvoid BenchmarkLUDecomposition();
+        GLvoid BenchmarkVertexBufferFill();
+
+        // SaveBinary and LoadBinary (from a stream and from a mapped file) of Matrix<DCoordinate3> compared to the
+        // text stream operators, including file sizes and the precision of the loaded elements
+        GLvoid BenchmarkSerialization();
+
+        // PerformLUDecomposition and the multi-RHS SolveLinearSystem of perturbed CyclicCurve3 collocation systems
+        // on 1, 2, 4 and 8 threads
+        GLvoid BenchmarkThreadScaling();
+
+        // SpMV, the Jacobi and IC(0) preconditioned conjugate gradient method and the sparse Cholesky
+        // decomposition on grid Laplacians of 10^5 to 10^6 unknowns
+        GLvoid BenchmarkSparseSolvers();
+
+        // the average running time of a job in milliseconds
+        template <typename Job>
+        GLdouble Milliseconds(Job job, GLuint repetition_count = 1)
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            for (GLuint r = 0; r < repetition_count; ++r)
+                job();
+
+            std::chrono::duration<GLdouble, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+            return elapsed.count() / repetition_count;
+        }
+    }
+}
@@ -0,0 +1,93 @@
+# console checks and benchmarks of the Core classes, they do not need a window or an OpenGL context
+QT += core gui
+QT -= widgets
+
+CONFIG += console c++14
+
+# the vectorized kernels are opt-in as in QtFramework.pro, e.g., 'qmake "CONFIG += avx2"' builds them
+CONFIG -= app_bundle
+
+TEMPLATE = app
+TARGET = CoreTests
+
+INCLUDEPATH += $$PWD/../..
+
+win32 {
+    INCLUDEPATH += $$PWD/../../Dependencies/Include
+    DEPENDPATH += $$PWD/../../Dependencies/Include
+
+    LIBS += -lopengl32 -lglu32
+
+    contains(QT_ARCH, i386) {
+        LIBS += -L"$$PWD/../../Dependencies/Lib/GL/x86/" -lglew32
+    } else {
+        LIBS += -L"$$PWD/../../Dependencies/Lib/GL/x86_64/" -lglew32
+    }
+
+    msvc {
+      QMAKE_CXXFLAGS += -openmp -D "_CRT_SECURE_NO_WARNINGS"
+      QMAKE_CXXFLAGS_RELEASE *= -O2
+
+      avx2: QMAKE_CXXFLAGS += -arch:AVX2
+    }
+}
+
+unix: !mac {
+    LIBS += -lGLEW -lGLU
+
+    QMAKE_CXXFLAGS += -fopenmp
+    LIBS += -fopenmp
+
+    avx2: QMAKE_CXXFLAGS += -mavx2 -mfma
+}
+
+mac {
+    # see QtFramework.pro
+    INCLUDEPATH += "/usr/local/Cellar/glew/x.y.z/include/"
+    LIBS += -L"/usr/local/Cellar/glew/x.y.z/lib/" -lGLEW
+    LIBS += -framework OpenGL
+}
+
+HEADERS += \
+    CoreTests.h
+
+SOURCES += \
+    main.cpp \
+    AllocationChecks.cpp \
+    InterpolationChecks.cpp \
+    LinearSystemChecks.cpp \
+    ParallelImageChecks.cpp \
+    SamplingChecks.cpp \
+    SerializationChecks.cpp \
+    SerializationBenchmarks.cpp \
+    SparseChecks.cpp \
+    SparseBenchmarks.cpp \
+    StorageBenchmarks.cpp \
+    ThreadScalingBenchmarks.cpp \
+    ../../Core/RealSquareMatrices.cpp \
+    ../../Core/RealRectangularMatrices.cpp \
+    ../../Core/MatrixAlgebra.cpp \
+    ../../Core/SmallLinearSystems.cpp \
+    ../../Core/Arenas.cpp \
+    ../../Core/FactorizationCaches.cpp \
+    ../../Core/BasisTableCaches.cpp \
+    ../../Core/AdaptiveCurveSamplers.cpp \
+    ../../Core/FastFourierTransforms.cpp \
+    ../../Core/DCoordinate3Arrays.cpp \
+    ../../Core/ArcLengthTables.cpp \
+    ../../Core/GenericCurves3.cpp \
+    ../../Core/TriangulatedMeshes3.cpp \
+    ../../Core/TensorProductSurfaces3.cpp \
+    ../../Core/LinearCombination3.cpp \
+    ../../Core/MappedFiles.cpp \
+    ../../Core/SparseMatrices.cpp \
+    ../../Core/SparseSolvers.cpp \
+    ../../Core/RealBandedMatrices.cpp \
+    ../../Core/Materials.cpp \
+    ../../Parametric/ParametricCurves3.cpp \
+    ../../Parametric/ParametricSurfaces3.cpp \
+    ../../Test/TestFunctions.cpp \
+    ../../Hyperbolic/HyperbolicArc3.cpp \
+    ../../Hyperbolic/HyperbolicPatch3.cpp \
+    ../../Hyperbolic/HyperbolicCompositeCurves3.cpp \
+    ../../Cyclic/CyclicCurve3.cpp
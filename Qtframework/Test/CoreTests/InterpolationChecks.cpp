@@ -0,0 +1,200 @@
+#include "CoreTests.h"
+#include "Core/Constants.h"
+#include "Core/FactorizationCaches.h"
+#include "Cyclic/CyclicCurves3.h"
+#include "Hyperbolic/HyperbolicArc3.h"
+#include "Hyperbolic/HyperbolicCompositeCurves3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace cagd;
+using namespace std;
+
+// the largest coordinate-wise difference of the control points of two curves of the same order
+static GLdouble Deviation(const CyclicCurve3& lhs, const CyclicCurve3& rhs, GLuint data_count)
+{
+    GLdouble deviation = 0.0;
+
+    for (GLuint i = 0; i < data_count; ++i)
+        for (GLuint c = 0; c < 3; ++c)
+            deviation = max(deviation, fabs(lhs[i][c] - rhs[i][c]));
+
+    return deviation;
+}
+
+GLboolean tests::CheckCyclicInterpolation()
+{
+    // the discrete Fourier transform solves the systems of the first two orders (the condition number of the
+    // latter is binom(20, 10) = 184756), while the eigenvalues of the last one are not resolved in double
+    // precision and the LU decomposition has to be used
+    const GLuint orders[] = {5, 10, 30};
+
+    GLboolean passed = GL_TRUE;
+
+    for (GLuint n: orders)
+    {
+        GLuint   data_count = 2 * n + 1;
+        GLdouble lambda_n   = TWO_PI / data_count;
+
+        ColumnMatrix<GLdouble>     knot_vector(data_count);
+        ColumnMatrix<DCoordinate3> data_points(data_count);
+
+        for (GLuint r = 0; r < data_count; ++r)
+        {
+            GLdouble u = 0.3 + r * lambda_n;
+
+            knot_vector[r] = u;
+            data_points[r] = DCoordinate3(cos(u), sin(2.0 * u), 0.5 * sin(3.0 * u) + 0.25 * cos(u));
+        }
+
+        CyclicCurve3 transformed(n), decomposed(n);
+
+        GLboolean succeeded =
+                transformed.UpdateDataForInterpolation(knot_vector, data_points) &&
+                decomposed.LinearCombination3::UpdateDataForInterpolation(knot_vector, data_points);
+
+        GLdouble deviation = succeeded ? Deviation(transformed, decomposed, data_count) : -1.0;
+
+        succeeded = succeeded && deviation <= 1.0e-9;
+
+        cout << "cyclic interpolation (n = " << n << "): Fourier and LU control points differ by " << deviation
+             << (succeeded ? "" : " -- FAILED") << endl;
+
+        passed = passed && succeeded;
+    }
+
+    return passed;
+}
+
+GLboolean tests::CheckFactorizationCache()
+{
+    FactorizationCache &cache = FactorizationCache::Instance();
+
+    cache.Clear();
+    cache.ResetCounters();
+
+    struct Job
+    {
+        const char *name;
+        GLdouble    alpha, knot_shift;
+        GLuint      hit_count, miss_count;  // expected totals after the job
+    };
+
+    // the collocation matrix is determined by the dynamic type of the curve, by alpha and by the knot vector
+    const Job jobs[] =
+    {
+        {"first interpolation",         1.5, 0.0,  0, 1},
+        {"same alpha and knots",        1.5, 0.0,  1, 1},
+        {"other knots",                 1.5, 0.1,  1, 2},
+        {"other alpha",                 2.0, 0.0,  1, 3},
+        {"first knots again",           1.5, 0.0,  2, 3}
+    };
+
+    ColumnMatrix<DCoordinate3> data_points(4);
+    for (GLuint r = 0; r < 4; ++r)
+        data_points[r] = DCoordinate3(r, r * r, 1.0 - r);
+
+    GLboolean passed = GL_TRUE;
+
+    for (const Job &job: jobs)
+    {
+        HyperbolicArc3 arc(job.alpha);
+
+        ColumnMatrix<GLdouble> knot_vector(4);
+        for (GLuint r = 0; r < 4; ++r)
+            knot_vector[r] = job.alpha * (r + (r == 1 || r == 2 ? job.knot_shift : 0.0)) / 3.0;
+
+        GLboolean succeeded = arc.UpdateDataForInterpolation(knot_vector, data_points);
+
+        // the cached factors have to interpolate the data points as well
+        GLdouble deviation = 0.0;
+        for (GLuint r = 0; succeeded && r < 4; ++r)
+        {
+            LinearCombination3::Derivatives d;
+            succeeded = arc.CalculateDerivatives(0, knot_vector[r], d);
+
+            for (GLuint c = 0; succeeded && c < 3; ++c)
+                deviation = max(deviation, fabs(d[0][c] - data_points[r][c]));
+        }
+
+        GLuint hit_count = cache.GetHitCount(), miss_count = cache.GetMissCount();
+
+        succeeded = succeeded && hit_count == job.hit_count && miss_count == job.miss_count && deviation <= 1.0e-12;
+
+        cout << "factorization cache (" << job.name << "): " << hit_count << " hits, " << miss_count << " misses, "
+             << "interpolation error " << deviation << (succeeded ? "" : " -- FAILED") << endl;
+
+        passed = passed && succeeded;
+    }
+
+    return passed;
+}
+
+GLboolean tests::CheckHyperbolicInterpolatingChain()
+{
+    const GLdouble alphas[]    = {0.5, 1.5, 4.0};
+    const GLuint   point_count = 9;
+
+    vector<DCoordinate3> points(point_count);
+    for (GLuint i = 0; i < point_count; ++i)
+        points[i] = DCoordinate3(cos(0.7 * i), sin(0.7 * i), 0.2 * i + 0.1 * sin(2.0 * i));
+
+    GLboolean passed = GL_TRUE;
+
+    for (GLdouble alpha: alphas)
+    {
+        ColumnMatrix<DCoordinate3> control_points;
+
+        GLboolean succeeded =
+                HyperbolicCompositeCurve3::calculateInterpolatingControlPoints(points, alpha, control_points) &&
+                control_points.GetRowCount() == 3 * (point_count - 1) + 1;
+
+        // the derivatives of order 0, 1 and 2 at both ends of every arc
+        vector<LinearCombination3::Derivatives> starts(point_count - 1), ends(point_count - 1);
+
+        for (GLuint i = 0; succeeded && i + 1 < point_count; ++i)
+        {
+            HyperbolicArc3 arc(alpha);
+            for (GLuint j = 0; j < 4; ++j)
+                arc[j] = control_points[3 * i + j];
+
+            succeeded = arc.CalculateDerivatives(2, 0.0, starts[i]) && arc.CalculateDerivatives(2, alpha, ends[i]);
+        }
+
+        // jumps[r] is the largest coordinate-wise jump of the derivatives of order r at the inner points, the
+        // chain has to interpolate the points and its second derivatives have to vanish at the two ends
+        GLdouble jumps[3] = {0.0, 0.0, 0.0}, interpolation_error = 0.0, end_curvature = 0.0;
+
+        for (GLuint i = 0; succeeded && i + 1 < point_count; ++i)
+        {
+            for (GLuint c = 0; c < 3; ++c)
+            {
+                interpolation_error = max(interpolation_error, fabs(starts[i][0][c] - points[i][c]));
+                interpolation_error = max(interpolation_error, fabs(ends[i][0][c] - points[i + 1][c]));
+
+                for (GLuint r = 0; i + 2 < point_count && r < 3; ++r)
+                    jumps[r] = max(jumps[r], fabs(ends[i][r][c] - starts[i + 1][r][c]));
+            }
+        }
+
+        for (GLuint c = 0; succeeded && c < 3; ++c)
+        {
+            end_curvature = max(end_curvature, fabs(starts[0][2][c]));
+            end_curvature = max(end_curvature, fabs(ends[point_count - 2][2][c]));
+        }
+
+        succeeded = succeeded && jumps[0] <= 1.0e-12 && jumps[1] <= 1.0e-12 && jumps[2] <= 1.0e-12 &&
+                    interpolation_error <= 1.0e-12 && end_curvature <= 1.0e-12;
+
+        cout << "hyperbolic interpolating chain (alpha = " << alpha << "): C0/C1/C2 jumps " << jumps[0] << ", "
+             << jumps[1] << ", " << jumps[2] << ", interpolation error " << interpolation_error
+             << ", end curvature " << end_curvature << (succeeded ? "" : " -- FAILED") << endl;
+
+        passed = passed && succeeded;
+    }
+
+    return passed;
+}
@@ -0,0 +1,274 @@
+#include "CoreTests.h"
+#include "Core/Constants.h"
+#include "Core/RealRectangularMatrices.h"
+#include "Core/RealSquareMatrices.h"
+#include "Core/SmallLinearSystems.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace cagd;
+using namespace std;
+
+// the largest absolute difference of two column matrices of the same size
+static GLdouble Deviation(const ColumnMatrix<GLdouble>& lhs, const ColumnMatrix<GLdouble>& rhs)
+{
+    GLdouble deviation = 0.0;
+
+    for (GLuint i = 0; i < lhs.GetRowCount(); ++i)
+        deviation = max(deviation, fabs(lhs[i] - rhs[i]));
+
+    return deviation;
+}
+
+GLboolean tests::CheckMixedPrecisionRefinement()
+{
+    GLboolean passed = GL_TRUE;
+
+    // a diagonally dominant matrix is solved by refining the single precision solution to double precision
+    {
+        const GLuint size = 100;
+
+        RealSquareMatrix mixed(size);
+        ColumnMatrix<GLdouble> b(size), x, reference;
+
+        for (GLuint i = 0; i < size; ++i)
+        {
+            for (GLuint j = 0; j < size; ++j)
+                mixed(i, j) = (i == j) ? size : sin(1.0 + i + 0.5 * j);
+
+            b[i] = cos((GLdouble)i);
+        }
+
+        RealSquareMatrix exact = mixed;
+
+        GLboolean succeeded = mixed.SetPrecision(RealSquareMatrix::MIXED_PRECISION) &&
+                              mixed.SolveLinearSystem(b, x) && exact.SolveLinearSystem(b, reference);
+
+        GLdouble residual  = mixed.GetResidual();
+        GLdouble deviation = succeeded ? Deviation(x, reference) : -1.0;
+
+        succeeded = succeeded && mixed.HasSinglePrecisionFactors() &&
+                    residual >= 0.0 && residual <= size * numeric_limits<GLdouble>::epsilon() &&
+                    deviation <= 1.0e-13;
+
+        cout << "mixed precision refinement (diagonally dominant): residual " << residual
+             << ", deviation from double precision " << deviation
+             << (mixed.HasSinglePrecisionFactors() ? ", single precision factors" : ", double precision factors")
+             << (succeeded ? "" : " -- FAILED") << endl;
+
+        passed = passed && succeeded;
+    }
+
+    // the condition number of the Hilbert matrix of order 12 is about 1.7e16, the refinement of its single
+    // precision solution stalls and the matrix has to be factorized again in double precision
+    {
+        const GLuint size = 12;
+
+        RealSquareMatrix mixed(size);
+        ColumnMatrix<GLdouble> b(size), x, reference;
+
+        for (GLuint i = 0; i < size; ++i)
+        {
+            for (GLuint j = 0; j < size; ++j)
+                mixed(i, j) = 1.0 / (i + j + 1);
+
+            b[i] = 1.0;
+        }
+
+        RealSquareMatrix exact = mixed;
+
+        GLboolean succeeded = mixed.SetPrecision(RealSquareMatrix::MIXED_PRECISION) &&
+                              mixed.PerformLUDecomposition() && mixed.HasSinglePrecisionFactors() &&
+                              mixed.SolveLinearSystem(b, x) && exact.SolveLinearSystem(b, reference);
+
+        GLdouble residual  = mixed.GetResidual();
+        GLdouble deviation = succeeded ? Deviation(x, reference) : -1.0;
+
+        // the solution of the fallback coincides with the one of the double precision decomposition
+        succeeded = succeeded && !mixed.HasSinglePrecisionFactors() && deviation == 0.0;
+
+        cout << "mixed precision refinement (Hilbert matrix): residual " << residual
+             << ", deviation from double precision " << deviation
+             << (mixed.HasSinglePrecisionFactors() ? ", single precision factors" : ", double precision factors")
+             << (succeeded ? "" : " -- FAILED") << endl;
+
+        passed = passed && succeeded;
+    }
+
+    return passed;
+}
+
+GLboolean tests::CheckFixedSizeLUDecompositions()
+{
+    GLboolean passed = GL_TRUE;
+
+    // matrices of order at most 8 are decomposed by FixedSizeLU<N>; embedded into a block diagonal matrix, whose
+    // other block is the identity matrix of order 9, the same matrix is decomposed by the generic kernel
+    const GLuint identity_order = 9;
+
+    for (GLuint n = 2; n <= 8; ++n)
+    {
+        RealSquareMatrix fixed(n), generic(n + identity_order);
+        ColumnMatrix<GLdouble> b(n), embedded_b(n + identity_order), x, embedded_x;
+
+        for (GLuint i = 0; i < n; ++i)
+        {
+            // the rows are permuted by the pivoting
+            for (GLuint j = 0; j < n; ++j)
+                fixed(i, j) = generic(i, j) = sin(1.0 + 3.0 * i + 7.0 * j * j) + (i == (j + 1) % n ? 2.0 : 0.0);
+
+            b[i] = embedded_b[i] = cos(1.0 + i);
+        }
+
+        for (GLuint i = n; i < n + identity_order; ++i)
+        {
+            for (GLuint j = 0; j < n + identity_order; ++j)
+                generic(i, j) = (i == j) ? 1.0 : 0.0;
+
+            embedded_b[i] = 0.0;
+        }
+
+        GLboolean succeeded = fixed.SolveLinearSystem(b, x) && generic.SolveLinearSystem(embedded_b, embedded_x);
+
+        // both the factors and the solutions are expected to be bit-identical
+        GLdouble factor_deviation = 0.0, solution_deviation = 0.0;
+
+        for (GLuint i = 0; succeeded && i < n; ++i)
+        {
+            for (GLuint j = 0; j < n; ++j)
+                factor_deviation = max(factor_deviation, fabs(fixed(i, j) - generic(i, j)));
+
+            solution_deviation = max(solution_deviation, fabs(x[i] - embedded_x[i]));
+        }
+
+        succeeded = succeeded && factor_deviation == 0.0 && solution_deviation == 0.0;
+
+        cout << "fixed size LU decomposition (n = " << n << "): factors differ by " << factor_deviation
+             << ", solutions by " << solution_deviation << (succeeded ? "" : " -- FAILED") << endl;
+
+        passed = passed && succeeded;
+    }
+
+    return passed;
+}
+
+GLboolean tests::CheckBatched4x4Solver()
+{
+    // two groups of 4 systems and 3 remaining ones; system 5 is singular
+    const GLuint count = 11, singular = 5;
+
+    vector<GLdouble>     a(16 * count);
+    vector<DCoordinate3> b(4 * count), x(4 * count);
+    GLboolean            regular[count];
+
+    for (GLuint s = 0; s < count; ++s)
+    {
+        for (GLuint i = 0; i < 4; ++i)
+        {
+            for (GLuint j = 0; j < 4; ++j)
+                a[16 * s + 4 * i + j] = (s == singular && i == 2) ? 0.0 :
+                                        sin(1.0 + s + 3.0 * i + 5.0 * j * j) + (i == (j + s) % 4 ? 1.5 : 0.0);
+
+            b[4 * s + i] = DCoordinate3(cos(1.0 + s + i), sin(2.0 * i - s), 1.0 + i);
+        }
+    }
+
+    GLboolean result = SolveLinearSystems4x4(count, a.data(), b.data(), x.data(), regular);
+
+    // the call fails because of the singular system, the others are solved as by RealSquareMatrix
+    GLboolean passed    = !result;
+    GLdouble  deviation = 0.0;
+
+    for (GLuint s = 0; s < count; ++s)
+    {
+        if (s == singular)
+        {
+            passed = passed && !regular[s];
+
+            for (GLuint i = 0; i < 4; ++i)
+                passed = passed && x[4 * s + i][0] == 0.0 && x[4 * s + i][1] == 0.0 && x[4 * s + i][2] == 0.0;
+
+            continue;
+        }
+
+        RealSquareMatrix matrix(4);
+        ColumnMatrix<DCoordinate3> rhs(4), solution;
+
+        for (GLuint i = 0; i < 4; ++i)
+        {
+            for (GLuint j = 0; j < 4; ++j)
+                matrix(i, j) = a[16 * s + 4 * i + j];
+
+            rhs[i] = b[4 * s + i];
+        }
+
+        passed = passed && regular[s] && matrix.SolveLinearSystem(rhs, solution);
+
+        for (GLuint i = 0; passed && i < 4; ++i)
+            for (GLuint c = 0; c < 3; ++c)
+                deviation = max(deviation, fabs(x[4 * s + i][c] - solution[i][c]));
+    }
+
+    passed = passed && deviation == 0.0;
+
+    cout << "batched 4x4 solver (" << count << " systems, one of them singular): solutions differ from "
+         << "RealSquareMatrix by " << deviation << (passed ? "" : " -- FAILED") << endl;
+
+    return passed;
+}
+
+GLboolean tests::CheckBlockedLeastSquares()
+{
+    // Chebyshev polynomials sampled at Chebyshev points form a well-conditioned collocation matrix, whose
+    // columns span two panels of QR_BLOCK_SIZE = 32 and a partial third one
+    const GLuint row_count = 200, column_count = 70;
+
+    RealRectangularMatrix  a(row_count, column_count);
+    ColumnMatrix<GLdouble> b(row_count), x;
+
+    for (GLuint i = 0; i < row_count; ++i)
+    {
+        GLdouble theta = PI * (i + 0.5) / row_count;
+
+        for (GLuint j = 0; j < column_count; ++j)
+            a(i, j) = cos(j * theta);
+
+        b[i] = exp(cos(theta)) + 0.01 * sin(37.0 * i);
+    }
+
+    // the normal equations A^T A x = A^T b
+    RealSquareMatrix       normal_matrix(column_count);
+    ColumnMatrix<GLdouble> normal_rhs(column_count), reference;
+
+    for (GLuint j = 0; j < column_count; ++j)
+    {
+        for (GLuint k = 0; k < column_count; ++k)
+        {
+            GLdouble sum = 0.0;
+            for (GLuint i = 0; i < row_count; ++i)
+                sum += a(i, j) * a(i, k);
+            normal_matrix(j, k) = sum;
+        }
+
+        GLdouble sum = 0.0;
+        for (GLuint i = 0; i < row_count; ++i)
+            sum += a(i, j) * b[i];
+        normal_rhs[j] = sum;
+    }
+
+    GLboolean passed = a.SolveLeastSquares(b, x) && normal_matrix.SolveLinearSystem(normal_rhs, reference) &&
+                       x.GetRowCount() == column_count;
+
+    GLdouble deviation = passed ? Deviation(x, reference) : -1.0;
+
+    passed = passed && deviation <= 1.0e-12;
+
+    cout << "blocked QR least squares (" << row_count << " x " << column_count << "): solution differs from "
+         << "the normal equations by " << deviation << (passed ? "" : " -- FAILED") << endl;
+
+    return passed;
+}
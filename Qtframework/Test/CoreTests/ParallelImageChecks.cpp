@@ -0,0 +1,134 @@
+#include "CoreTests.h"
+#include "Core/Constants.h"
+#include "Core/GenericCurves3.h"
+#include "Core/RealSquareMatrices.h"
+#include "Cyclic/CyclicCurves3.h"
+#include "Hyperbolic/HyperbolicArc3.h"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace cagd;
+using namespace std;
+
+// a cyclic curve that does not reveal its shape parameters, hence its images are not products of cached basis
+// tables, but are evaluated by CalculateDerivativesBatch in chunks of SAMPLE_CHUNK_SIZE samples
+class UntabulatedCyclicCurve3: public CyclicCurve3
+{
+public:
+    UntabulatedCyclicCurve3(GLuint n): CyclicCurve3(n)
+    {
+    }
+
+    GLboolean CollocationShapeParameters(vector<GLdouble>&) const
+    {
+        return GL_FALSE;
+    }
+};
+
+// compares the bit patterns of the derivatives stored by two images
+static GLboolean Identical(const GenericCurve3 *lhs, const GenericCurve3 *rhs)
+{
+    if (!lhs || !rhs ||
+        lhs->GetMaximumOrderOfDerivatives() != rhs->GetMaximumOrderOfDerivatives() ||
+        lhs->GetPointCount() != rhs->GetPointCount())
+        return GL_FALSE;
+
+    for (GLuint order = 0; order <= lhs->GetMaximumOrderOfDerivatives(); ++order)
+    {
+        for (GLuint k = 0; k < lhs->GetPointCount(); ++k)
+        {
+            DCoordinate3 a = (*lhs)(order, k), b = (*rhs)(order, k);
+
+            if (memcmp(&a, &b, sizeof(DCoordinate3)))
+                return GL_FALSE;
+        }
+    }
+
+    return GL_TRUE;
+}
+
+// generates the images of the given curves by GenerateImages, using the given number of threads
+static vector<GenericCurve3*> Images(
+        const vector<const LinearCombination3*>& curves, GLuint max_order_of_derivatives, GLuint div_point_count,
+        GLuint thread_count)
+{
+    RealSquareMatrix::SetThreadCount(thread_count);
+
+    vector<GenericCurve3*> images;
+    LinearCombination3::GenerateImages(curves, max_order_of_derivatives, div_point_count, images);
+
+    return images;
+}
+
+GLboolean tests::CheckParallelCurveImages()
+{
+    const GLuint thread_counts[] = {2, 3, 4, 8};
+
+    HyperbolicArc3 arc(1.5);
+    for (GLuint i = 0; i < 4; ++i)
+        arc[i] = DCoordinate3(i, sin(1.0 + i), 0.25 * i * i);
+
+    CyclicCurve3            cyclic(5);
+    UntabulatedCyclicCurve3 untabulated(7);
+
+    for (GLuint i = 0; i < 11; ++i)
+        cyclic[i] = DCoordinate3(cos(i * TWO_PI / 11), sin(i * TWO_PI / 11), 0.1 * i);
+
+    for (GLuint i = 0; i < 15; ++i)
+        untabulated[i] = DCoordinate3(2.0 * cos(i * TWO_PI / 15), sin(2.0 * i * TWO_PI / 15), cos(3.0 * i));
+
+    // a single curve runs the parallel regions of GenerateImage itself: 3 * 2000 table rows exceed
+    // PARALLEL_TABLE_ROW_THRESHOLD, while 2000 untabulated samples form 8 chunks; several curves are
+    // distributed among the threads
+    struct Job
+    {
+        const char                      *name;
+        vector<const LinearCombination3*> curves;
+        GLuint                            max_order_of_derivatives, div_point_count;
+    };
+
+    const Job jobs[] =
+    {
+        {"hyperbolic arc, basis table",   {&arc},                         2, 2000},
+        {"cyclic curve, basis table",     {&cyclic},                      2, 2000},
+        {"cyclic curve, sample chunks",   {&untabulated},                 2, 2000},
+        {"several curves",                {&arc, &cyclic, &untabulated},  2, 1000}
+    };
+
+    GLuint    initial_thread_count = RealSquareMatrix::GetThreadCount();
+    GLboolean passed = GL_TRUE;
+
+    for (const Job &job: jobs)
+    {
+        vector<GenericCurve3*> serial = Images(job.curves, job.max_order_of_derivatives, job.div_point_count, 1);
+
+        GLboolean succeeded = GL_TRUE;
+
+        for (GLuint thread_count: thread_counts)
+        {
+            vector<GenericCurve3*> parallel =
+                    Images(job.curves, job.max_order_of_derivatives, job.div_point_count, thread_count);
+
+            for (GLuint i = 0; i < serial.size(); ++i)
+            {
+                succeeded = succeeded && Identical(serial[i], parallel[i]);
+                delete parallel[i];
+            }
+        }
+
+        for (GenericCurve3 *image: serial)
+            delete image;
+
+        cout << "parallel curve images (" << job.name << "): "
+             << (succeeded ? "identical to the serial ones" : "differ from the serial ones -- FAILED") << endl;
+
+        passed = passed && succeeded;
+    }
+
+    RealSquareMatrix::SetThreadCount(initial_thread_count);
+
+    return passed;
+}
@@ -0,0 +1,171 @@
+#include "CoreTests.h"
+#include "Core/AdaptiveCurveSamplers.h"
+#include "Core/ArcLengthTables.h"
+#include "Core/Constants.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+using namespace cagd;
+using namespace std;
+
+// distance of the point p from the segment [a, b]
+static GLdouble DistanceFromSegment(const DCoordinate3& p, const DCoordinate3& a, const DCoordinate3& b)
+{
+    DCoordinate3 chord          = b - a;
+    GLdouble     squared_length = chord * chord;
+    DCoordinate3 closest        = a;
+
+    if (squared_length > 0.0)
+        closest += chord * max(0.0, min(1.0, ((p - a) * chord) / squared_length));
+
+    return (p - closest).length();
+}
+
+GLboolean tests::CheckAdaptiveCurveSampling()
+{
+    struct Job
+    {
+        const char                      *name;
+        AdaptiveCurveSampler::Evaluator  evaluator;
+        GLdouble                         u_min, u_max;
+    };
+
+    const Job jobs[] =
+    {
+        {"ellipse", [](GLuint, GLdouble u, DCoordinate3 *d)
+        {
+            d[0] = DCoordinate3( 2.0 * cos(u),       sin(u), 0.0);
+            d[1] = DCoordinate3(-2.0 * sin(u),       cos(u), 0.0);
+            d[2] = DCoordinate3(-2.0 * cos(u),      -sin(u), 0.0);
+            return (GLboolean)GL_TRUE;
+        }, 0.0, TWO_PI},
+
+        {"helix", [](GLuint, GLdouble u, DCoordinate3 *d)
+        {
+            d[0] = DCoordinate3( cos(u),  sin(u), 0.2 * u);
+            d[1] = DCoordinate3(-sin(u),  cos(u), 0.2);
+            d[2] = DCoordinate3(-cos(u), -sin(u), 0.0);
+            return (GLboolean)GL_TRUE;
+        }, 0.0, 3.0 * TWO_PI},
+
+        // the inflections of the sine wave lie on the chords of the initial segments
+        {"sine wave", [](GLuint, GLdouble u, DCoordinate3 *d)
+        {
+            d[0] = DCoordinate3(u,  sin(u), 0.0);
+            d[1] = DCoordinate3(1.0, cos(u), 0.0);
+            d[2] = DCoordinate3(0.0, -sin(u), 0.0);
+            return (GLboolean)GL_TRUE;
+        }, 0.0, 2.0 * TWO_PI}
+    };
+
+    const GLdouble tolerance = 1.0e-3;
+
+    AdaptiveCurveSampler sampler(tolerance);
+
+    GLboolean passed = GL_TRUE;
+
+    // the largest distance of the curve from the chords of the image, measured at 64 inner points of each chord
+    for (const Job &job: jobs)
+    {
+        unique_ptr<GenericCurve3> image(sampler.GenerateImage(job.evaluator, 2, 0, job.u_min, job.u_max));
+
+        GLboolean succeeded   = image && image->GetParameters().size() == image->GetPointCount();
+        GLdouble  deviation   = succeeded ? 0.0 : -1.0;
+        GLuint    point_count = image ? image->GetPointCount() : 0;
+
+        for (GLuint k = 0; succeeded && k + 1 < point_count; ++k)
+        {
+            GLdouble a = image->GetParameters()[k], b = image->GetParameters()[k + 1];
+
+            for (GLuint j = 1; j < 64; ++j)
+            {
+                DCoordinate3 d[3];
+                job.evaluator(2, a + (b - a) * j / 64.0, d);
+
+                deviation = max(deviation, DistanceFromSegment(d[0], (*image)(0, k), (*image)(0, k + 1)));
+            }
+        }
+
+        succeeded = succeeded && deviation <= tolerance;
+
+        cout << "adaptive curve sampling (" << job.name << "): " << point_count << " points, chordal deviation "
+             << deviation << (succeeded ? "" : " -- FAILED") << endl;
+
+        passed = passed && succeeded;
+    }
+
+    // a straight segment is not refined, i.e., a single initial segment yields its two end points
+    {
+        AdaptiveCurveSampler::Evaluator line = [](GLuint, GLdouble u, DCoordinate3 *d)
+        {
+            d[0] = DCoordinate3(1.0 + 2.0 * u, -u, 0.5 * u);
+            d[1] = DCoordinate3(2.0, -1.0, 0.5);
+            d[2] = DCoordinate3(0.0, 0.0, 0.0);
+            return (GLboolean)GL_TRUE;
+        };
+
+        AdaptiveCurveSampler single_segment_sampler(tolerance, 1);
+
+        unique_ptr<GenericCurve3> image(single_segment_sampler.GenerateImage(line, 2, 0, 0.0, 10.0));
+
+        GLuint    point_count = image ? image->GetPointCount() : 0;
+        GLboolean succeeded   = point_count == 2;
+
+        cout << "adaptive curve sampling (straight segment): " << point_count << " points"
+             << (succeeded ? "" : " -- FAILED") << endl;
+
+        passed = passed && succeeded;
+    }
+
+    return passed;
+}
+
+GLboolean tests::CheckArcLengthRoundTrip()
+{
+    // a circle of radius r traversed at the varying speed r (1 + e cos u), whose arc length is
+    // s(u) = r (u + e sin u), hence the length of [0, 2 pi] is 2 pi r
+    const GLdouble r = 2.0, e = 0.3;
+
+    ArcLengthTable::Evaluator circle = [=](GLuint, GLdouble u, DCoordinate3 *d)
+    {
+        GLdouble phi = u + e * sin(u), phi_dot = 1.0 + e * cos(u);
+
+        d[0] = DCoordinate3(r * cos(phi), r * sin(phi), 0.0);
+        d[1] = DCoordinate3(-r * sin(phi) * phi_dot, r * cos(phi) * phi_dot, 0.0);
+        return (GLboolean)GL_TRUE;
+    };
+
+    ArcLengthTable table;
+
+    GLboolean succeeded    = table.Build(circle, 0.0, TWO_PI);
+    GLdouble  length       = table.GetLength();
+    GLdouble  length_error = fabs(length - TWO_PI * r);
+
+    // s -> u -> s, both through the table and through the exact arc length of the returned parameter
+    GLdouble round_trip_error = 0.0, exact_error = 0.0, hermite_error = 0.0;
+
+    for (GLuint k = 0; succeeded && k <= 1000; ++k)
+    {
+        GLdouble s = length * k / 1000.0;
+        GLdouble u = table.ParameterAt(s, 2);
+
+        round_trip_error = max(round_trip_error, fabs(table.ArcLengthAt(u) - s));
+        exact_error      = max(exact_error, fabs(r * (u + e * sin(u)) - s));
+
+        // the Hermite interpolant without Newton iterations
+        GLdouble v = table.ParameterAt(s);
+        hermite_error = max(hermite_error, fabs(r * (v + e * sin(v)) - s));
+    }
+
+    succeeded = succeeded && length_error <= 1.0e-12 * length && round_trip_error <= 1.0e-12 * length &&
+                exact_error <= 1.0e-12 * length && hermite_error <= 1.0e-6 * length;
+
+    cout << "arc length table (circle of length " << TWO_PI * r << "): length error " << length_error
+         << ", s -> u -> s error " << round_trip_error << " (exact " << exact_error << ", without Newton iterations "
+         << hermite_error << ")" << (succeeded ? "" : " -- FAILED") << endl;
+
+    return succeeded;
+}
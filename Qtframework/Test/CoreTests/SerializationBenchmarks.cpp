@@ -0,0 +1,98 @@
+#include "CoreTests.h"
+#include "Core/DCoordinates3.h"
+#include "Core/MatrixSerialization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace cagd;
+using namespace std;
+
+// the largest coordinate-wise difference of two equally sized matrices
+static GLdouble Deviation(const Matrix<DCoordinate3>& lhs, const Matrix<DCoordinate3>& rhs)
+{
+    GLdouble deviation = 0.0;
+
+    for (GLuint i = 0; i < lhs.GetRowCount(); ++i)
+        for (GLuint j = 0; j < lhs.GetColumnCount(); ++j)
+            for (GLuint k = 0; k < 3; ++k)
+                deviation = max(deviation, fabs(lhs(i, j)[k] - rhs(i, j)[k]));
+
+    return deviation;
+}
+
+static GLdouble FileSize(const string& file_name)
+{
+    ifstream file(file_name.c_str(), ios_base::in | ios_base::binary | ios_base::ate);
+    return (GLdouble)file.tellg();
+}
+
+GLvoid tests::BenchmarkSerialization()
+{
+    const GLuint row_count = 10;
+    const GLuint column_counts[] = {1000, 10000, 100000};
+
+    const string text_file_name = "CoreTests_serialization.txt", binary_file_name = "CoreTests_serialization.bin";
+
+    printf("Matrix<DCoordinate3> serialization, %u rows, times in ms including the file system\n", row_count);
+    printf("%8s %12s %12s %12s %12s %12s %12s %12s\n", "columns", "text [MB]", "binary [MB]",
+           "text out", "binary out", "text in", "stream in", "mapped in");
+
+    for (GLuint column_count: column_counts)
+    {
+        Matrix<DCoordinate3> matrix(row_count, column_count), text_copy, stream_copy, mapped_copy;
+
+        for (GLuint i = 0; i < row_count; ++i)
+        {
+            for (GLuint j = 0; j < column_count; ++j)
+            {
+                GLdouble u = (GLdouble)j / column_count;
+                matrix(i, j) = DCoordinate3(cos(u + i), sin(3.0 * u) / (i + 1), u * u * i);
+            }
+        }
+
+        GLuint repetition_count = max(1u, 1000000u / (row_count * column_count));
+
+        GLdouble text_save_time = Milliseconds([&]()
+        {
+            ofstream file(text_file_name.c_str(), ios_base::out | ios_base::trunc);
+            file << matrix;
+        }, repetition_count);
+
+        GLdouble binary_save_time = Milliseconds([&]()
+        {
+            SaveBinary(binary_file_name, matrix);
+        }, repetition_count);
+
+        GLdouble text_load_time = Milliseconds([&]()
+        {
+            ifstream file(text_file_name.c_str(), ios_base::in);
+            file >> text_copy;
+        }, repetition_count);
+
+        GLdouble stream_load_time = Milliseconds([&]()
+        {
+            ifstream file(binary_file_name.c_str(), ios_base::in | ios_base::binary);
+            LoadBinary(file, stream_copy);
+        }, repetition_count);
+
+        GLdouble mapped_load_time = Milliseconds([&]()
+        {
+            LoadBinary(binary_file_name, mapped_copy);
+        }, repetition_count);
+
+        printf("%8u %12.2f %12.2f %12.3f %12.3f %12.3f %12.3f %12.3f\n", column_count,
+               FileSize(text_file_name) / 1048576.0, FileSize(binary_file_name) / 1048576.0,
+               text_save_time, binary_save_time, text_load_time, stream_load_time, mapped_load_time);
+
+        // the binary files are bit-exact, while the text files keep the default 6 significant digits
+        printf("%8s deviation of the loaded matrices: text %.2e, stream %.2e, mapped %.2e\n", "",
+               Deviation(matrix, text_copy), Deviation(matrix, stream_copy), Deviation(matrix, mapped_copy));
+    }
+
+    remove(text_file_name.c_str());
+    remove(binary_file_name.c_str());
+}
@@ -0,0 +1,124 @@
+#include "CoreTests.h"
+#include "Core/MatrixSerialization.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace cagd;
+using namespace std;
+
+// the serialized form of a header whose counts are not followed by the described elements
+static string CorruptHeader(const char *magic, GLuint row_count, GLuint column_count)
+{
+    BinaryMatrixHeader header = binary_matrix::MakeHeader<GLdouble>(magic, row_count, column_count);
+
+    return string((const char*)&header, sizeof(BinaryMatrixHeader)) + string(64, '\0');
+}
+
+// loads the given bytes both from a stream and through a memory mapping of a temporary file
+template <class M>
+static GLboolean Load(const string& bytes, M& matrix, GLboolean& mapped_result)
+{
+    const string file_name = "CoreTests_serialization.bin";
+
+    {
+        ofstream file(file_name.c_str(), ios_base::out | ios_base::binary | ios_base::trunc);
+        file.write(bytes.data(), bytes.size());
+    }
+
+    mapped_result = LoadBinary(file_name, matrix);
+    remove(file_name.c_str());
+
+    istringstream stream(bytes, ios_base::in | ios_base::binary);
+
+    return LoadBinary(stream, matrix);
+}
+
+GLboolean tests::CheckCorruptBinaryMatrices()
+{
+    Matrix<GLdouble> original(3, 4);
+    for (GLuint i = 0; i < original.GetRowCount(); ++i)
+        for (GLuint j = 0; j < original.GetColumnCount(); ++j)
+            original(i, j) = i - 0.25 * j;
+
+    ostringstream saved(ios_base::out | ios_base::binary);
+    SaveBinary(saved, original);
+
+    const string valid = saved.str();
+
+    TriangularMatrix<GLdouble> original_triangular(5);
+    for (GLuint i = 0; i < original_triangular.GetRowCount(); ++i)
+        for (GLuint j = 0; j <= i; ++j)
+            original_triangular(i, j) = 0.5 * i + j;
+
+    ostringstream saved_triangular(ios_base::out | ios_base::binary);
+    SaveBinary(saved_triangular, original_triangular);
+
+    const string valid_triangular = saved_triangular.str();
+
+    struct Job
+    {
+        const char *name;
+        string      bytes;
+        GLboolean   triangular, expected;
+    };
+
+    const char *dense = binary_matrix::DENSE_MAGIC, *triangular = binary_matrix::TRIANGULAR_MAGIC;
+    const GLuint large = 1u << 20, huge = ~0u;
+
+    const Job jobs[] =
+    {
+        {"valid dense matrix",                  valid,                                      GL_FALSE, GL_TRUE},
+        {"truncated dense matrix",              valid.substr(0, valid.size() - 1),          GL_FALSE, GL_FALSE},
+        {"dense counts beyond the data",        CorruptHeader(dense, large, large),         GL_FALSE, GL_FALSE},
+        {"dense counts beyond GLuint",          CorruptHeader(dense, huge, huge),           GL_FALSE, GL_FALSE},
+        {"valid triangular matrix",             valid_triangular,                           GL_TRUE,  GL_TRUE},
+        {"triangular counts beyond the data",   CorruptHeader(triangular, large, large),    GL_TRUE,  GL_FALSE},
+        {"triangular counts beyond GLuint",     CorruptHeader(triangular, huge, huge),      GL_TRUE,  GL_FALSE}
+    };
+
+    GLboolean passed = GL_TRUE;
+
+    for (const Job &job: jobs)
+    {
+        GLboolean streamed, mapped, succeeded;
+
+        if (job.triangular)
+        {
+            TriangularMatrix<GLdouble> matrix;
+            streamed = Load(job.bytes, matrix, mapped);
+            succeeded = streamed == job.expected && mapped == job.expected;
+
+            if (job.expected && succeeded)
+                succeeded = matrix.GetRowCount() == original_triangular.GetRowCount() &&
+                            !memcmp(matrix.GetData(), original_triangular.GetData(),
+                                    original_triangular.GetRowCount() * (original_triangular.GetRowCount() + 1) / 2 *
+                                    sizeof(GLdouble));
+        }
+        else
+        {
+            Matrix<GLdouble> matrix;
+            streamed = Load(job.bytes, matrix, mapped);
+            succeeded = streamed == job.expected && mapped == job.expected;
+
+            if (job.expected && succeeded)
+                succeeded = matrix.GetRowCount() == original.GetRowCount() &&
+                            matrix.GetColumnCount() == original.GetColumnCount() &&
+                            !memcmp(matrix.GetData(), original.GetData(),
+                                    original.GetRowCount() * original.GetColumnCount() * sizeof(GLdouble));
+        }
+
+        cout << "binary matrix loading (" << job.name << "): "
+             << (streamed ? "accepted" : "rejected") << " from a stream, "
+             << (mapped ? "accepted" : "rejected") << " from a mapped file"
+             << (succeeded ? "" : " -- FAILED") << endl;
+
+        passed = passed && succeeded;
+    }
+
+    return passed;
+}
@@ -0,0 +1,151 @@
+#include "CoreTests.h"
+#include "Core/SparseSolvers.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace cagd;
+using namespace std;
+
+// the 5-point Laplacian of a side x side grid with Dirichlet boundary, i.e., the matrix of a membrane fairing
+// problem with fixed boundary; it is symmetric positive definite
+static SparseMatrix<GLdouble> GridLaplacian(GLuint side)
+{
+    vector<SparseMatrix<GLdouble>::Triplet> triplets;
+    triplets.reserve(5 * side * side);
+
+    for (GLuint i = 0; i < side; ++i)
+    {
+        for (GLuint j = 0; j < side; ++j)
+        {
+            GLuint v = i * side + j;
+
+            triplets.push_back(SparseMatrix<GLdouble>::Triplet(v, v, 4.0));
+
+            if (i)
+                triplets.push_back(SparseMatrix<GLdouble>::Triplet(v, v - side, -1.0));
+            if (i + 1 < side)
+                triplets.push_back(SparseMatrix<GLdouble>::Triplet(v, v + side, -1.0));
+            if (j)
+                triplets.push_back(SparseMatrix<GLdouble>::Triplet(v, v - 1, -1.0));
+            if (j + 1 < side)
+                triplets.push_back(SparseMatrix<GLdouble>::Triplet(v, v + 1, -1.0));
+        }
+    }
+
+    SparseMatrix<GLdouble> laplacian;
+    laplacian.SetFromTriplets(side * side, side * side, triplets);
+
+    return laplacian;
+}
+
+// largest coordinate-wise relative residual ||b - A * x|| / ||b||
+static GLdouble RelativeResidual(const SparseMatrix<GLdouble>& a, const vector<DCoordinate3>& b,
+                                 const vector<DCoordinate3>& x)
+{
+    vector<DCoordinate3> ax;
+    a.Multiply(x, ax);
+
+    GLdouble residual = 0.0;
+
+    for (GLuint c = 0; c < 3; ++c)
+    {
+        GLdouble rr = 0.0, bb = 0.0;
+
+        for (GLuint i = 0; i < b.size(); ++i)
+        {
+            GLdouble r = b[i][c] - ax[i][c];
+            rr += r * r;
+            bb += b[i][c] * b[i][c];
+        }
+
+        residual = max(residual, sqrt(rr / bb));
+    }
+
+    return residual;
+}
+
+GLvoid tests::BenchmarkSparseSolvers()
+{
+    // 99856, 300304 and 1000000 unknowns
+    const GLuint sides[] = {316, 548, 1000};
+
+    mt19937                             generator(2024);
+    uniform_real_distribution<GLdouble> distribution(-1.0, 1.0);
+
+    printf("5-point grid Laplacians, DCoordinate3 right-hand sides, %u threads, times in ms\n",
+           RealSquareMatrix::GetThreadCount());
+
+    for (GLuint side: sides)
+    {
+        SparseMatrix<GLdouble> a = GridLaplacian(side);
+        GLuint                 n = a.GetRowCount();
+
+        vector<DCoordinate3> b(n), x;
+
+        for (GLuint i = 0; i < n; ++i)
+            b[i] = DCoordinate3(distribution(generator), distribution(generator), distribution(generator));
+
+        printf("%u unknowns, %u non-zero elements\n", n, a.GetNonZeroCount());
+
+        GLdouble multiplication_time = Milliseconds([&]()
+        {
+            a.Multiply(b, x);
+        }, 10);
+
+        printf("    SpMV                          %12.3f\n", multiplication_time);
+
+        const ConjugateGradientSolver::Preconditioner preconditioners[] =
+                {ConjugateGradientSolver::JACOBI_PRECONDITIONER,
+                 ConjugateGradientSolver::INCOMPLETE_CHOLESKY_PRECONDITIONER};
+
+        for (ConjugateGradientSolver::Preconditioner preconditioner: preconditioners)
+        {
+            ConjugateGradientSolver solver;
+            solver.SetTolerance(1.0e-8);
+
+            GLdouble setup_time = Milliseconds([&]()
+            {
+                solver.SetMatrix(a, preconditioner);
+            });
+
+            GLboolean converged = GL_FALSE;
+
+            x.clear();
+
+            GLdouble solution_time = Milliseconds([&]()
+            {
+                converged = solver.Solve(b, x);
+            });
+
+            printf("    PCG %-10s setup %12.3f, solve %12.3f, %5u iterations, residual %.2e%s\n",
+                   preconditioner == ConjugateGradientSolver::JACOBI_PRECONDITIONER ? "Jacobi" : "IC(0)",
+                   setup_time, solution_time, solver.GetIterationCount(), RelativeResidual(a, b, x),
+                   converged ? "" : " (not converged)");
+        }
+
+        SparseCholeskyDecomposition cholesky;
+        GLboolean                   succeeded = GL_TRUE;
+
+        GLdouble analysis_time = Milliseconds([&]()
+        {
+            succeeded = cholesky.Analyze(a);
+        });
+
+        GLdouble factorization_time = Milliseconds([&]()
+        {
+            succeeded = succeeded && cholesky.Factorize(a);
+        });
+
+        GLdouble solution_time = Milliseconds([&]()
+        {
+            succeeded = succeeded && cholesky.Solve(b, x);
+        });
+
+        printf("    Cholesky   analyze %10.3f, factorize %8.3f, solve %8.3f, %9u factor elements, residual %.2e%s\n",
+               analysis_time, factorization_time, solution_time, cholesky.GetFactorNonZeroCount(),
+               RelativeResidual(a, b, x), succeeded ? "" : " (failed)");
+    }
+}
@@ -0,0 +1,220 @@
+#include "CoreTests.h"
+#include "Core/SparseSolvers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace cagd;
+using namespace std;
+
+typedef SparseMatrix<GLdouble>::Triplet Triplet;
+
+// adds the symmetric pair of off-diagonal elements (i, j) and (j, i)
+static GLvoid AddSymmetric(vector<Triplet>& triplets, GLuint i, GLuint j, GLdouble value)
+{
+    triplets.push_back(Triplet(i, j, value));
+    triplets.push_back(Triplet(j, i, value));
+}
+
+// largest absolute value of b - A * x
+static GLdouble Residual(const SparseMatrix<GLdouble>& a, const vector<GLdouble>& b, const vector<GLdouble>& x)
+{
+    vector<GLdouble> ax;
+    a.Multiply(x, ax);
+
+    GLdouble residual = 0.0;
+    for (GLuint i = 0; i < b.size(); ++i)
+        residual = max(residual, fabs(b[i] - ax[i]));
+
+    return residual;
+}
+
+// ||b - A * x||_2 / ||b||_2
+static GLdouble RelativeResidual(const SparseMatrix<GLdouble>& a, const vector<GLdouble>& b, const vector<GLdouble>& x)
+{
+    vector<GLdouble> ax;
+    a.Multiply(x, ax);
+
+    GLdouble rr = 0.0, bb = 0.0;
+    for (GLuint i = 0; i < b.size(); ++i)
+    {
+        rr += (b[i] - ax[i]) * (b[i] - ax[i]);
+        bb += b[i] * b[i];
+    }
+
+    return sqrt(rr / bb);
+}
+
+// the 5-point Laplacian of a side x side grid with Dirichlet boundary
+static SparseMatrix<GLdouble> GridLaplacian(GLuint side)
+{
+    vector<Triplet> triplets;
+
+    for (GLuint i = 0; i < side; ++i)
+    {
+        for (GLuint j = 0; j < side; ++j)
+        {
+            GLuint v = i * side + j;
+
+            triplets.push_back(Triplet(v, v, 4.0));
+
+            if (i)
+                AddSymmetric(triplets, v, v - side, -1.0);
+            if (j)
+                AddSymmetric(triplets, v, v - 1, -1.0);
+        }
+    }
+
+    SparseMatrix<GLdouble> laplacian;
+    laplacian.SetFromTriplets(side * side, side * side, triplets);
+
+    return laplacian;
+}
+
+// factorizes and solves A * x = (1, ..., 1), returns the residual or -1 on failure
+static GLdouble FactorizeAndSolve(SparseCholeskyDecomposition& cholesky, const SparseMatrix<GLdouble>& a)
+{
+    vector<GLdouble> b(a.GetRowCount(), 1.0), x;
+
+    if (!cholesky.Factorize(a) || !cholesky.Solve(b, x))
+        return -1.0;
+
+    return Residual(a, b, x);
+}
+
+GLboolean tests::CheckSparseCholeskyStructure()
+{
+    GLboolean passed = GL_TRUE;
+
+    // a matrix of 200000 connected components (single nodes and pairs), the nested dissection ordering has to
+    // handle them without recursing once per component
+    {
+        const GLuint size = 300000;
+
+        vector<Triplet> triplets;
+        for (GLuint i = 0; i < size; ++i)
+            triplets.push_back(Triplet(i, i, 2.0 + i % 3));
+        for (GLuint i = 0; i + 1 < size; i += 3)
+            AddSymmetric(triplets, i, i + 1, -0.5);
+
+        SparseMatrix<GLdouble> a;
+        a.SetFromTriplets(size, size, triplets);
+
+        SparseCholeskyDecomposition cholesky;
+        GLdouble residual = cholesky.Analyze(a) ? FactorizeAndSolve(cholesky, a) : -1.0;
+
+        GLboolean succeeded = (residual >= 0.0 && residual <= 1.0e-12);
+
+        cout << "sparse Cholesky (200000 components): residual " << residual
+             << (succeeded ? "" : " -- FAILED") << endl;
+
+        passed = passed && succeeded;
+    }
+
+    // matrices of the same size, but of other sparsity patterns, are analyzed again by Factorize
+    {
+        const GLuint size = 100;
+
+        vector<Triplet> tridiagonal, banded, diagonal;
+        for (GLuint i = 0; i < size; ++i)
+        {
+            tridiagonal.push_back(Triplet(i, i, 4.0));
+            banded.push_back(Triplet(i, i, 4.0));
+            diagonal.push_back(Triplet(i, i, 3.0));
+
+            if (i)
+                AddSymmetric(tridiagonal, i, i - 1, -1.0);
+            if (i >= 10)
+                AddSymmetric(banded, i, i - 10, -1.0);
+        }
+
+        SparseMatrix<GLdouble> matrices[3];
+        matrices[0].SetFromTriplets(size, size, tridiagonal);
+        matrices[1].SetFromTriplets(size, size, banded);    // same number of elements, other positions
+        matrices[2].SetFromTriplets(size, size, diagonal);  // fewer elements
+
+        const char *names[] = {"analyzed pattern", "same element count", "fewer elements"};
+
+        SparseCholeskyDecomposition cholesky;
+        cholesky.Analyze(matrices[0], SparseCholeskyDecomposition::NATURAL_ORDERING);
+
+        for (GLuint m = 0; m < 3; ++m)
+        {
+            GLdouble  residual  = FactorizeAndSolve(cholesky, matrices[m]);
+            GLboolean succeeded = (residual >= 0.0 && residual <= 1.0e-12);
+
+            cout << "sparse Cholesky refactorization (" << names[m] << "): residual " << residual
+                 << (succeeded ? "" : " -- FAILED") << endl;
+
+            passed = passed && succeeded;
+        }
+    }
+
+    return passed;
+}
+
+GLboolean tests::CheckSparseSolvers()
+{
+    const GLuint   side      = 100;
+    const GLdouble tolerance = 1.0e-8;
+
+    SparseMatrix<GLdouble> a = GridLaplacian(side);
+    GLuint                 n = a.GetRowCount();
+
+    vector<GLdouble> b(n);
+    for (GLuint i = 0; i < n; ++i)
+        b[i] = sin(0.1 * i) + cos(0.37 * (i / side));
+
+    GLboolean passed = GL_TRUE;
+
+    // both preconditioners reach the requested relative residual, IC(0) in fewer iterations than Jacobi
+    const ConjugateGradientSolver::Preconditioner preconditioners[] =
+            {ConjugateGradientSolver::JACOBI_PRECONDITIONER,
+             ConjugateGradientSolver::INCOMPLETE_CHOLESKY_PRECONDITIONER};
+
+    GLuint iteration_counts[2] = {0, 0};
+
+    for (GLuint p = 0; p < 2; ++p)
+    {
+        ConjugateGradientSolver solver;
+        solver.SetTolerance(tolerance);
+
+        vector<GLdouble> x;
+
+        GLboolean succeeded = solver.SetMatrix(a, preconditioners[p]) && solver.Solve(b, x);
+        GLdouble  residual  = succeeded ? RelativeResidual(a, b, x) : -1.0;
+
+        iteration_counts[p] = solver.GetIterationCount();
+
+        // the solver monitors the recursively updated residual, which may drift slightly from the true one
+        succeeded = succeeded && residual >= 0.0 && residual <= 10.0 * tolerance;
+
+        if (p == 1)
+            succeeded = succeeded && iteration_counts[1] < iteration_counts[0];
+
+        cout << "PCG " << (p ? "IC(0)" : "Jacobi") << " (" << n << " unknowns): " << iteration_counts[p]
+             << " iterations, relative residual " << residual << (succeeded ? "" : " -- FAILED") << endl;
+
+        passed = passed && succeeded;
+    }
+
+    // the direct solver is exact up to rounding errors
+    {
+        SparseCholeskyDecomposition cholesky;
+        vector<GLdouble>            x;
+
+        GLboolean succeeded = cholesky.Analyze(a) && cholesky.Factorize(a) && cholesky.Solve(b, x);
+        GLdouble  residual  = succeeded ? RelativeResidual(a, b, x) : -1.0;
+
+        succeeded = succeeded && residual >= 0.0 && residual <= 1.0e-13;
+
+        cout << "sparse Cholesky (" << n << " unknowns): relative residual " << residual
+             << (succeeded ? "" : " -- FAILED") << endl;
+
+        passed = passed && succeeded;
+    }
+
+    return passed;
+}
@@ -0,0 +1,262 @@
+#include "CoreTests.h"
+#include "Core/GenericCurves3.h"
+#include "Core/RealSquareMatrices.h"
+
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace cagd;
+using namespace std;
+
+// the former row-by-row storage of Matrix<T>
+template <typename T>
+using RowByRowMatrix = vector<vector<T>>;
+
+// the LU decomposition with implicit scaling and partial pivoting, as it was implemented on the row-by-row storage
+static GLboolean RowByRowLUDecomposition(RowByRowMatrix<GLdouble>& a, vector<GLuint>& row_permutation)
+{
+    const GLdouble tiny = numeric_limits<GLdouble>::min();
+
+    GLuint size = (GLuint)a.size();
+    vector<GLdouble> implicit_scaling_of_each_row(size);
+
+    row_permutation.resize(size);
+
+    for (GLuint i = 0; i < size; ++i)
+    {
+        GLdouble big = 0.0;
+        for (GLuint j = 0; j < size; ++j)
+            big = max(big, fabs(a[i][j]));
+
+        if (big == 0.0)
+            return GL_FALSE;
+
+        implicit_scaling_of_each_row[i] = 1.0 / big;
+    }
+
+    for (GLuint k = 0; k < size; ++k)
+    {
+        GLuint   imax = k;
+        GLdouble big = 0.0;
+        for (GLuint i = k; i < size; ++i)
+        {
+            GLdouble temp = implicit_scaling_of_each_row[i] * fabs(a[i][k]);
+            if (temp > big)
+            {
+                big = temp;
+                imax = i;
+            }
+        }
+
+        if (k != imax)
+        {
+            for (GLuint j = 0; j < size; ++j)
+                swap(a[imax][j], a[k][j]);
+
+            implicit_scaling_of_each_row[imax] = implicit_scaling_of_each_row[k];
+        }
+
+        row_permutation[k] = imax;
+        if (a[k][k] == 0.0)
+            a[k][k] = tiny;
+
+        for (GLuint i = k + 1; i < size; ++i)
+        {
+            GLdouble temp = a[i][k] /= a[k][k];
+
+            for (GLuint j = k + 1; j < size; ++j)
+                a[i][j] -= temp * a[k][j];
+        }
+    }
+
+    return GL_TRUE;
+}
+
+// the filling of the vertex buffer objects of a curve image, as it was implemented on the row-by-row storage; like
+// GenericCurve3::UpdateVertexBufferObjects, it recreates the buffer objects vbo[0],...,vbo[derivative.size() - 1]
+static GLboolean RowByRowVertexBufferFill(const RowByRowMatrix<DCoordinate3>& derivative, GLdouble scale,
+                                          GLuint *vbo, GLenum usage_flag)
+{
+    glDeleteBuffers((GLsizei)derivative.size(), vbo);
+    glGenBuffers((GLsizei)derivative.size(), vbo);
+
+    GLuint curve_point_count     = (GLuint)derivative[0].size();
+    GLuint curve_point_byte_size = 3 * curve_point_count * sizeof(GLfloat);
+
+    for (GLuint d = 0; d < derivative.size(); ++d)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, vbo[d]);
+        glBufferData(GL_ARRAY_BUFFER, (d ? 2 : 1) * curve_point_byte_size, 0, usage_flag);
+
+        GLfloat *coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+
+        if (!coordinate)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            return GL_FALSE;
+        }
+
+        for (GLuint i = 0; i < curve_point_count; ++i)
+        {
+            if (!d)
+            {
+                for (GLuint j = 0; j < 3; ++j)
+                    *coordinate++ = (GLfloat)derivative[0][i][j];
+            }
+            else
+            {
+                DCoordinate3 sum = derivative[0][i];
+                sum += scale * derivative[d][i];
+
+                for (GLuint j = 0; j < 3; ++j)
+                {
+                    *coordinate = (GLfloat)derivative[0][i][j];
+                    *(coordinate + 3) = (GLfloat)sum[j];
+                    ++coordinate;
+                }
+
+                coordinate += 3;
+            }
+        }
+
+        if (!glUnmapBuffer(GL_ARRAY_BUFFER))
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            return GL_FALSE;
+        }
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return GL_TRUE;
+}
+
+GLvoid tests::BenchmarkLUDecomposition()
+{
+    const GLuint sizes[] = {100, 200, 400, 800, 1600};
+
+    mt19937                             generator(2024);
+    uniform_real_distribution<GLdouble> distribution(-1.0, 1.0);
+
+    // the layouts are compared on a single thread
+    GLuint initial_thread_count = RealSquareMatrix::GetThreadCount();
+    RealSquareMatrix::SetThreadCount(1);
+
+    printf("LU decomposition, 1 thread\n");
+    printf("%8s %18s %18s %10s %18s\n", "size", "row-by-row [ms]", "contiguous [ms]", "speedup", "factor deviation");
+
+    for (GLuint size: sizes)
+    {
+        RealSquareMatrix         a(size);
+        RowByRowMatrix<GLdouble> b(size, vector<GLdouble>(size));
+
+        for (GLuint i = 0; i < size; ++i)
+            for (GLuint j = 0; j < size; ++j)
+                a(i, j) = b[i][j] = distribution(generator) + (i == j ? 4.0 : 0.0);
+
+        GLuint repetition_count = max(1u, 400000000u / (size * size * size));
+
+        GLdouble row_by_row_time = Milliseconds([&]()
+        {
+            RowByRowMatrix<GLdouble> c = b;
+            vector<GLuint>           row_permutation;
+            RowByRowLUDecomposition(c, row_permutation);
+        }, repetition_count);
+
+        GLdouble contiguous_time = Milliseconds([&]()
+        {
+            RealSquareMatrix c = a;
+            c.PerformLUDecomposition();
+        }, repetition_count);
+
+        // the factors of both implementations have to coincide up to rounding errors
+        vector<GLuint> row_permutation;
+        RowByRowLUDecomposition(b, row_permutation);
+        a.PerformLUDecomposition();
+
+        GLdouble deviation = 0.0;
+        for (GLuint i = 0; i < size; ++i)
+            for (GLuint j = 0; j < size; ++j)
+                deviation = max(deviation, fabs(a(i, j) - b[i][j]));
+
+        printf("%8u %18.3f %18.3f %10.2f %18.2e\n",
+               size, row_by_row_time, contiguous_time, row_by_row_time / contiguous_time, deviation);
+    }
+
+    RealSquareMatrix::SetThreadCount(initial_thread_count);
+}
+
+GLvoid tests::BenchmarkVertexBufferFill()
+{
+    QOffscreenSurface surface;
+    surface.create();
+
+    QOpenGLContext context;
+
+    if (!context.create() || !context.makeCurrent(&surface))
+    {
+        printf("vertex buffer fill: skipped, no OpenGL context is available\n");
+        return;
+    }
+
+    glewExperimental = GL_TRUE;
+
+    if (glewInit() != GLEW_OK)
+    {
+        printf("vertex buffer fill: skipped, GLEW cannot be initialized\n");
+        return;
+    }
+
+    const GLuint   point_counts[] = {1000, 10000, 100000, 1000000};
+    const GLuint   max_order_of_derivatives = 2;
+    const GLdouble scale = 0.3;
+
+    printf("GenericCurve3 vertex buffer fill, derivatives up to order %u\n", max_order_of_derivatives);
+    printf("%8s %18s %18s %10s\n", "points", "row-by-row [ms]", "contiguous [ms]", "speedup");
+
+    for (GLuint point_count: point_counts)
+    {
+        GenericCurve3                curve(max_order_of_derivatives, point_count, GL_DYNAMIC_DRAW);
+        RowByRowMatrix<DCoordinate3> derivative(max_order_of_derivatives + 1, vector<DCoordinate3>(point_count));
+
+        for (GLuint order = 0; order <= max_order_of_derivatives; ++order)
+        {
+            for (GLuint i = 0; i < point_count; ++i)
+            {
+                GLdouble u = (GLdouble)i / point_count;
+                curve(order, i) = derivative[order][i] = DCoordinate3(cos(u + order), sin(2.0 * u), u * order);
+            }
+        }
+
+        GLuint vbo[max_order_of_derivatives + 1] = {0};
+
+        GLuint repetition_count = max(1u, 20000000u / point_count);
+
+        GLdouble row_by_row_time = Milliseconds([&]()
+        {
+            RowByRowVertexBufferFill(derivative, scale, vbo, GL_DYNAMIC_DRAW);
+            glFinish();
+        }, repetition_count);
+
+        GLdouble contiguous_time = Milliseconds([&]()
+        {
+            curve.UpdateVertexBufferObjects(scale, GL_DYNAMIC_DRAW);
+            glFinish();
+        }, repetition_count);
+
+        glDeleteBuffers(max_order_of_derivatives + 1, vbo);
+        curve.DeleteVertexBufferObjects();
+
+        printf("%8u %18.3f %18.3f %10.2f\n",
+               point_count, row_by_row_time, contiguous_time, row_by_row_time / contiguous_time);
+    }
+
+    context.doneCurrent();
+}
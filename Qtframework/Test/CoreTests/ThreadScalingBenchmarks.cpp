@@ -0,0 +1,100 @@
+#include "CoreTests.h"
+#include "Core/Constants.h"
+#include "Core/RealSquareMatrices.h"
+#include "Cyclic/CyclicCurves3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+using namespace cagd;
+using namespace std;
+
+GLvoid tests::BenchmarkThreadScaling()
+{
+    // the blending functions c_n (1 + cos(u - i lambda_n))^n of larger orders overflow in double precision
+    const GLuint orders[]        = {128, 256, 512};
+    const GLuint thread_counts[] = {1, 2, 4, 8};
+
+    // the data points of this many curves are interpolated at once
+    const GLuint curve_count = 64;
+
+    GLuint initial_thread_count = RealSquareMatrix::GetThreadCount();
+
+    printf("CyclicCurve3 collocation systems, %u curves interpolated at once, times in ms\n", curve_count);
+    printf("%8s %8s %12s %10s %12s %10s\n", "size", "threads", "LU", "speedup", "solve", "speedup");
+
+    for (GLuint n: orders)
+    {
+        GLuint   size = 2 * n + 1;
+        GLdouble lambda_n = TWO_PI / size;
+
+        CyclicCurve3 curve(n);
+
+        // the knots are perturbed, since the collocation matrix of uniform knots is circulant and
+        // CyclicCurve3 solves such systems by discrete Fourier transforms instead of LU decompositions;
+        // subnormal blending function values are flushed to zero, otherwise the timings would mostly
+        // measure subnormal arithmetic
+        RealSquareMatrix    collocation_matrix(size);
+        RowMatrix<GLdouble> values;
+
+        for (GLuint r = 0; r < size; ++r)
+        {
+            curve.BlendingFunctionValues(r * lambda_n + 0.25 * lambda_n * sin((GLdouble)r), values);
+
+            for (GLuint i = 0; i < size; ++i)
+                if (fabs(values[i]) < numeric_limits<GLdouble>::min())
+                    values[i] = 0.0;
+
+            collocation_matrix.SetRow(r, values);
+        }
+
+        Matrix<DCoordinate3> data_points(size, curve_count);
+
+        for (GLuint r = 0; r < size; ++r)
+        {
+            for (GLuint k = 0; k < curve_count; ++k)
+            {
+                GLdouble u = r * lambda_n;
+                data_points(r, k) = DCoordinate3(cos(u) * (k + 1), sin(u) * (k + 1), sin(k * u));
+            }
+        }
+
+        GLuint repetition_count = max(1u, 200000000u / (size * size * size));
+
+        GLdouble serial_lu_time = 0.0, serial_solve_time = 0.0;
+
+        for (GLuint thread_count: thread_counts)
+        {
+            RealSquareMatrix::SetThreadCount(thread_count);
+
+            GLdouble lu_time = Milliseconds([&]()
+            {
+                RealSquareMatrix lu = collocation_matrix;
+                lu.PerformLUDecomposition();
+            }, repetition_count);
+
+            RealSquareMatrix lu = collocation_matrix;
+            lu.PerformLUDecomposition();
+
+            Matrix<DCoordinate3> control_points;
+
+            GLdouble solve_time = Milliseconds([&]()
+            {
+                lu.SolveLinearSystem(data_points, control_points);
+            }, repetition_count);
+
+            if (thread_count == 1)
+            {
+                serial_lu_time    = lu_time;
+                serial_solve_time = solve_time;
+            }
+
+            printf("%8u %8u %12.3f %10.2f %12.3f %10.2f\n", size, thread_count,
+                   lu_time, serial_lu_time / lu_time, solve_time, serial_solve_time / solve_time);
+        }
+    }
+
+    RealSquareMatrix::SetThreadCount(initial_thread_count);
+}
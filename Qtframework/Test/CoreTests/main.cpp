@@ -0,0 +1,91 @@
+#include "CoreTests.h"
+#include <QGuiApplication>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+using namespace cagd;
+
+// without arguments every check is run and the exit code is the number of failed checks, otherwise the benchmarks
+// named by the arguments are run, e.g., CoreTests lu vbo
+int main(int argc, char **argv)
+{
+    if (argc <= 1)
+    {
+        typedef GLboolean (*Check)();
+
+        const Check checks[] =
+        {
+            tests::CheckTessellationAllocations,
+            tests::CheckParallelCurveImages,
+            tests::CheckCorruptBinaryMatrices,
+            tests::CheckSparseCholeskyStructure,
+            tests::CheckCyclicInterpolation,
+            tests::CheckMixedPrecisionRefinement,
+            tests::CheckFactorizationCache,
+            tests::CheckFixedSizeLUDecompositions,
+            tests::CheckBatched4x4Solver,
+            tests::CheckBlockedLeastSquares,
+            tests::CheckSparseSolvers,
+            tests::CheckHyperbolicInterpolatingChain,
+            tests::CheckAdaptiveCurveSampling,
+            tests::CheckArcLengthRoundTrip
+        };
+
+        int failure_count = 0;
+
+        for (Check check: checks)
+            if (!check())
+                ++failure_count;
+
+        cout << (failure_count ? "FAILED" : "PASSED") << endl;
+
+        return failure_count;
+    }
+
+    // the offscreen OpenGL contexts of the benchmarks need an application object
+    QGuiApplication application(argc, argv);
+
+    struct Benchmark
+    {
+        const char *name;
+        GLvoid    (*run)();
+    };
+
+    const Benchmark benchmarks[] =
+    {
+        {"lu",              tests::BenchmarkLUDecomposition},
+        {"vbo",             tests::BenchmarkVertexBufferFill},
+        {"serialization",   tests::BenchmarkSerialization},
+        {"threads",         tests::BenchmarkThreadScaling},
+        {"sparse",          tests::BenchmarkSparseSolvers}
+    };
+
+    int unknown_count = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        GLboolean found = GL_FALSE;
+
+        for (const Benchmark &benchmark: benchmarks)
+        {
+            if (!strcmp(argv[i], benchmark.name))
+            {
+                benchmark.run();
+                found = GL_TRUE;
+            }
+        }
+
+        if (!found)
+        {
+            cerr << "unknown benchmark: " << argv[i] << ", the available ones are:";
+            for (const Benchmark &benchmark: benchmarks)
+                cerr << " " << benchmark.name;
+            cerr << endl;
+
+            ++unknown_count;
+        }
+    }
+
+    return unknown_count;
+}